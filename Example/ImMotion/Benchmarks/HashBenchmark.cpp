@@ -0,0 +1,98 @@
+// Compares Dear ImGui's ImHashData()/ImHashStr() with the IMEXT_ENABLE_FAST_HASH path of the extensions.
+// The extensions are built in this translation unit so the benchmark reaches their internal hash functions.
+// Usage: HashBenchmark [iterations]. Inputs are fixed, results are checked to be identical before timing.
+#define IMEXT_ENABLE_FAST_HASH
+#include "imgui_extentions.cpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static volatile ImU32 GSink;
+
+// Same dispatch as HashStr(), without the "###" scan
+static bool HasCrc32Hw()
+{
+#if defined(IMEXT_CRC32_HW) && defined(IMEXT_CRC32_HW_RUNTIME_CHECK)
+	return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#elif defined(IMEXT_CRC32_HW)
+	return true;
+#else
+	return false;
+#endif
+}
+
+static ImU32 FastHashData(const void* data, size_t data_size, ImU32 seed)
+{
+#ifdef IMEXT_CRC32_HW
+	static const bool has_crc32 = HasCrc32Hw();
+	if (has_crc32)
+		return ~Crc32UpdateHw(~seed, (const unsigned char*)data, data_size);
+#endif
+	return ~Crc32Update(~seed, (const unsigned char*)data, data_size);
+}
+
+template<typename FUNC>
+static double MeasureNs(int iterations, FUNC func)
+{
+	double best = 0.0;
+	for (int rep = 0; rep < 5; rep++)
+	{
+		ImU32 acc = 0;
+		const auto t0 = std::chrono::steady_clock::now();
+		for (int n = 0; n < iterations; n++)
+			acc += func(n);
+		const auto t1 = std::chrono::steady_clock::now();
+		GSink = acc;
+		const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+		if (rep == 0 || ns < best)
+			best = ns;
+	}
+	return best;
+}
+
+int main(int argc, char** argv)
+{
+	const int iterations = (argc > 1) ? atoi(argv[1]) : 2000000;
+	if (iterations <= 0)
+		return 1;
+	printf("Fast path: %s\n", HasCrc32Hw() ? "ARMv8 CRC32 instructions" : "slicing-by-8 tables");
+	printf("%-16s %11s %11s\n", "", "ImHash", "fast");
+
+	// Widget labels, as hashed by window->GetID()
+	static const char* labels[] = { "Play", "Loop", "Radio 1", "Toggle switch", "Checkbox##option_12", "Combo###combo_id", "Progress button with a long label", "Render cache statistics##panel" };
+	const int labels_mask = IM_ARRAYSIZE(labels) - 1;
+	IM_STATIC_ASSERT((IM_ARRAYSIZE(labels) & (IM_ARRAYSIZE(labels) - 1)) == 0);
+	for (int n = 0; n < IM_ARRAYSIZE(labels); n++)
+		if (HashStr(labels[n], 0, 0x1234u) != ImHashStr(labels[n], 0, 0x1234u))
+		{
+			printf("Mismatch on \"%s\"\n", labels[n]);
+			return 1;
+		}
+	const double str_base = MeasureNs(iterations, [&](int n) { return ImHashStr(labels[n & labels_mask], 0, (ImU32)n); });
+	const double str_fast = MeasureNs(iterations, [&](int n) { return HashStr(labels[n & labels_mask], 0, (ImU32)n); });
+	printf("%-16s %8.1f ns %8.1f ns  x%.2f\n", "labels", str_base, str_fast, str_base / str_fast);
+
+	// Raw data of growing sizes
+	static unsigned char data[4096];
+	ImU32 lcg = 1;
+	for (int n = 0; n < IM_ARRAYSIZE(data); n++)
+		data[n] = (unsigned char)((lcg = lcg * 1664525u + 1013904223u) >> 24);
+	static const int sizes[] = { 8, 32, 128, 1024, 4096 };
+	for (int s = 0; s < IM_ARRAYSIZE(sizes); s++)
+	{
+		const size_t size = (size_t)sizes[s];
+		if (FastHashData(data, size, 0x1234u) != ImHashData(data, size, 0x1234u))
+		{
+			printf("Mismatch on %d bytes\n", sizes[s]);
+			return 1;
+		}
+		const int size_iterations = ImMax(iterations / (sizes[s] / 8), 1);
+		const double data_base = MeasureNs(size_iterations, [&](int n) { return ImHashData(data, size, (ImU32)n); });
+		const double data_fast = MeasureNs(size_iterations, [&](int n) { return FastHashData(data, size, (ImU32)n); });
+		char name[32];
+		snprintf(name, sizeof(name), "%d bytes", sizes[s]);
+		printf("%-16s %8.1f ns %8.1f ns  x%.2f\n", name, data_base, data_fast, data_base / data_fast);
+	}
+	return 0;
+}
@@ -0,0 +1,363 @@
+// Headless tests of the ImGui extensions, run after each build of the Tests project. Exit code 1 on failure.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "imgui_extentions.h"
+
+#define TEST_CHECK(_EXPR)   do { if (!(_EXPR)) { printf("%s(%d): check failed: %s\n", __FILE__, __LINE__, #_EXPR); return false; } } while (0)
+
+//-----------------------------------------------------------------------------
+// Headless context
+//-----------------------------------------------------------------------------
+
+static ImGuiContext* CreateTestContext()
+{
+	ImGuiContext* ctx = ImGui::CreateContext();
+	ImGui::SetCurrentContext(ctx);
+	ImGuiIO& io = ImGui::GetIO();
+	io.IniFilename = NULL;
+	io.LogFilename = NULL;
+	io.DisplaySize = ImVec2(1280, 800);
+	io.DeltaTime = 1.0f / 60.0f;
+	unsigned char* pixels;
+	int width, height;
+	io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+	return ctx;
+}
+
+static const char* GetTempFilename(const char* name)
+{
+	static char filename[512];
+	const char* dir = getenv("TEMP");
+	if (dir == NULL)
+		dir = getenv("TMPDIR");
+	snprintf(filename, sizeof(filename), "%s/%s", dir ? dir : "/tmp", name);
+	return filename;
+}
+
+//-----------------------------------------------------------------------------
+// Allocations
+//-----------------------------------------------------------------------------
+
+// Scripted input: every segment of frames moves the mouse to one widget and clicks it, or drags it for sliders.
+// The script repeats, so after the warmup every path has already run and grown its buffers once.
+enum AllocTarget
+{
+	AllocTarget_Button,
+	AllocTarget_ProgressButton,
+	AllocTarget_Toggle,
+	AllocTarget_ProgressToggle,
+	AllocTarget_Switch,
+	AllocTarget_Checkbox,
+	AllocTarget_Radio,
+	AllocTarget_Combo,
+	AllocTarget_ComboItem,
+	AllocTarget_Task,
+	AllocTarget_SliderFloat,
+	AllocTarget_SliderInt,
+	AllocTarget_Drag,
+	AllocTarget_Plot,
+	AllocTarget_Header,
+	AllocTarget_Tree,
+	AllocTarget_LogView,
+	AllocTarget_Editor,
+	AllocTarget_COUNT
+};
+
+#define ALLOC_SEGMENT_FRAMES    24
+
+struct AllocScenario
+{
+	ImRect Targets[AllocTarget_COUNT];
+	bool Toggles[6];
+	float Progress[2];
+	int Radio;
+	const char* ComboValue;
+	float SliderValue;
+	int SliderIntValue;
+	float DragValue;
+	std::atomic<float> Fraction;
+	ImExtSparklineBuffer Sparkline;
+	ImExtPlotSeries Plot;
+	ImExtLogFile Log;
+	ImExtTextBuffer Editor;
+
+	AllocScenario() : Fraction(0.0f), Sparkline(1024)
+	{
+		memset(Toggles, 0, sizeof(Toggles));
+		Progress[0] = Progress[1] = 0.0f;
+		Radio = 0;
+		ComboValue = "Alpha";
+		SliderValue = 0.5f;
+		SliderIntValue = 5;
+		DragValue = 0.0f;
+	}
+};
+
+static void AllocTaskFunc(ImExtTaskContext* task)
+{
+	for (int n = 1; n <= 4 && !task->CancelRequested.load(); n++)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		task->Progress.store(n / 4.0f);
+	}
+}
+
+static void AllocFrame(AllocScenario& s, int frame, bool type_in_editor)
+{
+	ImGuiIO& io = ImGui::GetIO();
+	const int segment = frame / ALLOC_SEGMENT_FRAMES;
+	const int t = frame % ALLOC_SEGMENT_FRAMES;
+	const ImRect& target = s.Targets[segment % AllocTarget_COUNT];
+	ImVec2 mouse_pos = target.GetCenter();
+	if (segment % AllocTarget_COUNT == AllocTarget_SliderFloat || segment % AllocTarget_COUNT == AllocTarget_SliderInt || segment % AllocTarget_COUNT == AllocTarget_Drag)
+		mouse_pos.x = target.Min.x + target.GetWidth() * ((t < 12) ? t / 12.0f : (segment & 1) ? 0.9f : 0.1f); // Flicked on some segments
+	io.AddMousePosEvent(mouse_pos.x, mouse_pos.y);
+	io.AddMouseButtonEvent(0, t >= 2 && t < 10);
+	if (segment % AllocTarget_COUNT == AllocTarget_LogView || segment % AllocTarget_COUNT == AllocTarget_Plot)
+		io.AddMouseWheelEvent(0.0f, (t < 12) ? -1.0f : 1.0f);
+	if (segment % AllocTarget_COUNT == AllocTarget_Editor && t >= 12)
+	{
+		if (type_in_editor && t < 16)
+			io.AddInputCharacter('a' + (frame % 26));
+		const ImGuiKey key = (t & 1) ? ImGuiKey_LeftArrow : (t & 2) ? ImGuiKey_DownArrow : ImGuiKey_UpArrow;
+		io.AddKeyEvent(ImGuiKey_ModShift, t >= 20);
+		io.AddKeyEvent(key, true);
+		io.AddKeyEvent(key, false);
+	}
+	io.DeltaTime = 1.0f / 60.0f;
+
+	s.Sparkline.Push(sinf(frame * 0.1f));
+	s.Plot.Append(cosf(frame * 0.01f));
+	s.Fraction.store((frame % 120) / 120.0f);
+
+	ImGui::NewFrame();
+	ImGui::SetNextWindowPos(ImVec2(0, 0));
+	ImGui::SetNextWindowSize(io.DisplaySize);
+	ImGui::Begin("Allocations", NULL, ImGuiWindowFlags_NoDecoration);
+	const ImVec2 size(160, 24);
+
+	ImGui::BeginGroup();
+	ImExt::PushGroupAlpha(0.5f + 0.5f * sinf(frame * 0.05f));
+	ImExt::PushTransform(ImGui::GetCursorScreenPos(), ImVec2(1.0f + 0.1f * sinf(frame * 0.05f), 1.0f));
+	ImExt::Button("Button", size); s.Targets[AllocTarget_Button] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	ImExt::PopTransform();
+	ImExt::PopGroupAlpha();
+	ImExt::ProgressButton("Progress", &s.Toggles[0], &s.Progress[0], size); s.Targets[AllocTarget_ProgressButton] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	ImExt::ToggleButton(IMEXT_LABEL("Toggle"), &s.Toggles[1], size); s.Targets[AllocTarget_Toggle] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	ImExt::ProgressToggleButton("Progress toggle", &s.Toggles[2], &s.Progress[1], size); s.Targets[AllocTarget_ProgressToggle] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	ImExt::ToggleSwitch("Switch", &s.Toggles[3]); s.Targets[AllocTarget_Switch] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	ImExt::Checkbox("Checkbox", &s.Toggles[4]); s.Targets[AllocTarget_Checkbox] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	ImExt::RadioButton("First", &s.Radio, 0);
+	ImExt::RadioButton("Second", &s.Radio, 1); s.Targets[AllocTarget_Radio] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	if (ImExt::BeginCombo("##Combo", s.ComboValue, size))
+	{
+		if (ImGui::Selectable("Alpha"))
+			s.ComboValue = "Alpha";
+		if (ImGui::Selectable("Beta"))
+			s.ComboValue = "Beta";
+		s.Targets[AllocTarget_ComboItem] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+		ImGui::EndCombo();
+	}
+	s.Targets[AllocTarget_Combo] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	ImExt::TaskButton("Task", AllocTaskFunc, NULL, size); s.Targets[AllocTarget_Task] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	ImExt::ProgressBar("##Fraction", (frame % 200) / 200.0f, size);
+	ImExt::ProgressBar("##Atomic", s.Fraction, size);
+	ImExt::Spinner("##Arc", ImExtSpinnerType_Arc);
+	ImGui::SameLine();
+	ImExt::Spinner("##Dots", ImExtSpinnerType_Dots);
+	ImGui::SameLine();
+	ImExt::Spinner("##Bar", ImExtSpinnerType_Bar);
+	ImGui::EndGroup();
+
+	ImGui::SameLine();
+	ImGui::BeginGroup();
+	ImGui::PushItemWidth(240);
+	ImExt::SliderFloat("Float", &s.SliderValue, 0.0f, 1.0f, "%.2f"); s.Targets[AllocTarget_SliderFloat] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	ImExt::SliderInt("Int", &s.SliderIntValue, 0, 100, "%d steps"); s.Targets[AllocTarget_SliderInt] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	ImExt::DragFloat("Drag", &s.DragValue, 0.01f, 0.0f, 0.0f, "%.3f"); s.Targets[AllocTarget_Drag] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	ImGui::PopItemWidth();
+	ImExt::AnimatedNumber("##Fixed", 1000.0 * sin(frame * 0.02), "%.2f");
+	ImExt::AnimatedNumber("##Integer", (double)(frame / 30), "%d items");
+	ImExt::AnimatedNumber("##Scientific", 1e6 * (1.0 + (frame / 45)), "%e");
+	ImExt::Sparkline("##Sparkline", s.Sparkline, ImVec2(240, 40));
+	ImExt::Plot("##Plot", s.Plot, ImVec2(240, 80)); s.Targets[AllocTarget_Plot] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	const bool header_open = ImExt::CollapsingHeader("Header");
+	s.Targets[AllocTarget_Header] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	if (header_open)
+	{
+		ImGui::Text("Header content");
+		const bool tree_open = ImExt::TreeNode("Tree");
+		s.Targets[AllocTarget_Tree] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+		if (tree_open)
+		{
+			for (int n = 0; n < 4; n++)
+				ImGui::Text("Leaf %d", n);
+			ImExt::TreePop();
+		}
+		ImExt::TreePop();
+	}
+	ImGui::EndGroup();
+
+	ImGui::SameLine();
+	ImGui::BeginGroup();
+	ImExt::LogView("##Log", s.Log, "ERROR", ImVec2(400, 200)); s.Targets[AllocTarget_LogView] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	ImExt::TextEditor("##Editor", s.Editor, ImVec2(400, 200)); s.Targets[AllocTarget_Editor] = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+	ImGui::EndGroup();
+
+	ImGui::End();
+	ImGui::Render();
+}
+
+// After the warmup, no frame of the scenario may allocate through the ImGui allocator. Edits growing a document (typing in
+// the editor, a new log filter) are made during the warmup only, navigating and animating them are not.
+static bool TestAllocations()
+{
+	ImExt::DebugInstallAllocationCounter();
+	ImGuiContext* ctx = CreateTestContext();
+	ImExtIO& ext_io = ImExt::GetIO();
+	ext_io.ConfigFlags |= ImExtConfigFlags_DamageTracking;
+	ext_io.FrameBudget = 1.0f;
+
+	const int warmup_frames = ALLOC_SEGMENT_FRAMES * AllocTarget_COUNT * 8;
+	const int test_frames = ALLOC_SEGMENT_FRAMES * AllocTarget_COUNT * 8;
+	AllocScenario* s = IM_NEW(AllocScenario)();
+	s->Plot.Values.reserve(warmup_frames + test_frames);
+	for (int n = 0; n < IMEXT_PLOT_SERIES_LEVELS; n++)
+		s->Plot.Levels[n].reserve(((warmup_frames + test_frames) >> (3 * (n + 1))) + 1);
+
+	const char* log_filename = GetTempFilename("imext_tests_alloc.log");
+	FILE* f = fopen(log_filename, "wb");
+	TEST_CHECK(f != NULL);
+	for (int n = 0; n < 5000; n++)
+		fprintf(f, "%05d %s message\n", n, (n % 3) ? "info" : "ERROR");
+	fclose(f);
+	TEST_CHECK(s->Log.Open(log_filename));
+	for (int n = 0; n < 200; n++)
+		s->Editor.Insert(s->Editor.GetLength(), "The quick brown fox jumps over the lazy dog.\n");
+
+	int failed_frames = 0;
+	for (int frame = 0; frame < warmup_frames + test_frames; frame++)
+	{
+		AllocFrame(*s, frame, frame < warmup_frames);
+		if (frame <= warmup_frames) // MetricsAllocations is for the previous frame
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(200)); // Let tasks, the log indexer and its filter finish
+			continue;
+		}
+		const int allocations = ext_io.MetricsAllocations;
+		if (allocations != 0 && failed_frames++ < 10)
+			printf("TestAllocations: frame %d (script frame %d, target %d): %d allocations\n", frame, frame % (ALLOC_SEGMENT_FRAMES * AllocTarget_COUNT), (frame / ALLOC_SEGMENT_FRAMES) % AllocTarget_COUNT, allocations);
+	}
+
+	IM_DELETE(s);
+	ImGui::DestroyContext(ctx);
+	remove(log_filename);
+	TEST_CHECK(failed_frames == 0);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Log file truncation
+//-----------------------------------------------------------------------------
+
+// "wb" truncates the file in place like logrotate's copytruncate, the log file keeps the same inode open
+static bool WriteLogLines(const char* filename, const char* mode, int first, int count)
+{
+	FILE* f = fopen(filename, mode);
+	if (f == NULL)
+		return false;
+	for (int n = first; n < first + count; n++)
+		fprintf(f, "line %05d of the log, padded to a usual length\n", n);
+	fclose(f);
+	return true;
+}
+
+static void LogFrame(ImExtLogFile& log, const char* filter)
+{
+	ImGui::NewFrame();
+	ImGui::SetNextWindowPos(ImVec2(0, 0));
+	ImGui::SetNextWindowSize(ImVec2(600, 400));
+	ImGui::Begin("Log");
+	ImExt::LogView("##Log", log, filter, ImVec2(-FLT_MIN, -FLT_MIN));
+	ImGui::End();
+	ImGui::Render();
+}
+
+// Run frames until the view has 'lines_count' lines, false after 10 seconds
+static bool WaitLogLines(ImExtLogFile& log, const char* filter, int lines_count)
+{
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	do
+	{
+		LogFrame(log, filter);
+		if (log.GetLinesCount() == lines_count)
+			return true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	} while (std::chrono::steady_clock::now() < deadline);
+	return false;
+}
+
+static bool TestLogTruncation()
+{
+#ifdef _WIN32
+	return true; // Windows refuses to truncate a mapped file
+#else
+	ImGuiContext* ctx = CreateTestContext();
+	const char* filename = GetTempFilename("imext_tests_truncate.log");
+	TEST_CHECK(WriteLogLines(filename, "wb", 0, 20000));
+	ImExtLogFile log;
+	TEST_CHECK(log.Open(filename));
+	TEST_CHECK(WaitLogLines(log, "line", 20000));
+
+	// Truncated and rewritten while open: the view drops the pages past the new end and indexes the file again
+	TEST_CHECK(WriteLogLines(filename, "wb", 0, 100));
+	TEST_CHECK(WaitLogLines(log, "line", 100));
+	TEST_CHECK(WriteLogLines(filename, "ab", 100, 50));
+	TEST_CHECK(WaitLogLines(log, "line", 150));
+
+	// Truncated by another thread while frames and filter jobs read the mapping, reads race the truncations
+	std::atomic<bool> stop(false);
+	std::thread writer([&]()
+	{
+		for (int n = 0; !stop.load(std::memory_order_relaxed); n++)
+			WriteLogLines(filename, "wb", 0, (n & 1) ? 20000 : 10 + n % 100);
+	});
+	const auto stress_end = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+	for (int frame = 0; std::chrono::steady_clock::now() < stress_end; frame++)
+		LogFrame(log, (frame & 16) ? "line 1" : "line"); // A new pattern starts new filter jobs
+	stop.store(true, std::memory_order_relaxed);
+	writer.join();
+	TEST_CHECK(WriteLogLines(filename, "wb", 0, 42));
+	TEST_CHECK(WaitLogLines(log, NULL, 42));
+
+	log.Close();
+	ImGui::DestroyContext(ctx);
+	remove(filename);
+	return true;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+int main(int, char**)
+{
+	struct { const char* Name; bool (*Func)(); } tests[] =
+	{
+		{ "Allocations", TestAllocations },
+		{ "LogTruncation", TestLogTruncation },
+	};
+	int failed = 0;
+	for (int n = 0; n < IM_ARRAYSIZE(tests); n++)
+	{
+		const bool ok = tests[n].Func();
+		printf("%s: %s\n", tests[n].Name, ok ? "ok" : "FAILED");
+		failed += ok ? 0 : 1;
+	}
+	return failed ? 1 : 0;
+}
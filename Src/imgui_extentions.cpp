@@ -3,6 +3,51 @@
 #include <imgui.h>
 #include <imgui_internal.h>
 
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <regex>
+#include <thread>
+
+// Memory mapped files: log files and the font atlas cache
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// SIMD: SSE and AVX intrinsics come with imgui_internal.h when IMGUI_ENABLE_SSE is defined
+#if defined(IMGUI_ENABLE_SSE) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// ARMv8 CRC32 instructions for IMEXT_ENABLE_FAST_HASH, checked at runtime on Linux when the compiler target lacks them
+#if defined(IMEXT_ENABLE_FAST_HASH) && defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#include <arm_acle.h>
+#if !defined(__ARM_FEATURE_CRC32) && defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#define IMEXT_CRC32_HW_RUNTIME_CHECK
+#endif
+#define IMEXT_CRC32_HW
+#endif
+
 using namespace ImGui;
 
 static float CalcMaxPopupHeightFromItemCount(int items_count)
@@ -34,584 +79,6382 @@ static const char* PatchFormatStringFloatToInt(const char* fmt)
 	return fmt;
 }
 
-#pragma region ImDraw
-void ImExt::ImDraw::RenderTextClippedEx(ImDrawList* draw_list, const ImVec2& pos_min, const ImVec2& pos_max, const char* text, const char* text_display_end, const ImVec2* text_size_if_known, const ImU32 color, const ImVec2& align, const ImRect* clip_rect)
+#pragma region Context
+struct ImExtRenderCacheEntry
 {
-	// Perform CPU side clipping for single clipped element to avoid using scissor state
-	ImVec2 pos = pos_min;
-	const ImVec2 text_size = text_size_if_known ? *text_size_if_known : CalcTextSize(text, text_display_end, false, 0.0f);
+	ImU32 Hash;                         // Hash of everything the widget rendering depends on (see RenderCacheKey())
+	ImRect Bb;                          // Widget bounding box when last submitted
+	ImVec2 Origin;                      // Widget bb.Min when the vertices were recorded
+	int LastFrame;
+	ImVector<ImDrawVert> VtxBuffer;     // Vertices as emitted at Origin
+	ImVector<ImDrawIdx> IdxBuffer;      // Indices relative to the first recorded vertex
+	ImGuiID GlyphRunIds[2];             // Glyph runs the text was emitted from, kept alive while the entry is replayed
+	int GlyphRunIdsCount;
+
+	ImExtRenderCacheEntry() { Hash = 0; LastFrame = -1; GlyphRunIdsCount = 0; }
+};
+
+// Everything a glyph run is laid out from, but the text
+struct ImExtGlyphRunKey
+{
+	ImFont* Font;
+	float FontSize;
+	float WrapWidth;
+	int GlyphsGeneration;
+	int TextLength;
+};
+
+// Text laid out once, see AddTextCached()
+struct ImExtGlyphRun
+{
+	ImExtGlyphRunKey Key;               // Compared with the text on a hit: the run id is only a 32-bit hash
+	ImVec2 Origin;                      // Floored text position when the quads were laid out
+	ImRect Bb;                          // Bounds of the quads at Origin
+	int LastFrame;
+	ImVector<ImDrawVert> VtxBuffer;     // 4 vertices per glyph quad at Origin. col is 0 for tinted glyphs, ~IM_COL32_A_MASK for colored ones. The text follows in the spare capacity, which is a power of two.
+
+	ImExtGlyphRun() { memset((void*)&Key, 0, sizeof(Key)); LastFrame = -1; }
+	const char* GetText() const { return (const char*)(VtxBuffer.Data + VtxBuffer.Size); }
+};
+
+// Buffers of garbage collected cache entries, handed to the next entries. Capacities are powers of two, free list n holds
+// buffers of 1 << n elements. Never trimmed, like ImPool::Buf: bounded by the most entries alive at once.
+#define IMEXT_BUFFER_POOL_CLASSES   24
+
+template<typename T>
+struct ImExtBufferPool
+{
+	ImVector<ImVector<T> > FreeLists[IMEXT_BUFFER_POOL_CLASSES];
 
-	const ImVec2* clip_min = clip_rect ? &clip_rect->Min : &pos_min;
-	const ImVec2* clip_max = clip_rect ? &clip_rect->Max : &pos_max;
-	bool need_clipping = (pos.x + text_size.x >= clip_max->x) || (pos.y + text_size.y >= clip_max->y);
-	if (clip_rect) // If we had no explicit clipping rectangle then pos==clip_min
-		need_clipping |= (pos.x < clip_min->x) || (pos.y < clip_min->y);
+	~ImExtBufferPool()
+	{
+		for (int size_class = 0; size_class < IMEXT_BUFFER_POOL_CLASSES; size_class++)
+			for (int n = 0; n < FreeLists[size_class].Size; n++)
+				FreeLists[size_class][n].clear();
+	}
 
-	// Align whole block. We should defer that to the better rendering function when we'll have support for individual line alignment.
-	if (align.x > 0.0f) pos.x = ImMax(pos.x, pos.x + (pos_max.x - pos.x - text_size.x) * align.x);
-	if (align.y > 0.0f) pos.y = ImMax(pos.y, pos.y + (pos_max.y - pos.y - text_size.y) * align.y);
+	static int GetClass(int capacity)
+	{
+		int size_class = 0;
+		while ((1 << size_class) < capacity)
+			size_class++;
+		return size_class;
+	}
 
-	// Render
-	if (need_clipping)
+	// Make room for 'capacity' elements in 'buffer', swapping it for the smallest free buffer large enough. Contents are lost.
+	void Reserve(ImVector<T>& buffer, int capacity)
 	{
-		ImVec4 fine_clip_rect(clip_min->x, clip_min->y, clip_max->x, clip_max->y);
-		draw_list->AddText(NULL, 0.0f, pos, color, text, text_display_end, 0.0f, &fine_clip_rect);
+		if (buffer.Capacity >= capacity)
+			return;
+		Release(buffer);
+		for (int size_class = GetClass(capacity); size_class < IMEXT_BUFFER_POOL_CLASSES; size_class++)
+			if (FreeLists[size_class].Size > 0)
+			{
+				buffer.swap(FreeLists[size_class].back());
+				FreeLists[size_class].pop_back();
+				return;
+			}
+		buffer.reserve(ImUpperPowerOfTwo(capacity));
 	}
-	else
+
+	void Release(ImVector<T>& buffer)
 	{
-		draw_list->AddText(NULL, 0.0f, pos, color, text, text_display_end, 0.0f, NULL);
+		if (buffer.Capacity == 0)
+			return;
+		const int size_class = GetClass(buffer.Capacity);
+		if (buffer.Capacity != (1 << size_class) || size_class >= IMEXT_BUFFER_POOL_CLASSES)
+		{
+			buffer.clear();
+			return;
+		}
+		ImVector<ImVector<T> >& free_list = FreeLists[size_class];
+		free_list.resize(free_list.Size + 1);
+		IM_PLACEMENT_NEW(&free_list.back()) ImVector<T>();
+		free_list.back().swap(buffer);
+		free_list.back().resize(0);
 	}
-}
+};
 
-void ImExt::ImDraw::RenderTextClipped(const ImVec2& pos_min, const ImVec2& pos_max, const char* text, const char* text_end, const ImVec2* text_size_if_known, const ImU32 color, const ImVec2& align, const ImRect* clip_rect)
+// Vertices emitted by an ImExt widget in a draw list, excluded from the per draw list damage hash
+struct ImExtDrawRange
 {
-	// Hide anything after a '##' string
-	const char* text_display_end = FindRenderedTextEnd(text, text_end);
-	const int text_len = (int)(text_display_end - text);
-	if (text_len == 0)
-		return;
+	ImDrawList* DrawList;
+	int VtxStart;
+	int VtxEnd;
 
-	ImGuiContext& g = *GImGui;
-	ImGuiWindow* window = g.CurrentWindow;
-	RenderTextClippedEx(window->DrawList, pos_min, pos_max, text, text_display_end, text_size_if_known, color, align, clip_rect);
-	if (g.LogEnabled)
-		LogRenderedText(&pos_min, text, text_display_end);
-}
-#pragma endregion
+	ImExtDrawRange(ImDrawList* draw_list, int vtx_start, int vtx_end) { DrawList = draw_list; VtxStart = vtx_start; VtxEnd = vtx_end; }
+};
 
-bool ImExt::Button(const char* label, const ImVec2& size, const float dt, ImGuiButtonFlags flags)
+struct ImExtDrawListDamage
 {
-	ImGuiWindow* window = GetCurrentWindow();
-	if (window->SkipItems)
-		return false;
-
-	ImGuiContext& g = *GImGui;
-	const ImGuiStyle& style = g.Style;
-	const ImGuiID id = window->GetID(label);
-	const ImVec2 label_size = CalcTextSize(label, NULL, true);
+	ImU32 Hash;                         // Hash of the draw list vertices, ImExt widgets excluded
+	ImRect Rect;                        // Screen area covered by the draw list
+	int LastFrame;
 
-	ImVec2 pos = window->DC.CursorPos;
-	if ((flags & ImGuiButtonFlags_AlignTextBaseLine) && style.FramePadding.y < window->DC.CurrLineTextBaseOffset) // Try to vertically align buttons that are smaller/have no padding so that text baseline matches (bit hacky, since it shouldn't be a flag)
-		pos.y += window->DC.CurrLineTextBaseOffset - style.FramePadding.y;
-	ImVec2 item_size = CalcItemSize(ImVec2(size.x, size.y + label_size.y),
-		label_size.x + style.FramePadding.x * 2.0f,
-		label_size.y + style.FramePadding.y * 2.0f);
+	ImExtDrawListDamage() { Hash = 0; LastFrame = -1; }
+};
 
-	const ImRect bb(pos, ImVec2(pos.x + item_size.x, pos.y + item_size.y));
-	ItemSize(item_size, style.FramePadding.y);
-	if (!ItemAdd(bb, id))
-		return false;
+// Vertices emitted between PushGroupAlpha() and PopGroupAlpha()
+struct ImExtGroupAlpha
+{
+	ImGuiID Id;
+	ImDrawList* DrawList;
+	int VtxStart;
+	int Channel;                        // Draw list splitter channel, the range must not span several
+	float Alpha;
+};
+
+// Vertices emitted between PushTransform() and PopTransform()
+struct ImExtGroupTransform
+{
+	ImGuiID Id;
+	ImDrawList* DrawList;
+	int VtxStart;
+	int Channel;
+	float Matrix[6];                    // x' = [0] x + [1] y + [2], y' = [3] x + [4] y + [5]
+};
+
+// Alpha or transform applied to a group or window the last time it was drawn, for damage tracking
+struct ImExtGroupDamage
+{
+	ImU32 Hash;                         // Hash of the alpha or matrix
+	ImRect Bounds;
+	int LastFrame;
 
-	if (g.LastItemData.InFlags & ImGuiItemFlags_ButtonRepeat)
-		flags |= ImGuiButtonFlags_Repeat;
+	ImExtGroupDamage() { Hash = 0; LastFrame = -1; }
+};
 
-	bool hovered, held;
-	bool pressed = ButtonBehavior(bb, id, &hovered, &held, flags);
-	if (pressed)
-		MarkItemEdited(id);
+// Window faded by SetWindowAlpha(), applied when rendering
+struct ImExtWindowAlpha
+{
+	ImGuiWindow* Window;
+	float Alpha;
+};
 
-	//Animation
-	float last_active_id_timer = g.LastActiveIdTimer;
-	if (held || pressed)
-		g.LastActiveIdTimer = 0.f;
+// Slider and drag state, see SliderScalarEx() and DragScalarEx()
+struct ImExtSliderState
+{
+	int LastFrame;
+	bool Active;                        // Held during the previous frame
+	bool Inertia;                       // Flicked: the value keeps moving after the release
+	double Value;                       // Value at the end of the previous frame
+	double InertiaValue;                // Unrounded value while coasting
+	float ValueVelocity;                // Value units per second, estimated while held
+	float GrabPos;                      // Displayed grab position, from the frame left edge
+	float GrabVelocity;                 // Pixels per second
+
+	// Formatted value, see FormatValueCached()
+	ImU64 TextKey;                      // Bits of the value formatted into Text
+	ImU32 TextFormatHash;
+	bool TextNegative;                  // Float values of this sign with a magnitude strictly between TextMin and TextMax format into Text too
+	double TextMin;
+	double TextMax;
+	ImFont* TextFont;
+	float TextFontSize;
+	ImVec2 TextSize;
+	int TextLen;
+	char Text[64];
+
+	ImExtSliderState() { memset((void*)this, 0, sizeof(*this)); LastFrame = -1; }
+};
+
+// Animated number state, see AnimatedNumberEx()
+struct ImExtNumberState
+{
+	int LastFrame;
+	double From;                        // Tween endpoints, in units of the last displayed digit
+	double Target;
+	float Time;                         // Tween progress, 0.0f to 1.0f
+
+	// Parsed format, see ParseNumberFormat()
+	ImU32 FormatHash;
+	int Precision;                      // Digits after the point, -1 when the format is formatted as text
+	int PrefixLen;
+	int SuffixLen;
+	char Prefix[32];                    // Text around the conversion, "%%" unescaped
+	char Suffix[32];
+	ImFont* TextFont;
+	float TextFontSize;
+	float PrefixWidth;
+	float SuffixWidth;
+
+	ImExtNumberState() { memset((void*)this, 0, sizeof(*this)); LastFrame = -1; }
+};
+
+// Quads of the characters AnimatedNumber() draws without laying out text: "0123456789.-", scaled to one font size
+struct ImExtDigitGlyphs
+{
+	ImFont* Font;
+	float FontSize;
+	int GlyphsGeneration;
+	float DigitWidth;                   // Widest digit: every digit gets a column this wide so it can roll in place
+	ImFontGlyph Glyphs[12];
+
+	ImExtDigitGlyphs() { memset((void*)this, 0, sizeof(*this)); GlyphsGeneration = -1; }
+};
+
+// Sparkline state, see SparklineEx(). Columns are bins of SamplesPerColumn samples aligned on sample indices: a column
+// doesn't change once complete, so only new samples are decimated.
+struct ImExtSparklineState
+{
+	int LastFrame;
+	const ImExtSparklineBuffer* Buffer;
+	int SamplesPerColumn;
+	ImU64 Decimated;                    // Samples before this index are in the columns
+	ImU64 LastHead;                     // Buffer head during the previous frame
+	ImVector<float> ColumnMin;          // Ring of columns, indexed by column index % Size
+	ImVector<float> ColumnMax;
+	double ScrollHead;                  // Sample index at the right edge, lags behind Decimated while new columns scroll in
+	float ScaleMin;                     // Displayed scale
+	float ScaleMax;
+
+	ImExtSparklineState() { LastFrame = -1; Buffer = NULL; SamplesPerColumn = 0; Decimated = LastHead = 0; ScrollHead = 0.0; ScaleMin = ScaleMax = 0.0f; }
+};
+
+// Plot view, see PlotEx(). View* is the target range in value indices, Shown* the displayed one easing toward it.
+struct ImExtPlotState
+{
+	int LastFrame;
+	int LastCount;                      // Series size during the previous frame
+	bool FitAll;                        // Showing every value, until zoomed or panned
+	double ViewMin;
+	double ViewMax;
+	double ShownMin;
+	double ShownMax;
+	float ScaleMin;                     // Displayed vertical range
+	float ScaleMax;
+
+	ImExtPlotState() { LastFrame = -1; LastCount = 0; FitAll = true; ViewMin = ViewMax = ShownMin = ShownMax = 0.0; ScaleMin = ScaleMax = 0.0f; }
+};
+
+// Caret and selection of a TextEditor()
+struct ImExtTextEditorState
+{
+	int LastFrame;
+	int Cursor;                         // Caret offset
+	int SelectionAnchor;                // Other end of the selection, Cursor when nothing is selected
+	float PreferredX;                   // Caret x kept through vertical moves, -1 when unset
+	ImVec2 CaretShown;                  // Displayed caret position from the top left of the text, eases toward the caret
+	double BlinkStart;                  // g.Time of the last caret move
+	float WidestLine;                   // Content width: widest line displayed so far
+	bool Dragging;                      // Selecting with the mouse
+	bool CaretFollow;                   // Scroll to the caret
+
+	ImExtTextEditorState() { LastFrame = -1; Cursor = SelectionAnchor = 0; PreferredX = -1.0f; CaretShown = ImVec2(0.0f, 0.0f); BlinkStart = 0.0; WidestLine = 0.0f; Dragging = CaretFollow = false; }
+};
+
+// Open animation of a CollapsingHeader() or TreeNode()
+struct ImExtTreeNodeState
+{
+	int LastFrame;
+	float Shown;                        // Displayed fraction of the content, eases toward 0 or 1
+	float Height;                       // Content height when last submitted, -1 until then
 
-	if (g.LastActiveIdTimer == 0.f && g.LastActiveId == id && !pressed)
-		g.LastActiveIdTimer = last_active_id_timer;
+	ImExtTreeNodeState() { LastFrame = -1; Shown = 0.0f; Height = -1.0f; }
+};
 
-	float t = held ? 1.0f : 0.0f;
+// CollapsingHeader() or TreeNode() whose content is being submitted, until ImExt::TreePop()
+struct ImExtTreeNodeStackData
+{
+	ImGuiID Id;
+	float ContentStartY;
+	ImVec2 BackupCursorMaxPos;
+	bool Clipping;                      // Content partly shown, clip rectangle pushed
+	bool TreePushed;
+};
+
+// Next frame wanted by an animation
+struct ImExtAnimationDeadline
+{
+	double Time;
+	ImGuiID Id;
+	int Frame;                          // Frame during which it was scheduled
+	int Stamp;                          // Stale when the widget rescheduled since (see ImExtContext::AnimationStamps)
+};
 
-	if (g.LastActiveId == id)
-	{
-		float t_anim = ImSaturate(g.LastActiveIdTimer / 0.08f * dt);
-		t = held ? (t_anim) : (1.0f - t_anim);
-	}
+struct ImExtTask;
 
-	const float scale = item_size.x / 30.f * t;
-	const ImRect render_bb = ImRect(ImVec2(pos.x + (scale / 2), pos.y + (scale / 2 * (item_size.y / item_size.x))), ImVec2(pos.x + (item_size.x - scale), pos.y + (item_size.y - (scale * (item_size.y / item_size.x)))));
+struct ImExtContext
+{
+	ImGuiContext* Ctx;
+	ImExtIO IO;
+	ImGuiID HookIdNewFrame;
+	ImGuiID HookIdRender;
+	ImGuiID HookIdRenderPre;
+	ImGuiID HookIdShutdown;
+
+	// Render cache
+	ImPool<ImExtRenderCacheEntry> RenderCache;
+	ImExtRenderCacheEntry* RecordEntry; // Entry being recorded between RenderCacheBegin() and RenderCacheEnd()
+	ImDrawList* RecordDrawList;
+	ImDrawListFlags RecordDrawListFlags; // Restored by RenderCacheEnd(), the level of detail may drop anti-aliasing in between
+	int RecordVtxStart;
+	int RecordIdxStart;
+	int RecordCmdCount;
+	unsigned int RecordVtxCurrentIdx;
+	int RenderCacheHits;
+	int RenderCacheMisses;
+	ImExtBufferPool<ImDrawVert> RenderCacheVtxBuffers;
+	ImExtBufferPool<ImDrawIdx> RenderCacheIdxBuffers;
+
+	// Glyph run cache
+	ImPool<ImExtGlyphRun> GlyphRuns;
+	ImDrawList GlyphRunDrawList;        // Scratch draw list the runs are laid out in
+	ImExtBufferPool<ImDrawVert> GlyphRunBuffers;
+	int GlyphRunHits;
+	int GlyphRunMisses;
+
+	// Damage tracking
+	ImVector<ImRect> Damage;            // Damaged rectangles gathered during the current frame
+	ImVector<ImExtDrawRange> DrawRanges;
+	ImPool<ImExtDrawListDamage> DrawListDamage;
+	ImDrawList* RecordRangeDrawList;
+	int RecordRangeVtxStart;
+	ImVec2 DamageDisplaySize;
+
+	// Animation scheduler
+	ImVector<ImExtAnimationDeadline> AnimationHeap;
+	ImGuiStorage AnimationStamps;       // Widget ID -> stamp of its latest deadline
+	int AnimationStampCounter;
+
+	// Opacity and transforms
+	ImVector<ImExtGroupAlpha> GroupAlphaStack;
+	ImVector<ImExtGroupTransform> GroupTransformStack;
+	ImVector<ImExtWindowAlpha> WindowAlphas; // Submitted during the current frame
+	ImPool<ImExtGroupDamage> GroupDamage;
+	ImGuiStorage GroupCounts;           // Groups submitted during the current frame per ID scope, identifies them from one frame to the next
+
+	// Sliders and drags
+	ImPool<ImExtSliderState> Sliders;
+
+	// Animated numbers
+	ImPool<ImExtNumberState> Numbers;
+	ImExtDigitGlyphs DigitGlyphs;
+
+	// Sparklines
+	ImPool<ImExtSparklineState> Sparklines;
+	ImVector<float> SparklineSamples;   // Scratch copy of the samples being decimated
+
+	// Plots
+	ImPool<ImExtPlotState> Plots;
+	ImVector<ImVec2> PlotPoints;        // Scratch polyline
+
+	// Text editors
+	ImPool<ImExtTextEditorState> TextEditors;
+	ImVector<char> TextEditorLine;      // Scratch copy of the line being laid out
+
+	// Collapsing headers and tree nodes
+	ImPool<ImExtTreeNodeState> TreeNodes;
+	ImVector<ImExtTreeNodeStackData> TreeNodeStack;
+
+	// Background jobs
+	ImVector<ImExtTask*> Tasks;         // Submitted by TaskButton(), until the button is back to idle. Heap allocated, the jobs point to them.
+	ImVector<ImExtTask*> FreeTasks;     // Tasks back to idle, reused by the next submission
+
+	// Level of detail
+	float LodFrameTime;                 // Smoothed frame time
+	int LodOverBudgetFrames;
+	int LodUnderBudgetFrames;
+
+	// Allocation counter
+	int AllocationsFrameStart;          // Value of GImExtAllocationCount at the start of the frame
+
+	ImExtContext(ImGuiContext* ctx) : GlyphRunDrawList(&ctx->DrawListSharedData) { Ctx = ctx; GlyphRunHits = GlyphRunMisses = 0; HookIdNewFrame = HookIdRender = HookIdRenderPre = HookIdShutdown = 0; RecordEntry = NULL; RecordDrawList = NULL; RecordVtxStart = RecordIdxStart = RecordCmdCount = 0; RecordVtxCurrentIdx = 0; RecordDrawListFlags = 0; RenderCacheHits = RenderCacheMisses = 0; RecordRangeDrawList = NULL; RecordRangeVtxStart = 0; AnimationStampCounter = 0; LodFrameTime = 0.0f; LodOverBudgetFrames = LodUnderBudgetFrames = 0; AllocationsFrameStart = 0; }
+};
+
+static ImExtContext* GImExt = NULL;    // Last used context, the owning ImGui context keeps the pointer in its hooks
+static int GImExtContextsCount = 0;     // Alive contexts, the last one shut down stops the task pool
+
+// Allocation counter, see ImExt::DebugInstallAllocationCounter(). Allocator functions are global like in imgui.cpp.
+static ImGuiMemAllocFunc GImExtAllocatorAllocFunc = NULL;
+static ImGuiMemFreeFunc GImExtAllocatorFreeFunc = NULL;
+static void* GImExtAllocatorUserData = NULL;
+static int GImExtAllocationCount = 0;
+
+// Dynamic glyphs, see ImExt::EnableDynamicGlyphs(). The atlas can be shared by several ImGui contexts.
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+struct ImExtDynamicGlyphs;
+static ImExtDynamicGlyphs* GImExtDynamicGlyphs = NULL;
+#endif
+static int GImExtGlyphsGeneration = 0;  // Incremented when glyphs are added, part of the render cache key
 
-	// Render
-	const ImU32 col = GetColorU32((held && hovered) ? ImGuiCol_ButtonActive : hovered ? ImGuiCol_ButtonHovered : ImGuiCol_Button);
-	RenderNavHighlight(bb, id);
-	const ImVec2 pos_min = ImVec2(render_bb.Min.x + style.FramePadding.x / 2, render_bb.Min.y + style.FramePadding.y / 2);
-	const ImVec2 pos_max = ImVec2(render_bb.Max.x - style.FramePadding.x, render_bb.Max.y - style.FramePadding.y);
-	RenderFrame(pos_min, pos_max, col, true, style.FrameRounding);
+static ImGuiID GetExtContextHookOwner()
+{
+	static const ImGuiID owner = ImHashStr("ImExtContext");
+	return owner;
+}
 
-	if (g.LogEnabled)
-		LogSetNextTextDecoration("[", "]");
-	RenderTextClipped(pos_min, pos_max, label, NULL, &label_size, style.ButtonTextAlign, &render_bb);
+static void UpdateLod(ImExtContext& e);
+static void UpdateDynamicGlyphs(ImExtContext& e);
+static void UpdateTasks(ImExtContext& e);
+static void ShutdownTasks(ImExtContext& e);
 
-	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags);
-	return pressed;
+// Remove the entries of 'pool' not used during the last 60 frames
+// ImPool::Remove() leaves the key in the map: drop them too, keys like glyph run ids would otherwise pile up forever.
+template<typename T>
+static void GcPool(ImPool<T>& pool, int frame_count)
+{
+	for (int n = 0; n < pool.GetMapSize(); n++)
+		if (T* entry = pool.TryGetMapData(n))
+			if (entry->LastFrame < frame_count - 60)
+				pool.Remove(pool.Map.Data[n].key, entry);
+	ImVector<ImGuiStorage::ImGuiStoragePair>& map = pool.Map.Data;
+	int alive = 0;
+	for (int n = 0; n < map.Size; n++)
+		if (map[n].val_i != -1)
+			map[alive++] = map[n];
+	map.resize(alive);
 }
 
-IMGUI_API bool ImExt::ProgressButton(const char* label, bool* v, float* v_progress, const ImVec2& size, const float v_speed, const float dt, ImGuiButtonFlags flags)
+// Like GcPool(), keeping the buffers of the removed entries for the next widgets recorded
+static void GcRenderCache(ImExtContext& e, int frame_count)
 {
-	ImGuiWindow* window = GetCurrentWindow();
-	if (window->SkipItems)
-		return false;
-
-	ImGuiContext& g = *GImGui;
-	const ImGuiStyle& style = g.Style;
-	const ImGuiID id = window->GetID(label);
-	const ImVec2 label_size = CalcTextSize(label, NULL, true);
+	for (int n = 0; n < e.RenderCache.GetMapSize(); n++)
+		if (ImExtRenderCacheEntry* entry = e.RenderCache.TryGetMapData(n))
+			if (entry->LastFrame < frame_count - 60)
+			{
+				e.RenderCacheVtxBuffers.Release(entry->VtxBuffer);
+				e.RenderCacheIdxBuffers.Release(entry->IdxBuffer);
+			}
+	GcPool(e.RenderCache, frame_count);
+}
 
-	ImVec2 pos = window->DC.CursorPos;
-	if ((flags & ImGuiButtonFlags_AlignTextBaseLine) && style.FramePadding.y < window->DC.CurrLineTextBaseOffset) // Try to vertically align buttons that are smaller/have no padding so that text baseline matches (bit hacky, since it shouldn't be a flag)
-		pos.y += window->DC.CurrLineTextBaseOffset - style.FramePadding.y;
-	ImVec2 item_size = CalcItemSize(ImVec2(size.x, size.y + label_size.y),
-		label_size.x + style.FramePadding.x * 2.0f,
-		label_size.y + style.FramePadding.y * 2.0f);
+// Same for the glyph runs
+static void GcGlyphRuns(ImExtContext& e, int frame_count)
+{
+	for (int n = 0; n < e.GlyphRuns.GetMapSize(); n++)
+		if (ImExtGlyphRun* run = e.GlyphRuns.TryGetMapData(n))
+			if (run->LastFrame < frame_count - 60)
+				e.GlyphRunBuffers.Release(run->VtxBuffer);
+	GcPool(e.GlyphRuns, frame_count);
+}
 
-	const ImRect bb(pos, ImVec2(pos.x + item_size.x, pos.y + item_size.y));
-	ItemSize(item_size, style.FramePadding.y);
-	if (!ItemAdd(bb, id))
-		return false;
+static void ExtContextHook_NewFramePre(ImGuiContext* ctx, ImGuiContextHook* hook)
+{
+	ImExtContext& e = *(ImExtContext*)hook->UserData;
+	UpdateLod(e);
+	UpdateDynamicGlyphs(e);
+	UpdateTasks(e);
+	e.IO.MetricsRenderCacheHits = e.RenderCacheHits;
+	e.IO.MetricsRenderCacheMisses = e.RenderCacheMisses;
+	e.RenderCacheHits = e.RenderCacheMisses = 0;
+	e.IO.MetricsGlyphRunHits = e.GlyphRunHits;
+	e.IO.MetricsGlyphRunMisses = e.GlyphRunMisses;
+	e.GlyphRunHits = e.GlyphRunMisses = 0;
+
+	// Garbage collect widgets which were not submitted for a while
+	const int frame_count = ctx->FrameCount;
+	if ((frame_count % 60) == 0)
+	{
+		GcRenderCache(e, frame_count);
+		GcPool(e.DrawListDamage, frame_count);
+		GcPool(e.GroupDamage, frame_count);
+		GcGlyphRuns(e, frame_count);
+		GcPool(e.Sliders, frame_count);
+		GcPool(e.Numbers, frame_count);
+		GcPool(e.Sparklines, frame_count);
+		GcPool(e.Plots, frame_count);
+		GcPool(e.TextEditors, frame_count);
+		GcPool(e.TreeNodes, frame_count);
+	}
+	e.GroupCounts.Data.resize(0);
+	e.IO.MetricsRenderCacheEntries = e.RenderCache.GetAliveCount();
+	e.IO.MetricsGlyphRunEntries = e.GlyphRuns.GetAliveCount();
+
+	// Everything allocated since the previous NewFrame() counts for the previous frame
+	e.IO.MetricsAllocations = GImExtAllocationCount - e.AllocationsFrameStart;
+	e.AllocationsFrameStart = GImExtAllocationCount;
+	if ((e.IO.ConfigFlags & ImExtConfigFlags_DebugCheckAllocations) && frame_count > e.IO.DebugAllocationsWarmupFrames)
+		IM_ASSERT(e.IO.MetricsAllocations == 0 && "Heap allocation in steady state, see ImExtIO::MetricsAllocations");
+}
 
-	if (g.LastItemData.InFlags & ImGuiItemFlags_ButtonRepeat)
-		flags |= ImGuiButtonFlags_Repeat;
+static void UpdateDamageRects(ImExtContext& e);
+static void ApplyWindowAlphas(ImExtContext& e);
 
-	bool hovered, held;
-	bool pressed = ButtonBehavior(bb, id, &hovered, &held, flags);
-	if (pressed)
-		MarkItemEdited(id);
+static void ExtContextHook_RenderPre(ImGuiContext* ctx, ImGuiContextHook* hook)
+{
+	IM_UNUSED(ctx);
+	ImExtContext& e = *(ImExtContext*)hook->UserData;
+	ApplyWindowAlphas(e);
+}
+static void UpdateAnimationScheduler(ImExtContext& e);
 
-	//Animation
-	float last_active_id_timer = g.LastActiveIdTimer;
-	if (held || pressed)
-		g.LastActiveIdTimer = 0.f;
+static void ExtContextHook_RenderPost(ImGuiContext* ctx, ImGuiContextHook* hook)
+{
+	IM_UNUSED(ctx);
+	ImExtContext& e = *(ImExtContext*)hook->UserData;
+	UpdateDamageRects(e);
+	UpdateAnimationScheduler(e);
+}
 
-	if (g.LastActiveIdTimer == 0.f && g.LastActiveId == id && !pressed)
-		g.LastActiveIdTimer = last_active_id_timer;
+static void ExtContextHook_Shutdown(ImGuiContext* ctx, ImGuiContextHook* hook)
+{
+	IM_UNUSED(ctx);
+	ImExtContext* e = (ImExtContext*)hook->UserData;
+	if (GImExt == e)
+		GImExt = NULL;
+	ShutdownTasks(*e);
+	IM_DELETE(e);
+	if (--GImExtContextsCount == 0)
+		ImExt::ShutdownTaskPool();
+}
 
-	float t = held ? 1.0f : 0.0f;
+static ImExtContext& GetExtContext()
+{
+	ImGuiContext* ctx = GImGui;
+	IM_ASSERT(ctx != NULL && "No current context. Did you call ImGui::CreateContext() and ImGui::SetCurrentContext() ?");
+	if (GImExt && GImExt->Ctx == ctx)
+		return *GImExt;
+
+	const ImGuiID owner = GetExtContextHookOwner();
+	for (int n = 0; n < ctx->Hooks.Size; n++)
+		if (ctx->Hooks[n].Owner == owner && ctx->Hooks[n].Type == ImGuiContextHookType_Shutdown)
+			return *(GImExt = (ImExtContext*)ctx->Hooks[n].UserData);
+
+	ImExtContext* e = IM_NEW(ImExtContext)(ctx);
+	GImExtContextsCount++;
+	ImGuiContextHook hook;
+	hook.Owner = owner;
+	hook.UserData = e;
+	hook.Type = ImGuiContextHookType_NewFramePre;
+	hook.Callback = ExtContextHook_NewFramePre;
+	e->HookIdNewFrame = AddContextHook(ctx, &hook);
+	hook.Type = ImGuiContextHookType_RenderPost;
+	hook.Callback = ExtContextHook_RenderPost;
+	e->HookIdRender = AddContextHook(ctx, &hook);
+	hook.Type = ImGuiContextHookType_RenderPre;
+	hook.Callback = ExtContextHook_RenderPre;
+	e->HookIdRenderPre = AddContextHook(ctx, &hook);
+	hook.Type = ImGuiContextHookType_Shutdown;
+	hook.Callback = ExtContextHook_Shutdown;
+	e->HookIdShutdown = AddContextHook(ctx, &hook);
+	return *(GImExt = e);
+}
 
-	if (g.LastActiveId == id)
-	{
-		float t_anim = ImSaturate(g.LastActiveIdTimer / 0.08f * dt);
-		t = held ? (t_anim) : (1.0f - t_anim);
-	}
+ImExtIO& ImExt::GetIO()
+{
+	return GetExtContext().IO;
+}
 
-	const float scale = item_size.x / 30.f * t;
-	const ImRect render_bb = ImRect(ImVec2(pos.x + (scale / 2), pos.y + (scale / 2 * (pos.y / pos.x))), ImVec2(pos.x + (item_size.x - scale), pos.y + (item_size.y - (scale * (item_size.y / item_size.x)))));
+static void* ExtCountingAlloc(size_t size, void* user_data)
+{
+	IM_UNUSED(user_data);
+	GImExtAllocationCount++;
+	return GImExtAllocatorAllocFunc(size, GImExtAllocatorUserData);
+}
 
-	// Render
-	const ImU32 col = GetColorU32((held && hovered) ? ImGuiCol_ButtonActive : hovered ? ImGuiCol_ButtonHovered : ImGuiCol_Button);
-	RenderNavHighlight(bb, id);
-	const ImVec2 pos_min = ImVec2(render_bb.Min.x + style.FramePadding.x / 2, render_bb.Min.y + style.FramePadding.y / 2);
-	const ImVec2 pos_max = ImVec2(render_bb.Max.x - style.FramePadding.x, render_bb.Max.y - style.FramePadding.y);
-	RenderFrame(pos_min, pos_max, col, true, style.FrameRounding);
+static void ExtCountingFree(void* ptr, void* user_data)
+{
+	IM_UNUSED(user_data);
+	GImExtAllocatorFreeFunc(ptr, GImExtAllocatorUserData);
+}
 
-	if (g.LogEnabled)
-		LogSetNextTextDecoration("[", "]");
-	RenderTextClipped(pos_min, pos_max, label, NULL, &label_size, style.ButtonTextAlign, &render_bb);
+void ImExt::DebugInstallAllocationCounter()
+{
+	ImGuiMemAllocFunc alloc_func;
+	ImGuiMemFreeFunc free_func;
+	void* user_data;
+	GetAllocatorFunctions(&alloc_func, &free_func, &user_data);
+	if (alloc_func == ExtCountingAlloc)
+		return;
+	GImExtAllocatorAllocFunc = alloc_func;
+	GImExtAllocatorFreeFunc = free_func;
+	GImExtAllocatorUserData = user_data;
+	SetAllocatorFunctions(ExtCountingAlloc, ExtCountingFree, NULL);
+}
+#pragma endregion
 
-	float progress_size = pos_min.x;
-	if (v && v_progress)
+#pragma region RenderCache
+// Hash of the render inputs shared by all widgets: sub-pixel position, size, label, style, font and draw list flags.
+// Widgets mix in the colours they picked and their animation state.
+static ImU32 RenderCacheKey(const ImRect& bb, const char* label, const char* label_end, const ImU32* cols, int cols_count, const float* values, int values_count)
+{
+	ImGuiContext& g = *GImGui;
+	ImGuiWindow* window = g.CurrentWindow;
+	const ImGuiStyle& style = g.Style;
+	struct
 	{
-		if (*v_progress == 1.0f && pressed)
-			*v = !*v;
+		ImVec2 Fract, Size;
+		ImVec2 FramePadding, ItemInnerSpacing, ButtonTextAlign;
+		float FrameRounding, FrameBorderSize, FontSize, Alpha;
+		ImFont* Font;
+		ImDrawListFlags Flags;
+		int LodLevel;
+		int GlyphsGeneration;
+		ImU32 TextCol, BorderCol, BorderShadowCol, CheckMarkCol;
+	} key;
+	memset((void*)&key, 0, sizeof(key)); // Clear padding
+	key.Fract = ImVec2(bb.Min.x - ImFloor(bb.Min.x), bb.Min.y - ImFloor(bb.Min.y));
+	key.Size = bb.GetSize();
+	key.FramePadding = style.FramePadding;
+	key.ItemInnerSpacing = style.ItemInnerSpacing;
+	key.ButtonTextAlign = style.ButtonTextAlign;
+	key.FrameRounding = style.FrameRounding;
+	key.FrameBorderSize = style.FrameBorderSize;
+	key.FontSize = g.FontSize;
+	key.Alpha = style.Alpha;
+	key.Font = g.Font;
+	key.Flags = window->DrawList->Flags;
+	key.LodLevel = GetExtContext().IO.LodLevel;
+	key.GlyphsGeneration = GImExtGlyphsGeneration;
+	key.TextCol = GetColorU32(ImGuiCol_Text);
+	key.BorderCol = GetColorU32(ImGuiCol_Border);
+	key.BorderShadowCol = GetColorU32(ImGuiCol_BorderShadow);
+	key.CheckMarkCol = GetColorU32(ImGuiCol_CheckMark);
+
+	ImU32 hash = ImHashData(&key, sizeof(key));
+	hash = ImHashData(cols, sizeof(ImU32) * cols_count, hash);
+	hash = ImHashData(values, sizeof(float) * values_count, hash);
+	if (label)
+		hash = ImHashData(label, label_end ? (size_t)(label_end - label) : strlen(label), hash);
+	return hash;
+}
 
-		*v_progress = held ? (*v_progress < 1.0f ? *v_progress + v_speed : 1.0f) : 0.0f;
+static void AddDamageRect(ImExtContext& e, const ImRect& r)
+{
+	if (r.Min.x < r.Max.x && r.Min.y < r.Max.y)
+		e.Damage.push_back(r);
+}
 
-		progress_size += *v_progress * (pos_max.x - pos_min.x);
-		if (*v_progress > 0.0f)
+// Return true when the widget was replayed from the cache: the caller must skip its rendering.
+// Otherwise the caller renders as usual then calls RenderCacheEnd() to retain the emitted vertices.
+static bool RenderCacheBegin(ImGuiID id, const ImRect& bb, ImU32 hash)
+{
+	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
+	ImDrawList* draw_list = g.CurrentWindow->DrawList;
+	IM_ASSERT(e.RecordDrawList == NULL && "Mismatched RenderCacheBegin()/RenderCacheEnd()");
+
+	ImExtRenderCacheEntry* entry = (id != 0) ? e.RenderCache.GetOrAddByKey(id) : NULL;
+	const bool track_damage = (e.IO.ConfigFlags & ImExtConfigFlags_DamageTracking) != 0;
+	const bool same_hash = entry && entry->Hash == hash;
+	if (entry)
+	{
+		// Widgets which were not submitted last frame had their previous rectangle damaged when they vanished
+		if (track_damage)
 		{
-			ImColor frame_color = ImColor(0.5f + (*v_progress) / 2.f, 0.5f + (*v_progress) / 2.f, 0.5f + (*v_progress) / 2.f, *v_progress);
-			ImColor text_color = ImColor(1.f - frame_color.Value.x, 1.f - frame_color.Value.y, 1.f - frame_color.Value.z, *v_progress);
-			RenderFrame(pos_min, ImVec2(progress_size, pos_max.y), frame_color, true, style.FrameRounding);
-			ImDraw::RenderTextClipped(pos_min, pos_max, label, NULL, &label_size, text_color, style.ButtonTextAlign, &render_bb);
+			if (entry->LastFrame != g.FrameCount - 1)
+				AddDamageRect(e, bb);
+			else if (!same_hash || entry->Bb.Min.x != bb.Min.x || entry->Bb.Min.y != bb.Min.y || entry->Bb.Max.x != bb.Max.x || entry->Bb.Max.y != bb.Max.y)
+				AddDamageRect(e, ImRect(ImMin(entry->Bb.Min, bb.Min), ImMax(entry->Bb.Max, bb.Max)));
 		}
+		entry->Hash = hash;
+		entry->Bb = bb;
 	}
 
-	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags);
-	return pressed;
-}
+	// Vertices emitted inside a draw list channel are moved around on merge, we can neither replay nor locate them later
+	if (track_damage && draw_list->_Splitter._Count <= 1)
+	{
+		e.RecordRangeDrawList = draw_list;
+		e.RecordRangeVtxStart = draw_list->VtxBuffer.Size;
+	}
 
-IMGUI_API bool ImExt::ToggleButton(const char* label, bool* v, const ImVec2& size, const float dt, ImGuiButtonFlags flags)
-{
-	ImGuiWindow* window = GetCurrentWindow();
-	if (window->SkipItems)
+	// Cached vertices are only valid when nothing outside of the widget inputs can affect them:
+	// - text log capture needs the text submitted,
+	// - the draw list coarse clipping would cull text lines,
+	// - everything is rendered with the font atlas texture (solid fills use its white pixel).
+	const ImVec4& clip_rect = draw_list->_CmdHeader.ClipRect;
+	if (entry == NULL || (e.IO.ConfigFlags & ImExtConfigFlags_NoRenderCache) || g.LogEnabled || draw_list->_Splitter._Count > 1 ||
+		bb.Min.x < clip_rect.x || bb.Min.y < clip_rect.y || bb.Max.x > clip_rect.z || bb.Max.y > clip_rect.w ||
+		draw_list->_CmdHeader.TextureId != g.Font->ContainerAtlas->TexID)
+	{
+		if (entry)
+		{
+			entry->LastFrame = g.FrameCount;
+			entry->VtxBuffer.resize(0);
+		}
+		e.RenderCacheMisses++;
+		e.RecordDrawList = draw_list;
+		e.RecordDrawListFlags = draw_list->Flags;
+		if (e.IO.LodLevel >= ImExtLod_Reduced)
+			draw_list->Flags &= ~(ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AntiAliasedFill);
 		return false;
+	}
 
-	ImGuiContext& g = *GImGui;
-	const ImGuiStyle& style = g.Style;
-	const ImGuiID id = window->GetID(label);
-	const ImVec2 label_size = CalcTextSize(label, NULL, true);
-
-	ImVec2 pos = window->DC.CursorPos;
-	if ((flags & ImGuiButtonFlags_AlignTextBaseLine) && style.FramePadding.y < window->DC.CurrLineTextBaseOffset) // Try to vertically align buttons that are smaller/have no padding so that text baseline matches (bit hacky, since it shouldn't be a flag)
-		pos.y += window->DC.CurrLineTextBaseOffset - style.FramePadding.y;
-	ImVec2 item_size = CalcItemSize(ImVec2(size.x, size.y + label_size.y),
-		label_size.x + style.FramePadding.x * 2.0f, label_size.y + style.FramePadding.y * 2.0f);
+	if (same_hash && entry->LastFrame != g.FrameCount && entry->VtxBuffer.Size > 0)
+	{
+		entry->LastFrame = g.FrameCount;
+		e.RenderCacheHits++;
+		for (int n = 0; n < entry->GlyphRunIdsCount; n++)
+			if (ImExtGlyphRun* run = e.GlyphRuns.GetByKey(entry->GlyphRunIds[n]))
+				run->LastFrame = g.FrameCount;
+
+		const int vtx_count = entry->VtxBuffer.Size;
+		const int idx_count = entry->IdxBuffer.Size;
+		draw_list->PrimReserve(idx_count, vtx_count);
+		const ImVec2 delta(bb.Min.x - entry->Origin.x, bb.Min.y - entry->Origin.y);
+		ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+		if (delta.x == 0.0f && delta.y == 0.0f)
+		{
+			memcpy(vtx_write, entry->VtxBuffer.Data, (size_t)vtx_count * sizeof(ImDrawVert));
+		}
+		else
+		{
+			// Widget moved (e.g. scrolling): translate, then re-anchor the entry so the following frames are plain copies
+			ImDrawVert* vtx_read = entry->VtxBuffer.Data;
+			for (int n = 0; n < vtx_count; n++, vtx_read++, vtx_write++)
+			{
+				vtx_read->pos = ImVec2(vtx_read->pos.x + delta.x, vtx_read->pos.y + delta.y);
+				*vtx_write = *vtx_read;
+			}
+			entry->Origin = bb.Min;
+		}
+		const ImDrawIdx vtx_base = (ImDrawIdx)draw_list->_VtxCurrentIdx;
+		const ImDrawIdx* idx_read = entry->IdxBuffer.Data;
+		ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+		for (int n = 0; n < idx_count; n++)
+			idx_write[n] = (ImDrawIdx)(idx_read[n] + vtx_base);
+		draw_list->_VtxWritePtr += vtx_count;
+		draw_list->_IdxWritePtr += idx_count;
+		draw_list->_VtxCurrentIdx += vtx_count;
+
+		if (e.RecordRangeDrawList)
+		{
+			e.DrawRanges.push_back(ImExtDrawRange(draw_list, e.RecordRangeVtxStart, draw_list->VtxBuffer.Size));
+			e.RecordRangeDrawList = NULL;
+		}
+		return true;
+	}
 
-	const ImRect bb(pos, ImVec2(pos.x + item_size.x, pos.y + item_size.y));
-	ItemSize(item_size, style.FramePadding.y);
-	if (!ItemAdd(bb, id))
-		return false;
+	e.RenderCacheMisses++;
+	entry->Origin = bb.Min;
+	entry->LastFrame = g.FrameCount;
+	e.RecordEntry = entry;
+	entry->GlyphRunIdsCount = 0;
+	e.RecordDrawList = draw_list;
+	e.RecordVtxStart = draw_list->VtxBuffer.Size;
+	e.RecordIdxStart = draw_list->IdxBuffer.Size;
+	e.RecordCmdCount = draw_list->CmdBuffer.Size;
+	e.RecordVtxCurrentIdx = draw_list->_VtxCurrentIdx;
+	e.RecordDrawListFlags = draw_list->Flags;
+	if (e.IO.LodLevel >= ImExtLod_Reduced)
+		draw_list->Flags &= ~(ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AntiAliasedFill);
+	return false;
+}
 
-	if (g.LastItemData.InFlags & ImGuiItemFlags_ButtonRepeat)
-		flags |= ImGuiButtonFlags_Repeat;
+static void RenderCacheEnd()
+{
+	ImExtContext& e = GetExtContext();
+	ImDrawList* draw_list = e.RecordDrawList;
+	IM_ASSERT(draw_list != NULL && "Mismatched RenderCacheBegin()/RenderCacheEnd()");
+	ImExtRenderCacheEntry* entry = e.RecordEntry;
+	draw_list->Flags = e.RecordDrawListFlags;
+	e.RecordDrawList = NULL;
+	e.RecordEntry = NULL;
+
+	if (e.RecordRangeDrawList)
+	{
+		e.DrawRanges.push_back(ImExtDrawRange(draw_list, e.RecordRangeVtxStart, draw_list->VtxBuffer.Size));
+		e.RecordRangeDrawList = NULL;
+	}
+	if (entry == NULL) // Caching was not possible for this widget
+		return;
 
-	bool hovered, held;
-	bool pressed = ButtonBehavior(bb, id, &hovered, &held, flags);
-	if (pressed)
+	// Recorded range must belong to a single draw command, otherwise indices can't be rebased
+	const int vtx_count = draw_list->VtxBuffer.Size - e.RecordVtxStart;
+	const int idx_count = draw_list->IdxBuffer.Size - e.RecordIdxStart;
+	if (draw_list->CmdBuffer.Size != e.RecordCmdCount || draw_list->_VtxCurrentIdx != e.RecordVtxCurrentIdx + (unsigned int)vtx_count)
 	{
-		*v = !(*v);
-		MarkItemEdited(id);
+		entry->VtxBuffer.resize(0);
+		entry->IdxBuffer.resize(0);
+		return;
 	}
 
-	// Animation
-	float last_active_id_timer = g.LastActiveIdTimer;
-	if (held || pressed)
-		g.LastActiveIdTimer = 0.f;
+	e.RenderCacheVtxBuffers.Reserve(entry->VtxBuffer, vtx_count);
+	e.RenderCacheIdxBuffers.Reserve(entry->IdxBuffer, idx_count);
+	entry->VtxBuffer.resize(vtx_count);
+	entry->IdxBuffer.resize(idx_count);
+	memcpy(entry->VtxBuffer.Data, draw_list->VtxBuffer.Data + e.RecordVtxStart, (size_t)vtx_count * sizeof(ImDrawVert));
+	const ImDrawIdx vtx_base = (ImDrawIdx)e.RecordVtxCurrentIdx;
+	const ImDrawIdx* idx_read = draw_list->IdxBuffer.Data + e.RecordIdxStart;
+	for (int n = 0; n < idx_count; n++)
+		entry->IdxBuffer.Data[n] = (ImDrawIdx)(idx_read[n] - vtx_base);
+}
+#pragma endregion
 
-	if (g.LastActiveIdTimer == 0.f && g.LastActiveId == id && !pressed)
-		g.LastActiveIdTimer = last_active_id_timer;
+#pragma region Damage
+static int IMGUI_CDECL DrawRangeComparer(const void* lhs, const void* rhs)
+{
+	const ImExtDrawRange* a = (const ImExtDrawRange*)lhs;
+	const ImExtDrawRange* b = (const ImExtDrawRange*)rhs;
+	if (a->DrawList != b->DrawList)
+		return (a->DrawList < b->DrawList) ? -1 : +1;
+	return a->VtxStart - b->VtxStart;
+}
 
-	float t = held ? 1.0f : 0.0f;
+// Hash the vertices of a draw list, leaving out the ranges emitted by ImExt widgets (they report their own damage).
+// 'ranges' is sorted by draw list then vertex offset.
+static ImU32 HashDrawListContents(ImDrawList* draw_list, const ImVector<ImExtDrawRange>& ranges)
+{
+	int lo = 0, hi = ranges.Size;
+	while (lo < hi)
+	{
+		const int mid = (lo + hi) / 2;
+		if (ranges[mid].DrawList < draw_list)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
 
-	if (g.LastActiveId == id)
+	ImU32 hash = 0;
+	int vtx_n = 0;
+	for (const ImExtDrawRange* r = ranges.Data + lo; r < ranges.Data + ranges.Size && r->DrawList == draw_list; r++)
 	{
-		float t_anim = ImSaturate(g.LastActiveIdTimer / 0.08f * dt);
-		t = held ? (t_anim) : (1.0f - t_anim);
+		if (r->VtxStart > vtx_n)
+			hash = ImHashData(draw_list->VtxBuffer.Data + vtx_n, (size_t)(r->VtxStart - vtx_n) * sizeof(ImDrawVert), hash);
+		vtx_n = ImMax(vtx_n, r->VtxEnd);
 	}
+	if (draw_list->VtxBuffer.Size > vtx_n)
+		hash = ImHashData(draw_list->VtxBuffer.Data + vtx_n, (size_t)(draw_list->VtxBuffer.Size - vtx_n) * sizeof(ImDrawVert), hash);
+	return hash;
+}
 
-	const float scale = item_size.x / 30.f * t;
-	const ImRect render_bb = ImRect(ImVec2(pos.x + (scale / 2), pos.y + (scale / 2 * (item_size.y / item_size.x))), ImVec2(pos.x + (item_size.x - scale), pos.y + (item_size.y - (scale * (item_size.y / item_size.x)))));
+static void TrackDrawListDamage(ImExtContext& e, ImGuiID key, ImDrawList* draw_list, const ImRect& rect)
+{
+	ImGuiContext& g = *e.Ctx;
+	const ImU32 hash = HashDrawListContents(draw_list, e.DrawRanges);
+	ImExtDrawListDamage* d = e.DrawListDamage.GetOrAddByKey(key);
+	if (d->LastFrame != g.FrameCount - 1)
+		AddDamageRect(e, rect);
+	else if (d->Hash != hash || d->Rect.Min.x != rect.Min.x || d->Rect.Min.y != rect.Min.y || d->Rect.Max.x != rect.Max.x || d->Rect.Max.y != rect.Max.y)
+		AddDamageRect(e, ImRect(ImMin(d->Rect.Min, rect.Min), ImMax(d->Rect.Max, rect.Max)));
+	d->Hash = hash;
+	d->Rect = rect;
+	d->LastFrame = g.FrameCount;
+}
 
-	// Render
-	const ImU32 col = *v ? GetColorU32(ImGuiCol_ButtonActive) : GetColorU32((held && hovered) ? ImGuiCol_ButtonActive : hovered ? ImGuiCol_ButtonHovered : ImGuiCol_Button);
+// Merge overlapping rectangles, and fall back to their bounding box when there are too many of them
+static void MergeDamageRects(ImVector<ImRect>& rects, const ImRect& display_rect, int max_count)
+{
+	for (int i = 0; i < rects.Size; i++)
+		rects[i].ClipWithFull(display_rect);
+	for (int i = 0; i < rects.Size; i++)
+	{
+		if (rects[i].Min.x >= rects[i].Max.x || rects[i].Min.y >= rects[i].Max.y)
+		{
+			rects.erase(rects.Data + i--);
+			continue;
+		}
+		for (int j = i + 1; j < rects.Size; j++)
+			if (rects[i].Overlaps(rects[j]))
+			{
+				rects[i].Add(rects[j]);
+				rects.erase(rects.Data + j);
+				i = -1; // Grown rectangle may now overlap the ones already visited
+				break;
+			}
+	}
+	if (max_count > 0 && rects.Size > max_count)
+	{
+		ImRect bounds = rects[0];
+		for (int i = 1; i < rects.Size; i++)
+			bounds.Add(rects[i]);
+		rects.resize(1);
+		rects[0] = bounds;
+	}
+}
+
+static void UpdateDamageRects(ImExtContext& e)
+{
+	ImGuiContext& g = *e.Ctx;
+	if (!(e.IO.ConfigFlags & ImExtConfigFlags_DamageTracking))
+	{
+		e.DrawRanges.resize(0);
+		e.Damage.resize(0);
+		return;
+	}
+
+	// Everything is damaged on the first tracked frame or when the display changes
+	const ImRect display_rect(ImVec2(0.0f, 0.0f), g.IO.DisplaySize);
+	if (e.DamageDisplaySize.x != g.IO.DisplaySize.x || e.DamageDisplaySize.y != g.IO.DisplaySize.y)
+	{
+		e.DamageDisplaySize = g.IO.DisplaySize;
+		AddDamageRect(e, display_rect);
+	}
+
+	// ImExt widgets which were submitted last frame but not this one
+	for (int n = 0; n < e.RenderCache.GetMapSize(); n++)
+		if (ImExtRenderCacheEntry* entry = e.RenderCache.TryGetMapData(n))
+			if (entry->LastFrame == g.FrameCount - 1)
+				AddDamageRect(e, entry->Bb);
+
+	// Everything else (windows, ImGui widgets, custom drawing) is compared per draw list
+	if (e.DrawRanges.Size > 1)
+		ImQsort(e.DrawRanges.Data, (size_t)e.DrawRanges.Size, sizeof(ImExtDrawRange), DrawRangeComparer);
+	for (int n = 0; n < g.Windows.Size; n++)
+	{
+		ImGuiWindow* window = g.Windows[n];
+		if (window->Active && !window->Hidden)
+			TrackDrawListDamage(e, window->ID, window->DrawList, window->Rect());
+	}
+	ImGuiViewportP* viewport = g.Viewports[0];
+	for (int n = 0; n < IM_ARRAYSIZE(viewport->DrawLists); n++)
+		if (viewport->DrawLists[n] != NULL && viewport->DrawListsLastFrame[n] == g.FrameCount)
+			TrackDrawListDamage(e, ImHashData(&n, sizeof(n), GetExtContextHookOwner()), viewport->DrawLists[n], display_rect);
+	for (int n = 0; n < e.DrawListDamage.GetMapSize(); n++)
+		if (ImExtDrawListDamage* d = e.DrawListDamage.TryGetMapData(n))
+			if (d->LastFrame == g.FrameCount - 1)
+				AddDamageRect(e, d->Rect);
+
+	MergeDamageRects(e.Damage, display_rect, e.IO.DamageRectsMax);
+	e.IO.DamageRects.resize(e.Damage.Size);
+	if (e.Damage.Size > 0)
+		memcpy(e.IO.DamageRects.Data, e.Damage.Data, (size_t)e.Damage.Size * sizeof(ImRect));
+	e.Damage.resize(0);
+	e.DrawRanges.resize(0);
+}
+#pragma endregion
+
+#pragma region Scheduler
+// Min-heap of the next frame each animation needs, on g.Time. Entries are never updated in place: a widget which
+// reschedules pushes a new entry and the older ones are recognized as stale through their stamp.
+static bool AnimationDeadlineLess(const ImExtAnimationDeadline& a, const ImExtAnimationDeadline& b)
+{
+	return a.Time < b.Time;
+}
+
+static void AnimationHeapPush(ImVector<ImExtAnimationDeadline>& heap, const ImExtAnimationDeadline& deadline)
+{
+	heap.push_back(deadline);
+	int n = heap.Size - 1;
+	while (n > 0)
+	{
+		const int parent = (n - 1) / 2;
+		if (!AnimationDeadlineLess(heap[n], heap[parent]))
+			break;
+		ImSwap(heap[n], heap[parent]);
+		n = parent;
+	}
+}
+
+static void AnimationHeapPop(ImVector<ImExtAnimationDeadline>& heap)
+{
+	heap[0] = heap.back();
+	heap.pop_back();
+	int n = 0;
+	for (;;)
+	{
+		const int child_l = n * 2 + 1, child_r = n * 2 + 2;
+		int smallest = n;
+		if (child_l < heap.Size && AnimationDeadlineLess(heap[child_l], heap[smallest]))
+			smallest = child_l;
+		if (child_r < heap.Size && AnimationDeadlineLess(heap[child_r], heap[smallest]))
+			smallest = child_r;
+		if (smallest == n)
+			break;
+		ImSwap(heap[n], heap[smallest]);
+		n = smallest;
+	}
+}
+
+// Tell the scheduler widget 'id' keeps animating for 'remaining' seconds, its pixels moving at 'speed' pixels per second.
+// The next frame is due once the motion reaches ImExtIO::AnimationMinPixelDelta, and at the latest at the end of the animation.
+static void ScheduleAnimation(ImGuiID id, float remaining, float speed)
+{
+	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
+	if (remaining <= 0.0f)
+		return;
+	const float min_interval = (e.IO.AnimationMaxFrameRate > 0.0f) ? 1.0f / e.IO.AnimationMaxFrameRate : 0.0f;
+	float interval = (speed > 0.0f) ? e.IO.AnimationMinPixelDelta / speed : remaining;
+	interval = ImMin(ImMax(interval, min_interval), ImMax(remaining, min_interval));
+
+	ImExtAnimationDeadline deadline;
+	deadline.Time = g.Time + interval;
+	deadline.Id = id;
+	deadline.Frame = g.FrameCount;
+	deadline.Stamp = ++e.AnimationStampCounter;
+	e.AnimationStamps.SetInt(id, deadline.Stamp);
+	AnimationHeapPush(e.AnimationHeap, deadline);
+}
+
+// ID of the n-th additional animation of widget 'id': the scheduler keeps one deadline per ID
+static ImGuiID GetAnimationId(ImGuiID id, int n)
+{
+	return ImHashData(&n, sizeof(n), id);
+}
+
+// Animations driven by g.LastActiveIdTimer: a ramp of 'duration' seconds moving pixels by up to 'extent'
+static void ScheduleActiveIdAnimation(ImGuiID id, float duration, float extent)
+{
+	ImGuiContext& g = *GImGui;
+	if (g.LastActiveId == id && g.LastActiveIdTimer < duration && GetExtContext().IO.LodLevel < ImExtLod_Minimal)
+		ScheduleAnimation(id, duration - g.LastActiveIdTimer, extent / duration);
+}
+
+// Animation progress as rendered: animations jump to their end state under ImExtLod_Minimal
+static float LodAnimationTime(float t_anim)
+{
+	return (GetExtContext().IO.LodLevel >= ImExtLod_Minimal) ? 1.0f : t_anim;
+}
+
+static int LodCircleSegments(int num_segments)
+{
+	return (GetExtContext().IO.LodLevel >= ImExtLod_Reduced) ? ImMax(num_segments / 2, 6) : num_segments;
+}
+
+static void UpdateAnimationScheduler(ImExtContext& e)
+{
+	ImGuiContext& g = *e.Ctx;
+	ImVector<ImExtAnimationDeadline>& heap = e.AnimationHeap;
+	while (heap.Size > 0)
+	{
+		const ImExtAnimationDeadline& top = heap[0];
+		const bool stale = e.AnimationStamps.GetInt(top.Id, 0) != top.Stamp;
+		const bool serviced = top.Frame < g.FrameCount && top.Time <= g.Time; // This frame happened at or after the deadline
+		if (!stale && !serviced)
+			break;
+		if (!stale)
+			e.AnimationStamps.SetInt(top.Id, 0);
+		AnimationHeapPop(heap);
+	}
+	e.IO.NextFrameDelay = (heap.Size > 0) ? ImMax((float)(heap[0].Time - g.Time), 0.0f) : FLT_MAX;
+	e.IO.MetricsActiveAnimations = heap.Size;
+}
+#pragma endregion
+
+#pragma region Lod
+// Degrade rendering while frames go over ImExtIO::FrameBudget, recover once there is headroom again.
+// Levels move one step at a time with hysteresis so a single slow frame doesn't make widgets flicker between levels.
+static void UpdateLod(ImExtContext& e)
+{
+	ImGuiContext& g = *e.Ctx;
+	if (e.IO.FrameBudget <= 0.0f)
+	{
+		e.IO.LodLevel = ImExtLod_Full;
+		e.LodFrameTime = 0.0f;
+		e.LodOverBudgetFrames = e.LodUnderBudgetFrames = 0;
+		return;
+	}
+
+	const float frame_time = (e.IO.FrameTime > 0.0f) ? e.IO.FrameTime : g.IO.DeltaTime;
+	e.LodFrameTime = (e.LodFrameTime > 0.0f) ? ImLerp(e.LodFrameTime, frame_time, 0.2f) : frame_time;
+	if (e.LodFrameTime > e.IO.FrameBudget)
+	{
+		e.LodUnderBudgetFrames = 0;
+		if (++e.LodOverBudgetFrames >= 3 && e.IO.LodLevel < ImExtLod_Minimal)
+		{
+			e.IO.LodLevel++;
+			e.LodOverBudgetFrames = 0;
+		}
+	}
+	else if (e.LodFrameTime < e.IO.FrameBudget * 0.75f)
+	{
+		e.LodOverBudgetFrames = 0;
+		if (++e.LodUnderBudgetFrames >= 60 && e.IO.LodLevel > ImExtLod_Full)
+		{
+			e.IO.LodLevel--;
+			e.LodUnderBudgetFrames = 0;
+		}
+	}
+	else
+	{
+		e.LodOverBudgetFrames = e.LodUnderBudgetFrames = 0;
+	}
+}
+#pragma endregion
+
+#pragma region Vertices
+// SIMD passes over ImDrawVert load 4 vertices, 80 bytes, as 5 registers of 4 floats then shuffle their positions and colours
+// into lanes: the colour of vertex k is lane k of register k+1. Custom ImDrawVert layouts keep the scalar loops.
+#if defined(IMGUI_ENABLE_SSE) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+#define IMEXT_VERTS_SSE
+#elif defined(__aarch64__) && defined(__ARM_NEON) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+#define IMEXT_VERTS_NEON
+#endif
+
+#if defined(IMEXT_VERTS_SSE)
+// Positions of vert[0..3] as [x0 y0 x1 y1] [x2 y2 x3 y3], their colours as [c0 c1 c2 c3] when 'out_col' is set
+static inline void LoadVerts4(const ImDrawVert* vert, __m128* out_pos01, __m128* out_pos23, __m128i* out_col)
+{
+	const float* f = (const float*)(const void*)vert;
+	const __m128 v0 = _mm_loadu_ps(f), v1 = _mm_loadu_ps(f + 4), v2 = _mm_loadu_ps(f + 8), v3 = _mm_loadu_ps(f + 12), v4 = _mm_loadu_ps(f + 16);
+	*out_pos01 = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 1, 1, 0));
+	*out_pos23 = _mm_shuffle_ps(v2, _mm_shuffle_ps(v3, v4, _MM_SHUFFLE(0, 0, 3, 3)), _MM_SHUFFLE(2, 0, 3, 2));
+	if (out_col)
+		*out_col = _mm_castps_si128(_mm_shuffle_ps(_mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 1, 0, 0)), _mm_shuffle_ps(v3, v4, _MM_SHUFFLE(3, 3, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+static inline void StoreVertsPos4(ImDrawVert* vert, __m128 pos01, __m128 pos23)
+{
+	_mm_storel_pi((__m64*)(void*)&vert[0].pos, pos01);
+	_mm_storeh_pi((__m64*)(void*)&vert[1].pos, pos01);
+	_mm_storel_pi((__m64*)(void*)&vert[2].pos, pos23);
+	_mm_storeh_pi((__m64*)(void*)&vert[3].pos, pos23);
+}
+
+static inline void StoreVertsCol4(ImDrawVert* vert, __m128i col)
+{
+	vert[0].col = (ImU32)_mm_cvtsi128_si32(col);
+	vert[1].col = (ImU32)_mm_cvtsi128_si32(_mm_shuffle_epi32(col, _MM_SHUFFLE(1, 1, 1, 1)));
+	vert[2].col = (ImU32)_mm_cvtsi128_si32(_mm_shuffle_epi32(col, _MM_SHUFFLE(2, 2, 2, 2)));
+	vert[3].col = (ImU32)_mm_cvtsi128_si32(_mm_shuffle_epi32(col, _MM_SHUFFLE(3, 3, 3, 3)));
+}
+
+// Add the [x y x y] minimums and maximums of positions to 'bounds'
+static inline void AddVertsBounds(ImRect* bounds, __m128 acc_min, __m128 acc_max)
+{
+	ImVec2 v_min, v_max;
+	_mm_storel_pi((__m64*)(void*)&v_min, _mm_min_ps(acc_min, _mm_movehl_ps(acc_min, acc_min)));
+	_mm_storel_pi((__m64*)(void*)&v_max, _mm_max_ps(acc_max, _mm_movehl_ps(acc_max, acc_max)));
+	bounds->Add(ImRect(v_min, v_max));
+}
+#elif defined(IMEXT_VERTS_NEON)
+static inline void LoadVerts4(const ImDrawVert* vert, float32x4_t* out_pos01, float32x4_t* out_pos23, uint32x4_t* out_col)
+{
+	const float* f = (const float*)(const void*)vert;
+	const float32x4_t v0 = vld1q_f32(f), v1 = vld1q_f32(f + 4), v2 = vld1q_f32(f + 8), v3 = vld1q_f32(f + 12), v4 = vld1q_f32(f + 16);
+	*out_pos01 = vcombine_f32(vget_low_f32(v0), vget_low_f32(vextq_f32(v1, v1, 1)));
+	*out_pos23 = vcombine_f32(vget_high_f32(v2), vget_low_f32(vextq_f32(v3, v4, 3)));
+	if (out_col)
+	{
+		uint32x4_t col = vreinterpretq_u32_f32(v1);
+		col = vsetq_lane_u32(vgetq_lane_u32(vreinterpretq_u32_f32(v2), 1), col, 1);
+		col = vsetq_lane_u32(vgetq_lane_u32(vreinterpretq_u32_f32(v3), 2), col, 2);
+		col = vsetq_lane_u32(vgetq_lane_u32(vreinterpretq_u32_f32(v4), 3), col, 3);
+		*out_col = col;
+	}
+}
+
+static inline void StoreVertsPos4(ImDrawVert* vert, float32x4_t pos01, float32x4_t pos23)
+{
+	vst1_f32(&vert[0].pos.x, vget_low_f32(pos01));
+	vst1_f32(&vert[1].pos.x, vget_high_f32(pos01));
+	vst1_f32(&vert[2].pos.x, vget_low_f32(pos23));
+	vst1_f32(&vert[3].pos.x, vget_high_f32(pos23));
+}
+
+static inline void StoreVertsCol4(ImDrawVert* vert, uint32x4_t col)
+{
+	vst1q_lane_u32(&vert[0].col, col, 0);
+	vst1q_lane_u32(&vert[1].col, col, 1);
+	vst1q_lane_u32(&vert[2].col, col, 2);
+	vst1q_lane_u32(&vert[3].col, col, 3);
+}
+
+static inline void AddVertsBounds(ImRect* bounds, float32x4_t acc_min, float32x4_t acc_max)
+{
+	const float32x2_t v_min = vminnm_f32(vget_low_f32(acc_min), vget_high_f32(acc_min));
+	const float32x2_t v_max = vmaxnm_f32(vget_low_f32(acc_max), vget_high_f32(acc_max));
+	bounds->Add(ImRect(vget_lane_f32(v_min, 0), vget_lane_f32(v_min, 1), vget_lane_f32(v_max, 0), vget_lane_f32(v_max, 1)));
+}
+#endif
+
+// Add 'delta' to the positions of vertices [vert, vert_end)
+static void TranslateVerts(ImDrawVert* vert, ImDrawVert* vert_end, const ImVec2& delta)
+{
+#if defined(IMEXT_VERTS_SSE)
+	const __m128 d = _mm_setr_ps(delta.x, delta.y, delta.x, delta.y);
+	for (; vert_end - vert >= 4; vert += 4)
+	{
+		__m128 pos01, pos23;
+		LoadVerts4(vert, &pos01, &pos23, NULL);
+		StoreVertsPos4(vert, _mm_add_ps(pos01, d), _mm_add_ps(pos23, d));
+	}
+#elif defined(IMEXT_VERTS_NEON)
+	const float32x2_t d2 = vld1_f32(&delta.x);
+	const float32x4_t d = vcombine_f32(d2, d2);
+	for (; vert_end - vert >= 4; vert += 4)
+	{
+		float32x4_t pos01, pos23;
+		LoadVerts4(vert, &pos01, &pos23, NULL);
+		StoreVertsPos4(vert, vaddq_f32(pos01, d), vaddq_f32(pos23, d));
+	}
+#endif
+	for (; vert < vert_end; vert++)
+		vert->pos = ImVec2(vert->pos.x + delta.x, vert->pos.y + delta.y);
+}
+
+// Copy 'count' vertices from 'src' to 'dst' with 'col' OR'ed into their colours. 4 vertices are copied as 5 registers,
+// the colour lanes are OR'ed with 'col' on the way.
+static void CopyVertsOrColor(ImDrawVert* dst, const ImDrawVert* src, int count, ImU32 col)
+{
+	const ImDrawVert* src_end = src + count;
+#if defined(IMEXT_VERTS_SSE)
+	const __m128i c = _mm_cvtsi32_si128((int)col);
+	const __m128 c1 = _mm_castsi128_ps(c), c2 = _mm_castsi128_ps(_mm_slli_si128(c, 4)), c3 = _mm_castsi128_ps(_mm_slli_si128(c, 8)), c4 = _mm_castsi128_ps(_mm_slli_si128(c, 12));
+	for (; src_end - src >= 4; src += 4, dst += 4)
+	{
+		const float* s = (const float*)(const void*)src;
+		float* d = (float*)(void*)dst;
+		_mm_storeu_ps(d, _mm_loadu_ps(s));
+		_mm_storeu_ps(d + 4, _mm_or_ps(_mm_loadu_ps(s + 4), c1));
+		_mm_storeu_ps(d + 8, _mm_or_ps(_mm_loadu_ps(s + 8), c2));
+		_mm_storeu_ps(d + 12, _mm_or_ps(_mm_loadu_ps(s + 12), c3));
+		_mm_storeu_ps(d + 16, _mm_or_ps(_mm_loadu_ps(s + 16), c4));
+	}
+#elif defined(IMEXT_VERTS_NEON)
+	const uint32x4_t zero = vdupq_n_u32(0);
+	const uint32x4_t c1 = vsetq_lane_u32(col, zero, 0), c2 = vsetq_lane_u32(col, zero, 1), c3 = vsetq_lane_u32(col, zero, 2), c4 = vsetq_lane_u32(col, zero, 3);
+	for (; src_end - src >= 4; src += 4, dst += 4)
+	{
+		const uint32_t* s = (const uint32_t*)(const void*)src;
+		uint32_t* d = (uint32_t*)(void*)dst;
+		vst1q_u32(d, vld1q_u32(s));
+		vst1q_u32(d + 4, vorrq_u32(vld1q_u32(s + 4), c1));
+		vst1q_u32(d + 8, vorrq_u32(vld1q_u32(s + 8), c2));
+		vst1q_u32(d + 12, vorrq_u32(vld1q_u32(s + 12), c3));
+		vst1q_u32(d + 16, vorrq_u32(vld1q_u32(s + 16), c4));
+	}
+#endif
+	for (; src < src_end; src++, dst++)
+	{
+		*dst = *src;
+		dst->col = col | src->col;
+	}
+}
+#pragma endregion
+
+#pragma region Opacity
+// Multiply the alpha of vertices [vtx_start, vtx_end), like ImGui::ShadeVertsLinearColorGradientKeepAlpha() it is a single pass over the range:
+// 4 vertices at a time with SSE2 or NEON, then one at a time. Return the bounds of the range.
+static ImRect ShadeVertsMultiplyAlpha(ImDrawList* draw_list, int vtx_start, int vtx_end, float alpha)
+{
+	const ImU32 alpha_mul = (ImU32)(ImSaturate(alpha) * 256.0f); // 8.8 fixed point, 256 leaves the alpha as is
+	ImRect bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+	ImDrawVert* vert = draw_list->VtxBuffer.Data + vtx_start;
+	ImDrawVert* vert_end = draw_list->VtxBuffer.Data + vtx_end;
+#if defined(IMEXT_VERTS_SSE)
+	// The products are at most 255 * 256, so the 16 bits multiply of SSE2 gives them in full
+	const __m128i mul = _mm_set1_epi32((int)alpha_mul);
+	const __m128i byte_mask = _mm_set1_epi32(0xFF);
+	const __m128i rgb_mask = _mm_set1_epi32((int)~IM_COL32_A_MASK);
+	__m128 acc_min = _mm_set1_ps(FLT_MAX), acc_max = _mm_set1_ps(-FLT_MAX);
+	for (; vert_end - vert >= 4; vert += 4)
+	{
+		__m128 pos01, pos23;
+		__m128i col;
+		LoadVerts4(vert, &pos01, &pos23, &col);
+		const __m128i a = _mm_srli_epi32(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi32(col, IM_COL32_A_SHIFT), byte_mask), mul), 8);
+		StoreVertsCol4(vert, _mm_or_si128(_mm_and_si128(col, rgb_mask), _mm_slli_epi32(a, IM_COL32_A_SHIFT)));
+		acc_min = _mm_min_ps(pos01, _mm_min_ps(pos23, acc_min));
+		acc_max = _mm_max_ps(pos01, _mm_max_ps(pos23, acc_max));
+	}
+	AddVertsBounds(&bounds, acc_min, acc_max);
+#elif defined(IMEXT_VERTS_NEON)
+	const uint32x4_t mul = vdupq_n_u32(alpha_mul);
+	const uint32x4_t byte_mask = vdupq_n_u32(0xFF);
+	const uint32x4_t a_mask = vdupq_n_u32(IM_COL32_A_MASK);
+	float32x4_t acc_min = vdupq_n_f32(FLT_MAX), acc_max = vdupq_n_f32(-FLT_MAX);
+	for (; vert_end - vert >= 4; vert += 4)
+	{
+		float32x4_t pos01, pos23;
+		uint32x4_t col;
+		LoadVerts4(vert, &pos01, &pos23, &col);
+		const uint32x4_t a = vshrq_n_u32(vmulq_u32(vandq_u32(vshrq_n_u32(col, IM_COL32_A_SHIFT), byte_mask), mul), 8);
+		StoreVertsCol4(vert, vbslq_u32(a_mask, vshlq_n_u32(a, IM_COL32_A_SHIFT), col));
+		acc_min = vminnmq_f32(pos01, vminnmq_f32(pos23, acc_min));
+		acc_max = vmaxnmq_f32(pos01, vmaxnmq_f32(pos23, acc_max));
+	}
+	AddVertsBounds(&bounds, acc_min, acc_max);
+#endif
+	for (; vert < vert_end; vert++)
+	{
+		const ImU32 a = (((vert->col >> IM_COL32_A_SHIFT) & 0xFF) * alpha_mul) >> 8;
+		vert->col = (vert->col & ~IM_COL32_A_MASK) | (a << IM_COL32_A_SHIFT);
+		bounds.Add(vert->pos);
+	}
+	return bounds;
+}
+
+static ImU32 HashAlpha(float alpha)
+{
+	return (alpha >= 1.0f) ? 0 : ImHashData(&alpha, sizeof(alpha));
+}
+
+// Groups are identified by their submission order in their ID scope
+static ImGuiID GetGroupId(ImExtContext& e)
+{
+	const ImGuiID scope_id = GImGui->CurrentWindow->IDStack.back();
+	const int group_n = (*e.GroupCounts.GetIntRef(scope_id, 0))++;
+	return ImHashData(&group_n, sizeof(group_n), scope_id);
+}
+
+// Damage the previous and current areas of a group when its alpha or transform changed since it was last drawn
+static void AddGroupDamage(ImExtContext& e, ImGuiID id, ImU32 hash, const ImRect& bounds)
+{
+	ImExtGroupDamage* d = e.GroupDamage.GetOrAddByKey(id);
+	const bool changed = (d->LastFrame == -1) ? (hash != 0) : (d->Hash != hash);
+	if (changed && d->LastFrame != -1)
+		AddDamageRect(e, d->Bounds);
+	if (changed)
+		AddDamageRect(e, bounds);
+	d->Hash = hash;
+	d->Bounds = bounds;
+	d->LastFrame = GImGui->FrameCount;
+}
+
+void ImExt::PushGroupAlpha(float alpha)
+{
+	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
+	ImDrawList* draw_list = g.CurrentWindow->DrawList;
+	ImExtGroupAlpha group;
+	group.Id = GetGroupId(e);
+	group.DrawList = draw_list;
+	group.VtxStart = draw_list->VtxBuffer.Size;
+	group.Channel = draw_list->_Splitter._Current;
+	group.Alpha = ImSaturate(alpha);
+	e.GroupAlphaStack.push_back(group);
+}
+
+void ImExt::PopGroupAlpha()
+{
+	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
+	IM_ASSERT(e.GroupAlphaStack.Size > 0 && "Mismatched PushGroupAlpha()/PopGroupAlpha()");
+	const ImExtGroupAlpha group = e.GroupAlphaStack.back();
+	e.GroupAlphaStack.pop_back();
+	IM_ASSERT(group.DrawList == g.CurrentWindow->DrawList && "PopGroupAlpha() called in another window than PushGroupAlpha()");
+	IM_ASSERT(group.Channel == group.DrawList->_Splitter._Current && "PopGroupAlpha() called in another draw list channel than PushGroupAlpha()");
+
+	const bool track_damage = (e.IO.ConfigFlags & ImExtConfigFlags_DamageTracking) != 0;
+	if (group.Alpha >= 1.0f && !track_damage)
+		return;
+	const ImRect bounds = ShadeVertsMultiplyAlpha(group.DrawList, group.VtxStart, group.DrawList->VtxBuffer.Size, group.Alpha);
+	if (track_damage)
+		AddGroupDamage(e, group.Id, HashAlpha(group.Alpha), bounds);
+}
+
+void ImExt::SetWindowAlpha(float alpha)
+{
+	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
+	ImExtWindowAlpha window_alpha;
+	window_alpha.Window = g.CurrentWindow;
+	window_alpha.Alpha = ImSaturate(alpha);
+	e.WindowAlphas.push_back(window_alpha);
+}
+
+static void ShadeWindowMultiplyAlpha(ImExtContext& e, ImGuiWindow* window, ImGuiID id, float alpha)
+{
+	if (!window->Active || window->Hidden)
+		return;
+	const ImRect bounds = ShadeVertsMultiplyAlpha(window->DrawList, 0, window->DrawList->VtxBuffer.Size, alpha);
+	if (e.IO.ConfigFlags & ImExtConfigFlags_DamageTracking)
+		AddGroupDamage(e, id, HashAlpha(alpha), bounds);
+	for (int n = 0; n < window->DC.ChildWindows.Size; n++)
+		ShadeWindowMultiplyAlpha(e, window->DC.ChildWindows[n], window->DC.ChildWindows[n]->ID, alpha);
+}
+
+// Windows are complete when ImGui::Render() starts, their draw lists are faded as a whole
+static void ApplyWindowAlphas(ImExtContext& e)
+{
+	IM_ASSERT(e.GroupAlphaStack.Size == 0 && "Missing PopGroupAlpha()");
+	IM_ASSERT(e.GroupTransformStack.Size == 0 && "Missing PopTransform()");
+	for (int n = 0; n < e.WindowAlphas.Size; n++)
+		ShadeWindowMultiplyAlpha(e, e.WindowAlphas[n].Window, e.WindowAlphas[n].Window->ID, e.WindowAlphas[n].Alpha);
+	e.WindowAlphas.resize(0);
+}
+#pragma endregion
+
+#pragma region Transform
+// Apply an affine transform to vertices [vtx_start, vtx_end) in a single pass, return the bounds of the transformed range.
+// With SSE2 or NEON the positions of 4 vertices are split into x and y registers, transformed, then interleaved back.
+static ImRect ShadeVertsTransform(ImDrawList* draw_list, int vtx_start, int vtx_end, const float m[6])
+{
+	ImRect bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+	ImDrawVert* vert = draw_list->VtxBuffer.Data + vtx_start;
+	ImDrawVert* vert_end = draw_list->VtxBuffer.Data + vtx_end;
+#if defined(IMEXT_VERTS_SSE)
+	const __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]);
+	const __m128 m3 = _mm_set1_ps(m[3]), m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]);
+	__m128 acc_min = _mm_set1_ps(FLT_MAX), acc_max = _mm_set1_ps(-FLT_MAX);
+	for (; vert_end - vert >= 4; vert += 4)
+	{
+		__m128 pos01, pos23;
+		LoadVerts4(vert, &pos01, &pos23, NULL);
+		const __m128 x = _mm_shuffle_ps(pos01, pos23, _MM_SHUFFLE(2, 0, 2, 0));
+		const __m128 y = _mm_shuffle_ps(pos01, pos23, _MM_SHUFFLE(3, 1, 3, 1));
+		const __m128 tx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m1, y)), m2);
+		const __m128 ty = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m3, x), _mm_mul_ps(m4, y)), m5);
+		pos01 = _mm_unpacklo_ps(tx, ty);
+		pos23 = _mm_unpackhi_ps(tx, ty);
+		StoreVertsPos4(vert, pos01, pos23);
+		acc_min = _mm_min_ps(pos01, _mm_min_ps(pos23, acc_min));
+		acc_max = _mm_max_ps(pos01, _mm_max_ps(pos23, acc_max));
+	}
+	AddVertsBounds(&bounds, acc_min, acc_max);
+#elif defined(IMEXT_VERTS_NEON)
+	const float32x4_t m2 = vdupq_n_f32(m[2]), m5 = vdupq_n_f32(m[5]);
+	float32x4_t acc_min = vdupq_n_f32(FLT_MAX), acc_max = vdupq_n_f32(-FLT_MAX);
+	for (; vert_end - vert >= 4; vert += 4)
+	{
+		float32x4_t pos01, pos23;
+		LoadVerts4(vert, &pos01, &pos23, NULL);
+		const float32x4x2_t xy = vuzpq_f32(pos01, pos23);
+		const float32x4_t tx = vaddq_f32(vaddq_f32(vmulq_n_f32(xy.val[0], m[0]), vmulq_n_f32(xy.val[1], m[1])), m2);
+		const float32x4_t ty = vaddq_f32(vaddq_f32(vmulq_n_f32(xy.val[0], m[3]), vmulq_n_f32(xy.val[1], m[4])), m5);
+		const float32x4x2_t t = vzipq_f32(tx, ty);
+		StoreVertsPos4(vert, t.val[0], t.val[1]);
+		acc_min = vminnmq_f32(t.val[0], vminnmq_f32(t.val[1], acc_min));
+		acc_max = vmaxnmq_f32(t.val[0], vmaxnmq_f32(t.val[1], acc_max));
+	}
+	AddVertsBounds(&bounds, acc_min, acc_max);
+#endif
+	for (; vert < vert_end; vert++)
+	{
+		const float x = vert->pos.x, y = vert->pos.y;
+		vert->pos.x = m[0] * x + m[1] * y + m[2];
+		vert->pos.y = m[3] * x + m[4] * y + m[5];
+		bounds.Add(vert->pos);
+	}
+	return bounds;
+}
+
+static ImRect CalcVertsBounds(ImDrawList* draw_list, int vtx_start, int vtx_end)
+{
+	ImRect bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+	for (int n = vtx_start; n < vtx_end; n++)
+		bounds.Add(draw_list->VtxBuffer.Data[n].pos);
+	return bounds;
+}
+
+void ImExt::PushTransform(const ImVec2& pivot, const ImVec2& scale, float rotation, const ImVec2& offset)
+{
+	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
+	ImDrawList* draw_list = g.CurrentWindow->DrawList;
+	ImExtGroupTransform group;
+	group.Id = GetGroupId(e);
+	group.DrawList = draw_list;
+	group.VtxStart = draw_list->VtxBuffer.Size;
+	group.Channel = draw_list->_Splitter._Current;
+
+	// p' = pivot + offset + R(rotation) * ((p - pivot) * scale)
+	const float c = (rotation != 0.0f) ? ImCos(rotation) : 1.0f;
+	const float s = (rotation != 0.0f) ? ImSin(rotation) : 0.0f;
+	float* m = group.Matrix;
+	m[0] = c * scale.x; m[1] = -s * scale.y;
+	m[3] = s * scale.x; m[4] = c * scale.y;
+	m[2] = pivot.x + offset.x - (m[0] * pivot.x + m[1] * pivot.y);
+	m[5] = pivot.y + offset.y - (m[3] * pivot.x + m[4] * pivot.y);
+	e.GroupTransformStack.push_back(group);
+}
+
+void ImExt::PopTransform()
+{
+	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
+	IM_ASSERT(e.GroupTransformStack.Size > 0 && "Mismatched PushTransform()/PopTransform()");
+	const ImExtGroupTransform group = e.GroupTransformStack.back();
+	e.GroupTransformStack.pop_back();
+	IM_ASSERT(group.DrawList == g.CurrentWindow->DrawList && "PopTransform() called in another window than PushTransform()");
+	IM_ASSERT(group.Channel == group.DrawList->_Splitter._Current && "PopTransform() called in another draw list channel than PushTransform()");
+
+	// Identity leaves the vertices untouched, bit for bit
+	const float* m = group.Matrix;
+	const bool identity = m[0] == 1.0f && m[1] == 0.0f && m[2] == 0.0f && m[3] == 0.0f && m[4] == 1.0f && m[5] == 0.0f;
+	const bool track_damage = (e.IO.ConfigFlags & ImExtConfigFlags_DamageTracking) != 0;
+	if (identity && !track_damage)
+		return;
+	const int vtx_end = group.DrawList->VtxBuffer.Size;
+	const ImRect bounds = identity ? CalcVertsBounds(group.DrawList, group.VtxStart, vtx_end) : ShadeVertsTransform(group.DrawList, group.VtxStart, vtx_end, m);
+	if (track_damage)
+		AddGroupDamage(e, group.Id, identity ? 0 : ImHashData(m, sizeof(group.Matrix)), bounds);
+}
+#pragma endregion
+
+#pragma region Tasks
+// Jobs of TaskButton() run on ImExtIO::TaskSubmitFn, by default on a process wide work-stealing pool: every worker owns
+// a fixed ring of pending jobs. Submissions are spread round-robin over the rings, a worker runs its own jobs newest first
+// then steals the oldest ones of the others before going to sleep. Rings never allocate, a full pool refuses the job.
+#define IMEXT_TASK_POOL_MAX_THREADS     32
+#define IMEXT_TASK_QUEUE_SIZE           64 // Pending jobs per worker
+
+struct ImExtTaskJob
+{
+	void (*Func)(void* arg);
+	void* Arg;
+};
+
+struct ImExtTaskQueue
+{
+	std::mutex Mutex;
+	ImExtTaskJob Jobs[IMEXT_TASK_QUEUE_SIZE];
+	int Head;
+	int Count;
+
+	ImExtTaskQueue() { Head = Count = 0; }
+};
+
+struct ImExtTaskPool
+{
+	ImExtTaskQueue Queues[IMEXT_TASK_POOL_MAX_THREADS];
+	int ThreadsCount;
+	std::atomic<int> NextQueue;
+	std::atomic<int> Pending;           // Jobs in the rings
+	std::mutex SleepMutex;
+	std::condition_variable SleepCond;
+	bool Stop;                          // Under SleepMutex: workers exit once the rings are empty
+	std::thread Threads[IMEXT_TASK_POOL_MAX_THREADS];
+
+	ImExtTaskPool() : NextQueue(0), Pending(0) { ThreadsCount = 0; Stop = false; }
+};
+
+static ImExtTaskPool* GImExtTaskPool = NULL; // Started on the first job, stopped with the last context or ShutdownTaskPool()
+
+enum ImExtTaskState_
+{
+	ImExtTaskState_Pending,             // Not accepted by the pool yet
+	ImExtTaskState_Queued,
+	ImExtTaskState_Running,
+	ImExtTaskState_Done,                // The worker no longer touches the task
+};
+
+struct ImExtTask
+{
+	ImExtTaskContext Context;           // Shared with the job
+	std::atomic<int> State;             // ImExtTaskState_, written by the worker once queued
+	ImExtTaskFunc Func;
+	ImGuiID Id;                         // TaskButton() ID
+	int LastFrame;
+	double StateTime;                   // g.Time when the job was submitted, then when its completion was seen
+	float Progress;                     // Displayed progress, eases toward Context.Progress
+	bool Finished;                      // Completion seen, the button animates back to idle
+
+	ImExtTask() : State(ImExtTaskState_Pending) { Func = NULL; Id = 0; LastFrame = -1; StateTime = 0.0; Progress = 0.0f; Finished = false; }
+};
+
+static bool TaskPoolPop(ImExtTaskPool* pool, int worker, ImExtTaskJob* out_job)
+{
+	for (int n = 0; n < pool->ThreadsCount; n++)
+	{
+		ImExtTaskQueue& queue = pool->Queues[(worker + n) % pool->ThreadsCount];
+		std::lock_guard<std::mutex> lock(queue.Mutex);
+		if (queue.Count == 0)
+			continue;
+		if (n == 0)
+		{
+			*out_job = queue.Jobs[(queue.Head + queue.Count - 1) % IMEXT_TASK_QUEUE_SIZE];
+		}
+		else
+		{
+			*out_job = queue.Jobs[queue.Head];
+			queue.Head = (queue.Head + 1) % IMEXT_TASK_QUEUE_SIZE;
+		}
+		queue.Count--;
+		return true;
+	}
+	return false;
+}
+
+static void TaskPoolWorker(ImExtTaskPool* pool, int worker)
+{
+	for (;;)
+	{
+		ImExtTaskJob job;
+		if (TaskPoolPop(pool, worker, &job))
+		{
+			pool->Pending--;
+			job.Func(job.Arg);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(pool->SleepMutex);
+		if (pool->Stop && pool->Pending.load() == 0)
+			return;
+		pool->SleepCond.wait(lock, [pool]() { return pool->Pending.load() > 0 || pool->Stop; });
+	}
+}
+
+static bool TaskPoolSubmit(void (*func)(void* arg), void* arg, void* user_data)
+{
+	ImExtTaskPool* pool = (ImExtTaskPool*)user_data;
+	for (int n = 0; n < pool->ThreadsCount; n++)
+	{
+		ImExtTaskQueue& queue = pool->Queues[pool->NextQueue++ % pool->ThreadsCount];
+		{
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			if (queue.Count == IMEXT_TASK_QUEUE_SIZE)
+				continue;
+			ImExtTaskJob& job = queue.Jobs[(queue.Head + queue.Count) % IMEXT_TASK_QUEUE_SIZE];
+			job.Func = func;
+			job.Arg = arg;
+			queue.Count++;
+		}
+		{
+			std::lock_guard<std::mutex> lock(pool->SleepMutex); // No wake-up lost between a worker testing Pending and sleeping
+			pool->Pending++;
+		}
+		pool->SleepCond.notify_one();
+		return true;
+	}
+	return false;
+}
+
+static void TaskRun(void* arg)
+{
+	ImExtTask* task = (ImExtTask*)arg;
+	task->State.store(ImExtTaskState_Running, std::memory_order_relaxed);
+	task->Func(&task->Context);
+	task->State.store(ImExtTaskState_Done, std::memory_order_release); // Last access of the worker
+}
+
+// Run func(arg) on ImExtIO::TaskSubmitFn, or on the default pool started by the first job. Return false when refused.
+static bool SubmitJob(ImExtContext& e, void (*func)(void* arg), void* arg)
+{
+	if (e.IO.TaskSubmitFn == NULL && GImExtTaskPool == NULL)
+	{
+		const int threads_count = (e.IO.TaskThreadsCount > 0) ? e.IO.TaskThreadsCount : (int)std::thread::hardware_concurrency() - 1;
+		GImExtTaskPool = IM_NEW(ImExtTaskPool)();
+		GImExtTaskPool->ThreadsCount = ImClamp(threads_count, 1, IMEXT_TASK_POOL_MAX_THREADS);
+		for (int n = 0; n < GImExtTaskPool->ThreadsCount; n++)
+			GImExtTaskPool->Threads[n] = std::thread(TaskPoolWorker, GImExtTaskPool, n);
+	}
+	return e.IO.TaskSubmitFn ? e.IO.TaskSubmitFn(func, arg, e.IO.TaskSubmitUserData) : TaskPoolSubmit(func, arg, GImExtTaskPool);
+}
+
+// Queued jobs still run: the workers exit once the rings are empty
+void ImExt::ShutdownTaskPool()
+{
+	ImExtTaskPool* pool = GImExtTaskPool;
+	if (pool == NULL)
+		return;
+	{
+		std::lock_guard<std::mutex> lock(pool->SleepMutex);
+		pool->Stop = true;
+	}
+	pool->SleepCond.notify_all();
+	for (int n = 0; n < pool->ThreadsCount; n++)
+		pool->Threads[n].join();
+	GImExtTaskPool = NULL;
+	IM_DELETE(pool);
+}
+
+static bool SubmitTask(ImExtContext& e, ImExtTask* task)
+{
+	task->State.store(ImExtTaskState_Queued, std::memory_order_relaxed); // Before the worker may set it to running
+	const bool accepted = SubmitJob(e, TaskRun, task);
+	if (!accepted)
+		task->State.store(ImExtTaskState_Pending, std::memory_order_relaxed);
+	return accepted;
+}
+
+static ImExtTask* FindTask(ImExtContext& e, ImGuiID id)
+{
+	for (int n = 0; n < e.Tasks.Size; n++)
+		if (e.Tasks[n]->Id == id)
+			return e.Tasks[n];
+	return NULL;
+}
+
+// Jobs whose button went away are cancelled, and released once their worker is done with them
+static void UpdateTasks(ImExtContext& e)
+{
+	ImGuiContext& g = *e.Ctx;
+	for (int n = 0; n < e.Tasks.Size; n++)
+	{
+		ImExtTask* task = e.Tasks[n];
+		if (task->LastFrame >= g.FrameCount - 1)
+			continue;
+		task->Context.CancelRequested.store(true, std::memory_order_relaxed);
+		const int state = task->State.load(std::memory_order_acquire);
+		if (state == ImExtTaskState_Pending || state == ImExtTaskState_Done)
+		{
+			e.Tasks.erase(e.Tasks.Data + n--);
+			e.FreeTasks.push_back(task);
+		}
+	}
+}
+
+// A task is only recycled once no worker refers to it anymore (Pending or Done)
+static ImExtTask* NewTask(ImExtContext& e, ImGuiID id)
+{
+	ImExtTask* task;
+	if (e.FreeTasks.Size > 0)
+	{
+		task = e.FreeTasks.back();
+		e.FreeTasks.pop_back();
+		task->~ImExtTask();
+		IM_PLACEMENT_NEW(task) ImExtTask();
+	}
+	else
+	{
+		task = IM_NEW(ImExtTask)();
+	}
+	task->Id = id;
+	e.Tasks.push_back(task);
+	return task;
+}
+
+// Per frame update of a submitted job by its button: hand it to the pool once it accepts it, notice its completion.
+// Return true on the frame it completed without being cancelled.
+static bool UpdateTask(ImExtContext& e, ImExtTask* task)
+{
+	ImGuiContext& g = *e.Ctx;
+	task->LastFrame = g.FrameCount;
+	if (task->State.load(std::memory_order_relaxed) == ImExtTaskState_Pending)
+	{
+		if (task->Context.CancelRequested.load(std::memory_order_relaxed))
+			task->State.store(ImExtTaskState_Done, std::memory_order_relaxed);
+		else
+			SubmitTask(e, task);
+	}
+	if (task->Finished || task->State.load(std::memory_order_acquire) != ImExtTaskState_Done)
+		return false;
+	task->Finished = true;
+	task->StateTime = g.Time;
+	return !task->Context.CancelRequested.load(std::memory_order_relaxed);
+}
+
+// Destroying the context waits for the jobs still queued or running, after requesting their cancellation
+static void ShutdownTasks(ImExtContext& e)
+{
+	for (int n = 0; n < e.Tasks.Size; n++)
+		e.Tasks[n]->Context.CancelRequested.store(true, std::memory_order_relaxed);
+	for (int n = 0; n < e.Tasks.Size; n++)
+	{
+		ImExtTask* task = e.Tasks[n];
+		while (task->State.load(std::memory_order_acquire) == ImExtTaskState_Queued || task->State.load(std::memory_order_acquire) == ImExtTaskState_Running)
+			std::this_thread::yield();
+		IM_DELETE(task);
+	}
+	e.Tasks.clear();
+	for (int n = 0; n < e.FreeTasks.Size; n++)
+		IM_DELETE(e.FreeTasks[n]);
+	e.FreeTasks.clear();
+}
+#pragma endregion
+
+#pragma region Sparkline
+// Samples are published per slot like a seqlock: a producer reserves an index from Head, clears the slot stamp, writes the
+// value, then stamps the slot with the index. The reader keeps a value only when it read the expected stamp before and after it.
+
+static inline ImU32 SparklineStamp(ImU64 index)
+{
+	return (ImU32)(index % 0xFFFFFFFFu) + 1; // Never 0, which marks a slot being written
+}
+
+ImExtSparklineBuffer::ImExtSparklineBuffer(int capacity) : Head(0)
+{
+	IM_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0 && "Capacity must be a power of two");
+	Capacity = capacity;
+	Values = (std::atomic<float>*)IM_ALLOC(sizeof(std::atomic<float>) * (size_t)capacity);
+	Stamps = (std::atomic<ImU32>*)IM_ALLOC(sizeof(std::atomic<ImU32>) * (size_t)capacity);
+	for (int n = 0; n < capacity; n++)
+	{
+		IM_PLACEMENT_NEW(&Values[n]) std::atomic<float>(0.0f);
+		IM_PLACEMENT_NEW(&Stamps[n]) std::atomic<ImU32>(0u);
+	}
+}
+
+ImExtSparklineBuffer::~ImExtSparklineBuffer()
+{
+	IM_FREE(Values);
+	IM_FREE(Stamps);
+}
+
+void ImExtSparklineBuffer::Push(float value)
+{
+	Push(&value, 1);
+}
+
+void ImExtSparklineBuffer::Push(const float* values, int count)
+{
+	if (count <= 0)
+		return;
+	ImU64 index = Head.fetch_add((ImU64)count, std::memory_order_relaxed);
+	if (count > Capacity) // Only the last samples fit
+	{
+		index += (ImU64)(count - Capacity);
+		values += count - Capacity;
+		count = Capacity;
+	}
+	const ImU64 mask = (ImU64)Capacity - 1;
+	for (int n = 0; n < count; n++, index++)
+	{
+		const int slot = (int)(index & mask);
+		Stamps[slot].store(0u, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		Values[slot].store(values[n], std::memory_order_relaxed);
+		Stamps[slot].store(SparklineStamp(index), std::memory_order_release);
+	}
+}
+
+// Copy the samples of [index, index + count) to 'out', skipping the slots whose stamp isn't the one of their index:
+// still being written, reserved but not written yet, or already overwritten. Return the number copied.
+static int ReadSparklineSamples(const ImExtSparklineBuffer& buffer, ImU64 index, int count, float* out)
+{
+	const ImU64 mask = (ImU64)buffer.Capacity - 1;
+	int read = 0;
+	for (int n = 0; n < count; n++, index++)
+	{
+		const int slot = (int)(index & mask);
+		const ImU32 stamp = SparklineStamp(index);
+		if (buffer.Stamps[slot].load(std::memory_order_acquire) != stamp)
+			continue;
+		out[read] = buffer.Values[slot].load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (buffer.Stamps[slot].load(std::memory_order_relaxed) == stamp) // Not overwritten meanwhile
+			read++;
+	}
+	return read;
+}
+
+// Min and max of 'values', NaNs ignored: the SIMD min/max return their second operand, the accumulator, when one is NaN.
+// Leave 'out_min' > 'out_max' when there is no number.
+static void ComputeMinMax(const float* values, int count, float* out_min, float* out_max)
+{
+	float v_min = FLT_MAX, v_max = -FLT_MAX;
+	int n = 0;
+#ifdef __AVX__
+	if (count >= 16)
+	{
+		__m256 acc_min = _mm256_set1_ps(FLT_MAX), acc_max = _mm256_set1_ps(-FLT_MAX);
+		for (; n + 8 <= count; n += 8)
+		{
+			const __m256 v = _mm256_loadu_ps(values + n);
+			acc_min = _mm256_min_ps(v, acc_min);
+			acc_max = _mm256_max_ps(v, acc_max);
+		}
+		__m128 lo_min = _mm_min_ps(_mm256_castps256_ps128(acc_min), _mm256_extractf128_ps(acc_min, 1));
+		__m128 lo_max = _mm_max_ps(_mm256_castps256_ps128(acc_max), _mm256_extractf128_ps(acc_max, 1));
+		lo_min = _mm_min_ps(lo_min, _mm_movehl_ps(lo_min, lo_min));
+		lo_max = _mm_max_ps(lo_max, _mm_movehl_ps(lo_max, lo_max));
+		v_min = _mm_cvtss_f32(_mm_min_ss(lo_min, _mm_shuffle_ps(lo_min, lo_min, 1)));
+		v_max = _mm_cvtss_f32(_mm_max_ss(lo_max, _mm_shuffle_ps(lo_max, lo_max, 1)));
+	}
+#elif defined(IMGUI_ENABLE_SSE)
+	if (count >= 8)
+	{
+		__m128 acc_min = _mm_set1_ps(FLT_MAX), acc_max = _mm_set1_ps(-FLT_MAX);
+		for (; n + 4 <= count; n += 4)
+		{
+			const __m128 v = _mm_loadu_ps(values + n);
+			acc_min = _mm_min_ps(v, acc_min);
+			acc_max = _mm_max_ps(v, acc_max);
+		}
+		acc_min = _mm_min_ps(acc_min, _mm_movehl_ps(acc_min, acc_min));
+		acc_max = _mm_max_ps(acc_max, _mm_movehl_ps(acc_max, acc_max));
+		v_min = _mm_cvtss_f32(_mm_min_ss(acc_min, _mm_shuffle_ps(acc_min, acc_min, 1)));
+		v_max = _mm_cvtss_f32(_mm_max_ss(acc_max, _mm_shuffle_ps(acc_max, acc_max, 1)));
+	}
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+	if (count >= 8)
+	{
+		float32x4_t acc_min = vdupq_n_f32(FLT_MAX), acc_max = vdupq_n_f32(-FLT_MAX);
+		for (; n + 4 <= count; n += 4)
+		{
+			const float32x4_t v = vld1q_f32(values + n);
+			acc_min = vminnmq_f32(v, acc_min); // Number of the two when one is NaN
+			acc_max = vmaxnmq_f32(v, acc_max);
+		}
+		v_min = vminnmvq_f32(acc_min);
+		v_max = vmaxnmvq_f32(acc_max);
+	}
+#endif
+	for (; n < count; n++)
+	{
+		const float v = values[n];
+		if (v < v_min)
+			v_min = v;
+		if (v > v_max)
+			v_max = v;
+	}
+	*out_min = v_min;
+	*out_max = v_max;
+}
+
+// Fold the samples pushed since the previous frame into the columns
+static void DecimateSparkline(ImExtContext& e, ImExtSparklineState* state, const ImExtSparklineBuffer& buffer)
+{
+	const ImU64 head = buffer.Head.load(std::memory_order_relaxed);
+	const ImU64 spc = (ImU64)state->SamplesPerColumn;
+	const int ring = state->ColumnMin.Size;
+
+	// Samples overwritten in the buffer, or older than the ring of columns, are skipped: start over with empty columns
+	ImU64 start = state->Decimated;
+	ImU64 oldest = (head > (ImU64)buffer.Capacity) ? head - (ImU64)buffer.Capacity : 0;
+	if (head / spc >= (ImU64)ring)
+		oldest = ImMax(oldest, (head / spc - (ImU64)ring + 1) * spc);
+	if (start < oldest)
+	{
+		start = oldest;
+		for (int n = 0; n < ring; n++)
+		{
+			state->ColumnMin[n] = FLT_MAX;
+			state->ColumnMax[n] = -FLT_MAX;
+		}
+	}
+
+	// One column at a time. Samples not published by now are skipped, so a producer stalled between reserving its index and
+	// writing the slot doesn't hold back the samples pushed after it.
+	ImU64 index = start;
+	while (index < head)
+	{
+		const ImU64 column = index / spc;
+		const int count = (int)(ImMin((column + 1) * spc, head) - index);
+		if (e.SparklineSamples.Size < count)
+			e.SparklineSamples.resize(count);
+		const int read = ReadSparklineSamples(buffer, index, count, e.SparklineSamples.Data);
+		const int slot = (int)(column % (ImU64)ring);
+		if (index % spc == 0)
+		{
+			state->ColumnMin[slot] = FLT_MAX;
+			state->ColumnMax[slot] = -FLT_MAX;
+		}
+		float v_min, v_max;
+		ComputeMinMax(e.SparklineSamples.Data, read, &v_min, &v_max);
+		state->ColumnMin[slot] = ImMin(state->ColumnMin[slot], v_min);
+		state->ColumnMax[slot] = ImMax(state->ColumnMax[slot], v_max);
+		index += (ImU64)count;
+	}
+	state->Decimated = index;
+}
+#pragma endregion
+
+#pragma region Plot
+void ImExtPlotSeries::Append(float value)
+{
+	Append(&value, 1);
+}
+
+void ImExtPlotSeries::Append(const float* values, int count)
+{
+	if (count <= 0)
+		return;
+	const int start = Values.Size;
+	Values.resize(start + count);
+	memcpy(Values.Data + start, values, (size_t)count * sizeof(float));
+
+	// Refresh the blocks holding new values, each level from the one below
+	int first = start, end = Values.Size;
+	for (int n = 0; n < IMEXT_PLOT_SERIES_LEVELS; n++)
+	{
+		const int below_size = end;
+		first >>= 3;
+		end = (end + 7) >> 3;
+		ImVector<ImVec2>& level = Levels[n];
+		if (level.Size < end)
+			level.resize(end);
+		for (int block = first; block < end; block++)
+		{
+			const int b0 = block << 3, b1 = ImMin(b0 + 8, below_size);
+			float v_min = FLT_MAX, v_max = -FLT_MAX;
+			if (n == 0)
+			{
+				ComputeMinMax(Values.Data + b0, b1 - b0, &v_min, &v_max);
+			}
+			else
+			{
+				for (const ImVec2* p = Levels[n - 1].Data + b0; p < Levels[n - 1].Data + b1; p++)
+				{
+					v_min = ImMin(v_min, p->x);
+					v_max = ImMax(v_max, p->y);
+				}
+			}
+			level[block] = ImVec2(v_min, v_max);
+		}
+	}
+}
+
+void ImExtPlotSeries::Clear()
+{
+	Values.clear();
+	for (int n = 0; n < IMEXT_PLOT_SERIES_LEVELS; n++)
+		Levels[n].clear();
+}
+
+// Min and max of values [i0, i1) from pyramid level 'level' (-1: the values themselves). Blocks straddling the range count whole.
+static void PlotSeriesMinMax(const ImExtPlotSeries& series, int level, int i0, int i1, float* out_min, float* out_max)
+{
+	if (level < 0)
+	{
+		ComputeMinMax(series.Values.Data + i0, i1 - i0, out_min, out_max);
+		return;
+	}
+	const int shift = 3 * (level + 1);
+	const ImVector<ImVec2>& blocks = series.Levels[level];
+	const int b0 = i0 >> shift, b1 = ImMin(((i1 - 1) >> shift) + 1, blocks.Size);
+	float v_min = FLT_MAX, v_max = -FLT_MAX;
+	for (int b = b0; b < b1; b++)
+	{
+		v_min = ImMin(v_min, blocks.Data[b].x);
+		v_max = ImMax(v_max, blocks.Data[b].y);
+	}
+	*out_min = v_min;
+	*out_max = v_max;
+}
+#pragma endregion
+
+#pragma region LogFile
+// A log file is mapped whole and remapped as it grows: readers keep a reference on the mapping they read, so a frame or a
+// filter job never sees it unmapped. The indexer thread records the offset of every IMEXT_LOG_INDEX_STRIDE-th line, a
+// line is found from the closest one with memchr(). Filters run as jobs of the task pool over chunks of lines.
+// Memory read or written off the main thread comes from malloc() or new: ImGui allocator counters aren't synchronized.
+// A file truncated while open (copytruncate log rotation) is noticed from its size, by the view every frame and by the
+// indexer at each step, and indexed again from its start.
+
+#define IMEXT_LOG_INDEX_STRIDE          64          // Lines between two indexed line offsets
+#define IMEXT_LOG_INDEX_STEP            (4 << 20)   // Bytes scanned by the indexer between two publications
+#define IMEXT_LOG_POLL_INTERVAL         100         // Milliseconds between two file size checks once indexed
+#define IMEXT_LOG_FILTER_CHUNK          (1 << 16)   // Lines per filter job
+#define IMEXT_LOG_MAX_LINE_LENGTH       4096        // Bytes of a line displayed and filtered
+#define IMEXT_LOG_FADE_DURATION         1.0f        // Seconds new lines stay highlighted
+#define IMEXT_LOG_GUARDED_MAPPINGS      64          // Mappings covered by the SIGBUS guard at once, outside Windows
+
+struct ImExtLogMapping
+{
+	const char* Data;
+	ImU64 Size;
+	std::atomic<int> RefCount;
+#ifdef _WIN32
+	HANDLE Handle;
+#endif
+
+	ImExtLogMapping() : RefCount(1) { Data = NULL; Size = 0; }
+};
+
+// Lines matched in [Begin, End), written by a worker
+struct ImExtLogFilterJob
+{
+	struct ImExtLogFilter* Filter;
+	ImExtLogMapping* Mapping;           // Referenced until the job is done
+	ImU64 Begin;                        // Offset of line FirstLine
+	ImU64 End;                          // Offset after the newline of the last line
+	int FirstLine;
+	int LinesCount;
+	int* Matches;                       // malloc()
+	int MatchesCount;
+	int MatchesCapacity;
+	std::atomic<int> State;             // ImExtTaskState_
+
+	ImExtLogFilterJob() : State(ImExtTaskState_Pending) { Filter = NULL; Mapping = NULL; Begin = End = 0; FirstLine = LinesCount = 0; Matches = NULL; MatchesCount = MatchesCapacity = 0; }
+};
+
+struct ImExtLogFilter
+{
+	ImVector<char> Pattern;             // Zero terminated
+	std::regex Regex;
+	bool IsRegex;                       // Pattern is a valid regular expression, otherwise matched as a substring ignoring case
+	std::atomic<bool> CancelRequested;
+	ImVector<ImExtLogFilterJob*> Jobs;  // Not merged into Matches yet, in line order
+	ImVector<int> Matches;              // Lines matched by the merged jobs, in order
+	int LinesCount;                     // Lines handed to jobs
+	int LinesDone;                      // Lines covered by Matches
+
+	ImExtLogFilter() : CancelRequested(false) { IsRegex = false; LinesCount = LinesDone = 0; }
+};
+
+// Lines from FirstLine appeared at Time, highlighted while they fade
+struct ImExtLogArrival
+{
+	int FirstLine;
+	double Time;
+};
+
+struct ImExtLogFileData
+{
+#ifdef _WIN32
+	HANDLE File;
+#else
+	int File;
+#endif
+	std::thread Indexer;
+
+	// Published by the indexer, under Mutex
+	std::mutex Mutex;
+	std::condition_variable WakeCond;
+	bool StopRequested;
+	ImExtLogMapping* Mapping;           // Latest mapping, referenced
+	ImU64* NewOffsets;                  // Indexed line offsets not taken by the view yet, malloc()
+	int NewOffsetsCount;
+	int NewOffsetsCapacity;
+	int LinesCount;                     // Newline terminated lines indexed
+	ImU64 IndexedEnd;                   // Offset after the last newline indexed
+	int Generation;                     // Incremented when the file shrank and indexing restarted
+	bool CaughtUp;                      // Indexed up to the end of the file since the last restart
+	bool RestartRequested;              // Set by the view when the mapping doesn't match the file anymore
+
+	// Main thread
+	ImExtLogMapping* ViewMapping;       // Mapping read by the current frame, referenced
+	ImVector<ImU64> LineOffsets;        // Offset of every IMEXT_LOG_INDEX_STRIDE-th line
+	int ViewLinesCount;
+	ImU64 ViewIndexedEnd;
+	int ViewGeneration;
+	bool ViewCaughtUp;
+	bool ViewStale;                     // The file changed under the mapping: nothing is read until the next generation
+	ImExtLogFilter* Filter;             // NULL: every line shown
+	ImVector<ImExtLogFilter*> RetiredFilters; // Cancelled, deleted once their jobs are done
+	ImVector<ImExtLogArrival> Arrivals;
+
+	ImExtLogFileData() { StopRequested = false; Mapping = NULL; NewOffsets = NULL; NewOffsetsCount = NewOffsetsCapacity = 0; LinesCount = 0; IndexedEnd = 0; Generation = 0; CaughtUp = false; RestartRequested = false; ViewMapping = NULL; ViewLinesCount = 0; ViewIndexedEnd = 0; ViewGeneration = 0; ViewCaughtUp = false; ViewStale = false; Filter = NULL; }
+};
+
+static ImU64 GetLogFileSize(ImExtLogFileData* data)
+{
+#ifdef _WIN32
+	LARGE_INTEGER size;
+	return ::GetFileSizeEx(data->File, &size) ? (ImU64)size.QuadPart : 0;
+#else
+	struct stat st;
+	return (fstat(data->File, &st) == 0) ? (ImU64)st.st_size : 0;
+#endif
+}
+
+#ifndef _WIN32
+// Windows refuses to truncate a mapped file, elsewhere reading pages past the new end raises SIGBUS. Sizes are checked
+// before reading, this covers the reads racing a truncation: a fault in a log mapping replaces its pages from there with
+// zero pages, the walk then misses a line break and the view asks for a new index. Other faults go to the previous handler.
+struct ImExtLogGuardedRange
+{
+	std::atomic<uintptr_t> Begin;       // 0: free, 1: being registered
+	std::atomic<uintptr_t> End;
+};
+
+static ImExtLogGuardedRange GImExtLogGuardedRanges[IMEXT_LOG_GUARDED_MAPPINGS];
+static struct sigaction GImExtLogPrevSigbus;
+static uintptr_t GImExtLogPageSize = 0;
+
+static void LogSigbusHandler(int sig, siginfo_t* info, void* ucontext)
+{
+	const uintptr_t addr = (uintptr_t)info->si_addr;
+	for (int n = 0; n < IMEXT_LOG_GUARDED_MAPPINGS; n++)
+	{
+		ImExtLogGuardedRange& range = GImExtLogGuardedRanges[n];
+		const uintptr_t begin = range.Begin.load(std::memory_order_acquire);
+		const uintptr_t end = range.End.load(std::memory_order_acquire);
+		if (begin <= 1 || addr < begin || addr >= end)
+			continue;
+		const uintptr_t page = addr & ~(GImExtLogPageSize - 1);
+		if (mmap((void*)page, (size_t)(end - page), PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) != MAP_FAILED)
+			return; // The read is retried on zeros
+		break;
+	}
+	const struct sigaction& prev = GImExtLogPrevSigbus;
+	if ((prev.sa_flags & SA_SIGINFO) && prev.sa_sigaction != NULL)
+		prev.sa_sigaction(sig, info, ucontext);
+	else if (!(prev.sa_flags & SA_SIGINFO) && prev.sa_handler != SIG_DFL && prev.sa_handler != SIG_IGN)
+		prev.sa_handler(sig);
+	else
+		signal(sig, SIG_DFL); // The retried read then terminates the process, as without the guard
+}
+
+static void InstallLogSigbusHandler()
+{
+	static std::once_flag once;
+	std::call_once(once, []()
+	{
+		GImExtLogPageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+		struct sigaction sa;
+		memset(&sa, 0, sizeof(sa));
+		sa.sa_sigaction = LogSigbusHandler;
+		sa.sa_flags = SA_SIGINFO;
+		sigemptyset(&sa.sa_mask);
+		sigaction(SIGBUS, &sa, &GImExtLogPrevSigbus);
+	});
+}
+
+// A mapping left unguarded when all ranges are taken faults like before
+static void GuardLogMapping(const ImExtLogMapping* mapping)
+{
+	const uintptr_t begin = (uintptr_t)mapping->Data;
+	const uintptr_t end = (begin + (uintptr_t)mapping->Size + GImExtLogPageSize - 1) & ~(GImExtLogPageSize - 1);
+	for (int n = 0; n < IMEXT_LOG_GUARDED_MAPPINGS; n++)
+	{
+		ImExtLogGuardedRange& range = GImExtLogGuardedRanges[n];
+		uintptr_t expected = 0;
+		if (!range.Begin.compare_exchange_strong(expected, 1, std::memory_order_acq_rel))
+			continue;
+		range.End.store(end, std::memory_order_release);
+		range.Begin.store(begin, std::memory_order_release);
+		return;
+	}
+}
+
+static void UnguardLogMapping(const ImExtLogMapping* mapping)
+{
+	for (int n = 0; n < IMEXT_LOG_GUARDED_MAPPINGS; n++)
+	{
+		ImExtLogGuardedRange& range = GImExtLogGuardedRanges[n];
+		if (range.Begin.load(std::memory_order_relaxed) != (uintptr_t)mapping->Data)
+			continue;
+		range.End.store(0, std::memory_order_release);
+		range.Begin.store(0, std::memory_order_release);
+		return;
+	}
+}
+#endif
+
+// Map the first 'size' bytes of the file, NULL on failure
+static ImExtLogMapping* MapLogFile(ImExtLogFileData* data, ImU64 size)
+{
+	if (size == 0 || size > (ImU64)(size_t)-1)
+		return NULL;
+#ifdef _WIN32
+	HANDLE handle = ::CreateFileMappingW(data->File, NULL, PAGE_READONLY, (DWORD)(size >> 32), (DWORD)size, NULL);
+	if (handle == NULL)
+		return NULL;
+	void* view = ::MapViewOfFile(handle, FILE_MAP_READ, 0, 0, (SIZE_T)size);
+	if (view == NULL)
+	{
+		::CloseHandle(handle);
+		return NULL;
+	}
+	ImExtLogMapping* mapping = new ImExtLogMapping();
+	mapping->Handle = handle;
+#else
+	void* view = mmap(NULL, (size_t)size, PROT_READ, MAP_SHARED, data->File, 0);
+	if (view == MAP_FAILED)
+		return NULL;
+	ImExtLogMapping* mapping = new ImExtLogMapping();
+#endif
+	mapping->Data = (const char*)view;
+	mapping->Size = size;
+#ifndef _WIN32
+	GuardLogMapping(mapping);
+#endif
+	return mapping;
+}
+
+static void ReleaseLogMapping(ImExtLogMapping* mapping)
+{
+	if (mapping == NULL || mapping->RefCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		return;
+#ifdef _WIN32
+	::UnmapViewOfFile(mapping->Data);
+	::CloseHandle(mapping->Handle);
+#else
+	UnguardLogMapping(mapping);
+	munmap((void*)mapping->Data, (size_t)mapping->Size);
+#endif
+	delete mapping;
+}
+
+static ImExtLogMapping* RetainLogMapping(ImExtLogMapping* mapping)
+{
+	if (mapping != NULL)
+		mapping->RefCount.fetch_add(1, std::memory_order_relaxed);
+	return mapping;
+}
+
+static void PushLogOffset(ImU64** offsets, int* count, int* capacity, ImU64 offset)
+{
+	if (*count == *capacity)
+	{
+		*capacity = (*capacity > 0) ? *capacity * 2 : 1024;
+		*offsets = (ImU64*)realloc(*offsets, (size_t)*capacity * sizeof(ImU64));
+	}
+	(*offsets)[(*count)++] = offset;
+}
+
+// Scans the mapping by steps, publishing the lines found after each, then checks the file size every IMEXT_LOG_POLL_INTERVAL
+static void LogFileIndexer(ImExtLogFileData* data)
+{
+	ImExtLogMapping* mapping = NULL;
+	ImU64* offsets = NULL;
+	int offsets_count = 0, offsets_capacity = 0;
+	ImU64 scanned = 0, line_start = 0;
+	int lines_count = 0;
+	PushLogOffset(&offsets, &offsets_count, &offsets_capacity, 0);
+
+	std::unique_lock<std::mutex> lock(data->Mutex);
+	while (!data->StopRequested)
+	{
+		const bool restart_requested = data->RestartRequested;
+		data->RestartRequested = false;
+		lock.unlock();
+		const ImU64 size = GetLogFileSize(data);
+		const bool restart = size < scanned || restart_requested; // Truncated or rewritten
+		if (restart)
+		{
+			scanned = line_start = 0;
+			lines_count = 0;
+			offsets_count = 0;
+			PushLogOffset(&offsets, &offsets_count, &offsets_capacity, 0);
+		}
+		if (restart || (size > 0 && (mapping == NULL || size > mapping->Size)))
+		{
+			ReleaseLogMapping(mapping);
+			mapping = MapLogFile(data, size);
+		}
+
+		const ImU64 scan_end = mapping ? ImMin(mapping->Size, scanned + IMEXT_LOG_INDEX_STEP) : 0;
+		if (scanned < scan_end)
+		{
+			const char* end = mapping->Data + scan_end;
+			for (const char* p = mapping->Data + scanned; (p = (const char*)memchr(p, '\n', (size_t)(end - p))) != NULL; )
+			{
+				line_start = (ImU64)(++p - mapping->Data);
+				if ((++lines_count % IMEXT_LOG_INDEX_STRIDE) == 0)
+					PushLogOffset(&offsets, &offsets_count, &offsets_capacity, line_start);
+			}
+			scanned = scan_end;
+		}
+
+		lock.lock();
+		if (restart)
+		{
+			data->Generation++;
+			data->NewOffsetsCount = 0;
+			data->CaughtUp = false;
+		}
+		for (int n = 0; n < offsets_count; n++)
+			PushLogOffset(&data->NewOffsets, &data->NewOffsetsCount, &data->NewOffsetsCapacity, offsets[n]);
+		offsets_count = 0;
+		data->LinesCount = lines_count;
+		data->IndexedEnd = line_start;
+		if (data->Mapping != mapping)
+		{
+			ReleaseLogMapping(data->Mapping);
+			data->Mapping = RetainLogMapping(mapping);
+		}
+		if (scanned == (mapping ? mapping->Size : 0))
+		{
+			data->CaughtUp = true;
+			data->WakeCond.wait_for(lock, std::chrono::milliseconds(IMEXT_LOG_POLL_INTERVAL), [data]() { return data->StopRequested || data->RestartRequested; });
+		}
+	}
+	lock.unlock();
+	ReleaseLogMapping(mapping);
+	free(offsets);
+}
+
+ImExtLogFile::~ImExtLogFile()
+{
+	Close();
+}
+
+bool ImExtLogFile::Open(const char* filename)
+{
+	Close();
+	ImExtLogFileData* data = IM_NEW(ImExtLogFileData)();
+#ifdef _WIN32
+	const int wchars_count = ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, NULL, 0);
+	ImVector<wchar_t> wfilename;
+	wfilename.resize(wchars_count);
+	::MultiByteToWideChar(CP_UTF8, 0, filename, -1, wfilename.Data, wchars_count);
+	data->File = ::CreateFileW(wfilename.Data, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	const bool opened = (data->File != INVALID_HANDLE_VALUE);
+#else
+	data->File = open(filename, O_RDONLY | O_CLOEXEC);
+	const bool opened = (data->File >= 0);
+	InstallLogSigbusHandler();
+#endif
+	if (!opened)
+	{
+		IM_DELETE(data);
+		return false;
+	}
+	data->Indexer = std::thread(LogFileIndexer, data);
+	Data = data;
+	return true;
+}
+
+static void FreeLogFilterJob(ImExtLogFilterJob* job)
+{
+	if (job->State.load(std::memory_order_relaxed) == ImExtTaskState_Pending)
+		ReleaseLogMapping(job->Mapping); // Never ran
+	free(job->Matches);
+	IM_DELETE(job);
+}
+
+// Cancel the jobs of 'filter', it is deleted by UpdateRetiredLogFilters() once none is queued or running
+static void RetireLogFilter(ImExtLogFileData* data, ImExtLogFilter* filter)
+{
+	if (filter == NULL)
+		return;
+	filter->CancelRequested.store(true, std::memory_order_relaxed);
+	data->RetiredFilters.push_back(filter);
+}
+
+static void UpdateRetiredLogFilters(ImExtLogFileData* data)
+{
+	for (int n = 0; n < data->RetiredFilters.Size; n++)
+	{
+		ImExtLogFilter* filter = data->RetiredFilters[n];
+		bool busy = false;
+		for (int job_n = 0; job_n < filter->Jobs.Size && !busy; job_n++)
+		{
+			const int state = filter->Jobs[job_n]->State.load(std::memory_order_acquire);
+			busy = (state == ImExtTaskState_Queued || state == ImExtTaskState_Running);
+		}
+		if (busy)
+			continue;
+		for (int job_n = 0; job_n < filter->Jobs.Size; job_n++)
+			FreeLogFilterJob(filter->Jobs[job_n]);
+		IM_DELETE(filter);
+		data->RetiredFilters.erase(data->RetiredFilters.Data + n--);
+	}
+}
+
+void ImExtLogFile::Close()
+{
+	ImExtLogFileData* data = Data;
+	if (data == NULL)
+		return;
+	{
+		std::lock_guard<std::mutex> lock(data->Mutex);
+		data->StopRequested = true;
+	}
+	data->WakeCond.notify_one();
+	data->Indexer.join();
+	RetireLogFilter(data, data->Filter);
+	while (data->RetiredFilters.Size > 0)
+	{
+		UpdateRetiredLogFilters(data);
+		if (data->RetiredFilters.Size > 0)
+			std::this_thread::yield();
+	}
+	ReleaseLogMapping(data->Mapping);
+	ReleaseLogMapping(data->ViewMapping);
+	free(data->NewOffsets);
+#ifdef _WIN32
+	::CloseHandle(data->File);
+#else
+	close(data->File);
+#endif
+	IM_DELETE(data);
+	Data = NULL;
+}
+
+int ImExtLogFile::GetLinesCount() const
+{
+	return Data ? Data->ViewLinesCount : 0;
+}
+
+// Forget the lines of the view, the filter starts over with the same pattern
+static void ResetLogView(ImExtLogFileData* data)
+{
+	data->LineOffsets.resize(0);
+	data->ViewLinesCount = 0;
+	data->ViewIndexedEnd = 0;
+	data->ViewCaughtUp = false;
+	data->Arrivals.resize(0);
+	if (ImExtLogFilter* filter = data->Filter)
+	{
+		ImExtLogFilter* restarted = IM_NEW(ImExtLogFilter)();
+		restarted->Pattern = filter->Pattern;
+		restarted->Regex = filter->Regex;
+		restarted->IsRegex = filter->IsRegex;
+		RetireLogFilter(data, filter);
+		data->Filter = restarted;
+	}
+}
+
+// Take what the indexer published since the previous frame
+static void SyncLogFile(ImExtLogFileData* data, double time)
+{
+	std::lock_guard<std::mutex> lock(data->Mutex);
+	if (data->ViewGeneration != data->Generation)
+	{
+		data->ViewGeneration = data->Generation;
+		data->ViewStale = false;
+		ResetLogView(data);
+	}
+
+	// Truncated since the indexer mapped it, or a line break went missing: show nothing until it indexed the file again
+	if (!data->ViewStale && data->ViewMapping != NULL && GetLogFileSize(data) < data->ViewMapping->Size)
+		data->ViewStale = true;
+	if (data->ViewStale)
+	{
+		if (data->ViewMapping != NULL)
+		{
+			ResetLogView(data);
+			ReleaseLogMapping(data->ViewMapping);
+			data->ViewMapping = NULL;
+			data->RestartRequested = true;
+			data->WakeCond.notify_one();
+		}
+		data->NewOffsetsCount = 0;
+		return;
+	}
+
+	for (int n = 0; n < data->NewOffsetsCount; n++)
+		data->LineOffsets.push_back(data->NewOffsets[n]);
+	data->NewOffsetsCount = 0;
+	if (data->ViewCaughtUp && data->LinesCount > data->ViewLinesCount)
+	{
+		ImExtLogArrival arrival;
+		arrival.FirstLine = data->ViewLinesCount;
+		arrival.Time = time;
+		data->Arrivals.push_back(arrival);
+	}
+	data->ViewLinesCount = data->LinesCount;
+	data->ViewIndexedEnd = data->IndexedEnd;
+	data->ViewCaughtUp = data->CaughtUp;
+	if (data->ViewMapping != data->Mapping)
+	{
+		ReleaseLogMapping(data->ViewMapping);
+		data->ViewMapping = RetainLogMapping(data->Mapping);
+	}
+}
+
+// Offset of line 'line' (up to ViewLinesCount, the unterminated last line), from the closest indexed offset.
+// A line break missing from the mapping means the file changed under it: the view is marked stale, see SyncLogFile().
+static ImU64 GetLogLineOffset(ImExtLogFileData* data, int line)
+{
+	if (line >= data->ViewLinesCount)
+		return data->ViewIndexedEnd;
+	const char* mapped = data->ViewMapping->Data;
+	const char* p = mapped + data->LineOffsets[line / IMEXT_LOG_INDEX_STRIDE];
+	for (int n = line % IMEXT_LOG_INDEX_STRIDE; n > 0; n--)
+	{
+		const char* eol = (const char*)memchr(p, '\n', (size_t)(mapped + data->ViewIndexedEnd - p));
+		if (eol == NULL)
+		{
+			data->ViewStale = true;
+			return data->ViewIndexedEnd;
+		}
+		p = eol + 1;
+	}
+	return (ImU64)(p - mapped);
+}
+
+// Line at 'offset' without its line break, cut at IMEXT_LOG_MAX_LINE_LENGTH bytes. Return the offset of the next line.
+static ImU64 GetLogLine(const ImExtLogMapping* mapping, ImU64 offset, ImU64 end, const char** out_text, const char** out_text_end)
+{
+	const char* text = mapping->Data + offset;
+	const char* eol = (const char*)memchr(text, '\n', (size_t)(end - offset));
+	const ImU64 next = eol ? (ImU64)(eol + 1 - mapping->Data) : end;
+	if (eol == NULL)
+		eol = mapping->Data + end;
+	if (eol > text && eol[-1] == '\r')
+		eol--;
+	*out_text = text;
+	*out_text_end = ImMin(eol, text + IMEXT_LOG_MAX_LINE_LENGTH);
+	return next;
+}
+
+static bool LogFilterMatch(const ImExtLogFilter* filter, const char* text, const char* text_end)
+{
+	if (!filter->IsRegex)
+		return ImStristr(text, text_end, filter->Pattern.Data, filter->Pattern.Data + filter->Pattern.Size - 1) != NULL;
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+	try
+	{
+		return std::regex_search(text, text_end, filter->Regex);
+	}
+	catch (const std::regex_error&) // Too complex for this line
+	{
+		return false;
+	}
+#else
+	return std::regex_search(text, text_end, filter->Regex);
+#endif
+}
+
+static void LogFilterRun(void* arg)
+{
+	ImExtLogFilterJob* job = (ImExtLogFilterJob*)arg;
+	const ImExtLogFilter* filter = job->Filter;
+	job->State.store(ImExtTaskState_Running, std::memory_order_relaxed);
+	ImU64 offset = job->Begin;
+	for (int n = 0; n < job->LinesCount; n++)
+	{
+		if ((n & 1023) == 0 && filter->CancelRequested.load(std::memory_order_relaxed))
+			break;
+		const char* text;
+		const char* text_end;
+		offset = GetLogLine(job->Mapping, offset, job->End, &text, &text_end);
+		if (!LogFilterMatch(filter, text, text_end))
+			continue;
+		if (job->MatchesCount == job->MatchesCapacity)
+		{
+			job->MatchesCapacity = (job->MatchesCapacity > 0) ? job->MatchesCapacity * 2 : 256;
+			job->Matches = (int*)realloc(job->Matches, (size_t)job->MatchesCapacity * sizeof(int));
+		}
+		job->Matches[job->MatchesCount++] = job->FirstLine + n;
+	}
+	ReleaseLogMapping(job->Mapping);
+	job->State.store(ImExtTaskState_Done, std::memory_order_release); // Last access of the worker
+}
+
+static ImExtLogFilter* CreateLogFilter(const char* pattern)
+{
+	ImExtLogFilter* filter = IM_NEW(ImExtLogFilter)();
+	filter->Pattern.resize((int)strlen(pattern) + 1);
+	memcpy(filter->Pattern.Data, pattern, (size_t)filter->Pattern.Size);
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+	try
+	{
+		filter->Regex.assign(pattern, std::regex::ECMAScript | std::regex::optimize);
+		filter->IsRegex = true;
+	}
+	catch (const std::regex_error&) // Incomplete while being typed, matched as text meanwhile
+	{
+		filter->IsRegex = false;
+	}
+#endif
+	return filter;
+}
+
+// Merge the jobs done in line order, then hand the lines indexed since the previous frame to new jobs
+static void UpdateLogFilter(ImExtContext& e, ImExtLogFileData* data, ImExtLogFilter* filter)
+{
+	int merged = 0;
+	for (; merged < filter->Jobs.Size; merged++)
+	{
+		ImExtLogFilterJob* job = filter->Jobs[merged];
+		if (job->State.load(std::memory_order_acquire) != ImExtTaskState_Done)
+			break;
+		const int matches_start = filter->Matches.Size;
+		filter->Matches.resize(matches_start + job->MatchesCount);
+		if (job->MatchesCount > 0)
+			memcpy(filter->Matches.Data + matches_start, job->Matches, (size_t)job->MatchesCount * sizeof(int));
+		filter->LinesDone = job->FirstLine + job->LinesCount;
+		FreeLogFilterJob(job);
+	}
+	if (merged > 0)
+		filter->Jobs.erase(filter->Jobs.Data, filter->Jobs.Data + merged);
+
+	for (int n = 0; n < filter->Jobs.Size; n++)
+	{
+		ImExtLogFilterJob* job = filter->Jobs[n];
+		if (job->State.load(std::memory_order_relaxed) != ImExtTaskState_Pending)
+			continue;
+		job->State.store(ImExtTaskState_Queued, std::memory_order_relaxed);
+		if (!SubmitJob(e, LogFilterRun, job))
+		{
+			job->State.store(ImExtTaskState_Pending, std::memory_order_relaxed);
+			return; // Pool full, retried next frame
+		}
+	}
+	while (filter->LinesCount < data->ViewLinesCount)
+	{
+		const int first_line = filter->LinesCount;
+		const int lines_count = ImMin(data->ViewLinesCount - first_line, IMEXT_LOG_FILTER_CHUNK);
+		const ImU64 begin = GetLogLineOffset(data, first_line);
+		const ImU64 end = GetLogLineOffset(data, first_line + lines_count);
+		if (data->ViewStale)
+			return;
+		ImExtLogFilterJob* job = IM_NEW(ImExtLogFilterJob)();
+		job->Filter = filter;
+		job->Mapping = RetainLogMapping(data->ViewMapping);
+		job->FirstLine = first_line;
+		job->LinesCount = lines_count;
+		job->Begin = begin;
+		job->End = end;
+		filter->Jobs.push_back(job);
+		filter->LinesCount += job->LinesCount;
+		job->State.store(ImExtTaskState_Queued, std::memory_order_relaxed);
+		if (!SubmitJob(e, LogFilterRun, job))
+		{
+			job->State.store(ImExtTaskState_Pending, std::memory_order_relaxed);
+			return;
+		}
+	}
+}
+
+// Highlight of line 'line', 1 when it just arrived
+static float GetLogLineFade(const ImExtLogFileData* data, int line, double time, const float dt)
+{
+	for (int n = data->Arrivals.Size - 1; n >= 0; n--)
+		if (data->Arrivals[n].FirstLine <= line)
+			return ImSaturate(1.0f - (float)(time - data->Arrivals[n].Time) * dt / IMEXT_LOG_FADE_DURATION);
+	return 0.0f;
+}
+#pragma endregion
+
+#pragma region TextBuffer
+// Pieces are the nodes of a treap ordered by position, each with the byte and line break counts of its subtree. The line
+// breaks of both buffers are indexed as they are written: a piece counts its own with two binary searches, so cutting a
+// piece of a 100 MB original text doesn't scan it. Typing right after the previous insertion extends its piece.
+struct ImExtTextPiece
+{
+	int Left;                           // Child pieces, -1 when none. Left links the free pieces.
+	int Right;
+	ImU32 Priority;
+	int Buffer;                         // 0: original text, 1: inserted text
+	int Start;
+	int Length;
+	int LineBreaks;
+	int TreeLength;                     // Sums over the piece and its subtree
+	int TreeLineBreaks;
+};
+
+struct ImExtTextBufferData
+{
+	ImVector<char> Buffers[2];          // Original text, inserted text
+	ImVector<int> LineBreaks[2];        // Offsets of the '\n' of each buffer
+	ImVector<ImExtTextPiece> Pieces;
+	int FreePieces;
+	int Root;
+	ImU32 Seed;
+
+	ImExtTextBufferData() { FreePieces = Root = -1; Seed = 0x9E3779B9; }
+};
+
+static int LowerBoundInt(const ImVector<int>& values, int value)
+{
+	int first = 0, count = values.Size;
+	while (count > 0)
+	{
+		const int step = count / 2;
+		if (values.Data[first + step] < value)
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else
+		{
+			count = step;
+		}
+	}
+	return first;
+}
+
+static void IndexLineBreaks(ImVector<int>& line_breaks, const char* text, int start, int length)
+{
+	const char* end = text + start + length;
+	for (const char* p = text + start; (p = (const char*)memchr(p, '\n', (size_t)(end - p))) != NULL; p++)
+		line_breaks.push_back((int)(p - text));
+}
+
+static int AddTextPiece(ImExtTextBufferData* data, int buffer, int start, int length, ImU32 priority)
+{
+	int n = data->FreePieces;
+	if (n >= 0)
+	{
+		data->FreePieces = data->Pieces[n].Left;
+	}
+	else
+	{
+		n = data->Pieces.Size;
+		data->Pieces.resize(n + 1);
+	}
+	const ImVector<int>& line_breaks = data->LineBreaks[buffer];
+	ImExtTextPiece& piece = data->Pieces[n];
+	piece.Left = piece.Right = -1;
+	piece.Priority = priority;
+	piece.Buffer = buffer;
+	piece.Start = start;
+	piece.Length = length;
+	piece.LineBreaks = LowerBoundInt(line_breaks, start + length) - LowerBoundInt(line_breaks, start);
+	piece.TreeLength = length;
+	piece.TreeLineBreaks = piece.LineBreaks;
+	return n;
+}
+
+static ImU32 NextTextPiecePriority(ImExtTextBufferData* data)
+{
+	ImU32 x = data->Seed; // xorshift32
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return data->Seed = x;
+}
+
+static void UpdateTextPiece(ImExtTextBufferData* data, int n)
+{
+	ImExtTextPiece& piece = data->Pieces[n];
+	piece.TreeLength = piece.Length;
+	piece.TreeLineBreaks = piece.LineBreaks;
+	if (piece.Left >= 0)
+	{
+		piece.TreeLength += data->Pieces[piece.Left].TreeLength;
+		piece.TreeLineBreaks += data->Pieces[piece.Left].TreeLineBreaks;
+	}
+	if (piece.Right >= 0)
+	{
+		piece.TreeLength += data->Pieces[piece.Right].TreeLength;
+		piece.TreeLineBreaks += data->Pieces[piece.Right].TreeLineBreaks;
+	}
+}
+
+// Split the tree 'n' into the pieces before 'offset' and the ones after, cutting the piece containing it
+static void SplitTextPieces(ImExtTextBufferData* data, int n, int offset, int* out_left, int* out_right)
+{
+	if (n < 0)
+	{
+		*out_left = *out_right = -1;
+		return;
+	}
+	const ImExtTextPiece& piece = data->Pieces[n];
+	const int left_length = (piece.Left >= 0) ? data->Pieces[piece.Left].TreeLength : 0;
+	if (offset <= left_length)
+	{
+		int left_right;
+		SplitTextPieces(data, piece.Left, offset, out_left, &left_right);
+		data->Pieces[n].Left = left_right;
+		UpdateTextPiece(data, n);
+		*out_right = n;
+	}
+	else if (offset >= left_length + piece.Length)
+	{
+		int right_left;
+		SplitTextPieces(data, piece.Right, offset - left_length - piece.Length, &right_left, out_right);
+		data->Pieces[n].Right = right_left;
+		UpdateTextPiece(data, n);
+		*out_left = n;
+	}
+	else
+	{
+		// The tail takes the priority and the right subtree of the piece
+		const int cut = offset - left_length;
+		const int tail = AddTextPiece(data, piece.Buffer, piece.Start + cut, piece.Length - cut, piece.Priority);
+		ImExtTextPiece& head = data->Pieces[n];
+		data->Pieces[tail].Right = head.Right;
+		head.Right = -1;
+		head.Length = cut;
+		head.LineBreaks -= data->Pieces[tail].LineBreaks;
+		UpdateTextPiece(data, tail);
+		UpdateTextPiece(data, n);
+		*out_left = n;
+		*out_right = tail;
+	}
+}
+
+static int MergeTextPieces(ImExtTextBufferData* data, int left, int right)
+{
+	if (left < 0)
+		return right;
+	if (right < 0)
+		return left;
+	if (data->Pieces[left].Priority > data->Pieces[right].Priority)
+	{
+		const int merged = MergeTextPieces(data, data->Pieces[left].Right, right);
+		data->Pieces[left].Right = merged;
+		UpdateTextPiece(data, left);
+		return left;
+	}
+	const int merged = MergeTextPieces(data, left, data->Pieces[right].Left);
+	data->Pieces[right].Left = merged;
+	UpdateTextPiece(data, right);
+	return right;
+}
+
+static void FreeTextPieces(ImExtTextBufferData* data, int n)
+{
+	while (n >= 0)
+	{
+		ImExtTextPiece& piece = data->Pieces[n];
+		FreeTextPieces(data, piece.Left);
+		const int right = piece.Right;
+		piece.Left = data->FreePieces;
+		data->FreePieces = n;
+		n = right;
+	}
+}
+
+// Copy [begin, end) of the tree 'n' to *dst
+static void CopyTextPieces(const ImExtTextBufferData* data, int n, int begin, int end, char** dst)
+{
+	while (n >= 0 && begin < end)
+	{
+		const ImExtTextPiece& piece = data->Pieces[n];
+		const int left_length = (piece.Left >= 0) ? data->Pieces[piece.Left].TreeLength : 0;
+		if (begin < left_length)
+			CopyTextPieces(data, piece.Left, begin, ImMin(end, left_length), dst);
+		const int piece_begin = ImMax(begin - left_length, 0), piece_end = ImMin(end - left_length, piece.Length);
+		if (piece_begin < piece_end)
+		{
+			memcpy(*dst, data->Buffers[piece.Buffer].Data + piece.Start + piece_begin, (size_t)(piece_end - piece_begin));
+			*dst += piece_end - piece_begin;
+		}
+		const int right_start = left_length + piece.Length;
+		begin = ImMax(begin - right_start, 0);
+		end -= right_start;
+		n = piece.Right;
+	}
+}
+
+ImExtTextBuffer::ImExtTextBuffer()
+{
+	Data = IM_NEW(ImExtTextBufferData)();
+}
+
+ImExtTextBuffer::~ImExtTextBuffer()
+{
+	IM_DELETE(Data);
+}
+
+void ImExtTextBuffer::SetText(const char* text, const char* text_end)
+{
+	ImExtTextBufferData* data = Data;
+	if (text_end == NULL)
+		text_end = text + strlen(text);
+	const int length = (int)(text_end - text);
+	for (int n = 0; n < 2; n++)
+	{
+		data->Buffers[n].clear();
+		data->LineBreaks[n].clear();
+	}
+	data->Pieces.clear();
+	data->FreePieces = data->Root = -1;
+	data->Buffers[0].resize(length);
+	memcpy(data->Buffers[0].Data, text, (size_t)length);
+	IndexLineBreaks(data->LineBreaks[0], data->Buffers[0].Data, 0, length);
+	if (length > 0)
+		data->Root = AddTextPiece(data, 0, 0, length, NextTextPiecePriority(data));
+}
+
+void ImExtTextBuffer::Insert(int offset, const char* text, const char* text_end)
+{
+	ImExtTextBufferData* data = Data;
+	if (text_end == NULL)
+		text_end = text + strlen(text);
+	const int length = (int)(text_end - text);
+	if (length <= 0)
+		return;
+	offset = ImClamp(offset, 0, GetLength());
+	ImVector<char>& added = data->Buffers[1];
+	ImVector<int>& added_line_breaks = data->LineBreaks[1];
+	const int start = added.Size;
+	const int line_breaks_start = added_line_breaks.Size;
+	added.resize(start + length);
+	memcpy(added.Data + start, text, (size_t)length);
+	IndexLineBreaks(added_line_breaks, added.Data, start, length);
+	const int line_breaks = added_line_breaks.Size - line_breaks_start;
+
+	int left, right;
+	SplitTextPieces(data, data->Root, offset, &left, &right);
+	int last = left;
+	while (last >= 0 && data->Pieces[last].Right >= 0)
+		last = data->Pieces[last].Right;
+	if (last >= 0 && data->Pieces[last].Buffer == 1 && data->Pieces[last].Start + data->Pieces[last].Length == start)
+	{
+		for (int n = left; n >= 0; n = data->Pieces[n].Right)
+		{
+			data->Pieces[n].TreeLength += length;
+			data->Pieces[n].TreeLineBreaks += line_breaks;
+		}
+		data->Pieces[last].Length += length;
+		data->Pieces[last].LineBreaks += line_breaks;
+	}
+	else
+	{
+		left = MergeTextPieces(data, left, AddTextPiece(data, 1, start, length, NextTextPiecePriority(data)));
+	}
+	data->Root = MergeTextPieces(data, left, right);
+}
+
+void ImExtTextBuffer::Delete(int offset, int length)
+{
+	ImExtTextBufferData* data = Data;
+	offset = ImClamp(offset, 0, GetLength());
+	length = ImMin(length, GetLength() - offset);
+	if (length <= 0)
+		return;
+	int left, middle, right;
+	SplitTextPieces(data, data->Root, offset, &left, &middle);
+	SplitTextPieces(data, middle, length, &middle, &right);
+	FreeTextPieces(data, middle);
+	data->Root = MergeTextPieces(data, left, right);
+}
+
+void ImExtTextBuffer::GetText(int offset, int length, ImVector<char>* out) const
+{
+	offset = ImClamp(offset, 0, GetLength());
+	length = ImClamp(length, 0, GetLength() - offset);
+	out->resize(length + 1);
+	char* dst = out->Data;
+	CopyTextPieces(Data, Data->Root, offset, offset + length, &dst);
+	*dst = 0;
+}
+
+int ImExtTextBuffer::GetLength() const
+{
+	return (Data->Root >= 0) ? Data->Pieces[Data->Root].TreeLength : 0;
+}
+
+int ImExtTextBuffer::GetLinesCount() const
+{
+	return ((Data->Root >= 0) ? Data->Pieces[Data->Root].TreeLineBreaks : 0) + 1;
+}
+
+int ImExtTextBuffer::GetLineStart(int line) const
+{
+	const ImExtTextBufferData* data = Data;
+	if (line <= 0)
+		return 0;
+	if (line >= GetLinesCount())
+		return GetLength();
+	int offset = 0;
+	for (int n = data->Root; n >= 0; )
+	{
+		const ImExtTextPiece& piece = data->Pieces[n];
+		const int left_line_breaks = (piece.Left >= 0) ? data->Pieces[piece.Left].TreeLineBreaks : 0;
+		if (line <= left_line_breaks)
+		{
+			n = piece.Left;
+			continue;
+		}
+		line -= left_line_breaks;
+		offset += (piece.Left >= 0) ? data->Pieces[piece.Left].TreeLength : 0;
+		if (line <= piece.LineBreaks)
+		{
+			const ImVector<int>& line_breaks = data->LineBreaks[piece.Buffer];
+			return offset + line_breaks[LowerBoundInt(line_breaks, piece.Start) + line - 1] - piece.Start + 1;
+		}
+		line -= piece.LineBreaks;
+		offset += piece.Length;
+		n = piece.Right;
+	}
+	return offset;
+}
+
+int ImExtTextBuffer::GetLineFromOffset(int offset) const
+{
+	const ImExtTextBufferData* data = Data;
+	int line = 0;
+	for (int n = data->Root; n >= 0; )
+	{
+		const ImExtTextPiece& piece = data->Pieces[n];
+		const int left_length = (piece.Left >= 0) ? data->Pieces[piece.Left].TreeLength : 0;
+		if (offset <= left_length)
+		{
+			n = piece.Left;
+			continue;
+		}
+		line += (piece.Left >= 0) ? data->Pieces[piece.Left].TreeLineBreaks : 0;
+		offset -= left_length;
+		if (offset <= piece.Length)
+		{
+			const ImVector<int>& line_breaks = data->LineBreaks[piece.Buffer];
+			return line + LowerBoundInt(line_breaks, piece.Start + offset) - LowerBoundInt(line_breaks, piece.Start);
+		}
+		line += piece.LineBreaks;
+		offset -= piece.Length;
+		n = piece.Right;
+	}
+	return line;
+}
+#pragma endregion
+
+#pragma region TextSize
+#ifdef IMGUI_ENABLE_SSE
+static inline int ImCountTrailingZeros(unsigned int v)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, v);
+	return (int)index;
+#else
+	return __builtin_ctz(v);
+#endif
+}
+#endif
+
+// Return the first byte of [s, s_end) which is not printable ASCII: control characters and UTF-8 sequences.
+// Signed compares against ' ' catch both, bytes >= 0x80 being negative.
+static const char* FindNonPrintableAscii(const char* s, const char* s_end)
+{
+#ifdef __AVX2__
+	const __m256i space_256 = _mm256_set1_epi8(' ');
+	for (; s_end - s >= 32; s += 32)
+		if (const unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi8(space_256, _mm256_loadu_si256((const __m256i*)s))))
+			return s + ImCountTrailingZeros(mask);
+#endif
+#ifdef IMGUI_ENABLE_SSE
+	const __m128i space = _mm_set1_epi8(' ');
+	for (; s_end - s >= 16; s += 16)
+		if (const unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmplt_epi8(_mm_loadu_si128((const __m128i*)s), space)))
+			return s + ImCountTrailingZeros(mask);
+#endif
+	while (s < s_end && (signed char)*s >= ' ')
+		s++;
+	return s;
+}
+
+// Same result as ImFont::CalcTextSizeA(size, FLT_MAX, 0.0f, text, text_end): widths are still accumulated one character
+// at a time in the same order, ASCII runs only skip the UTF-8 decoding and control characters checks.
+static ImVec2 FontCalcTextSize(const ImFont* font, float size, const char* text, const char* text_end)
+{
+	if (font->IndexAdvanceX.Size < 0x80)
+		return font->CalcTextSizeA(size, FLT_MAX, 0.0f, text, text_end);
+
+	const float line_height = size;
+	const float scale = size / font->FontSize;
+	const float* index_advance_x = font->IndexAdvanceX.Data;
+	ImVec2 text_size = ImVec2(0, 0);
+	float line_width = 0.0f;
+
+	const char* s = text;
+	bool max_width_reached = false;
+	while (s < text_end && !max_width_reached)
+	{
+		for (const char* run_end = FindNonPrintableAscii(s, text_end); s < run_end; s++)
+		{
+			const float char_width = index_advance_x[(unsigned char)*s] * scale;
+			if (line_width + char_width >= FLT_MAX)
+			{
+				max_width_reached = true;
+				break;
+			}
+			line_width += char_width;
+		}
+		if (s == text_end || max_width_reached)
+			break;
+
+		// Decode and advance source
+		const char* prev_s = s;
+		unsigned int c = (unsigned int)*s;
+		if (c < 0x80)
+		{
+			s += 1;
+		}
+		else
+		{
+			s += ImTextCharFromUtf8(&c, s, text_end);
+			if (c == 0) // Malformed UTF-8?
+				break;
+		}
+
+		if (c < 32)
+		{
+			if (c == '\n')
+			{
+				text_size.x = ImMax(text_size.x, line_width);
+				text_size.y += line_height;
+				line_width = 0.0f;
+				continue;
+			}
+			if (c == '\r')
+				continue;
+		}
+
+		const float char_width = ((int)c < font->IndexAdvanceX.Size ? index_advance_x[c] : font->FallbackAdvanceX) * scale;
+		if (line_width + char_width >= FLT_MAX)
+		{
+			s = prev_s;
+			break;
+		}
+		line_width += char_width;
+	}
+
+	if (text_size.x < line_width)
+		text_size.x = line_width;
+	if (line_width > 0 || text_size.y == 0.0f)
+		text_size.y += line_height;
+	return text_size;
+}
+
+// Same result as ImGui::CalcTextSize(text, text_end)
+static ImVec2 CalcTextSizeFast(const char* text, const char* text_end)
+{
+	ImGuiContext& g = *GImGui;
+	if (text_end == NULL)
+		text_end = text + strlen(text);
+	if (text == text_end)
+		return ImVec2(0.0f, g.FontSize);
+	ImVec2 text_size = FontCalcTextSize(g.Font, g.FontSize, text, text_end);
+	text_size.x = IM_FLOOR(text_size.x + 0.99999f);
+	return text_size;
+}
+#pragma endregion
+
+#pragma region ImDraw
+#define IMEXT_GLYPH_RUN_MAX_LENGTH      1024 // Longer texts go through ImDrawList::AddText(), which only lays out the visible lines
+
+// Write one glyph quad, clipped to 'fine_clip_rect' if any like ImFont::RenderText() does. Return false when nothing is left.
+static inline bool PrimGlyphQuad(ImDrawVert* vtx_write, ImDrawIdx* idx_write, unsigned int vtx_current_idx, float x1, float y1, float x2, float y2, float u1, float v1, float u2, float v2, ImU32 col, const ImVec4* fine_clip_rect)
+{
+	if (fine_clip_rect)
+	{
+		const ImVec4& clip_rect = *fine_clip_rect;
+		if (x1 < clip_rect.x)
+		{
+			u1 = u1 + (1.0f - (x2 - clip_rect.x) / (x2 - x1)) * (u2 - u1);
+			x1 = clip_rect.x;
+		}
+		if (y1 < clip_rect.y)
+		{
+			v1 = v1 + (1.0f - (y2 - clip_rect.y) / (y2 - y1)) * (v2 - v1);
+			y1 = clip_rect.y;
+		}
+		if (x2 > clip_rect.z)
+		{
+			u2 = u1 + ((clip_rect.z - x1) / (x2 - x1)) * (u2 - u1);
+			x2 = clip_rect.z;
+		}
+		if (y2 > clip_rect.w)
+		{
+			v2 = v1 + ((clip_rect.w - y1) / (y2 - y1)) * (v2 - v1);
+			y2 = clip_rect.w;
+		}
+		if (y1 >= y2)
+			return false;
+	}
+	idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx + 1); idx_write[2] = (ImDrawIdx)(vtx_current_idx + 2);
+	idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx + 2); idx_write[5] = (ImDrawIdx)(vtx_current_idx + 3);
+	vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
+	vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
+	vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
+	vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+	return true;
+}
+
+// Same output as ImDrawList::AddText() with the draw list font, from quads laid out the first time the text was seen.
+// Runs are re-anchored when the text moves (e.g. scrolling). Clipping culls whole runs, then whole quads.
+// Glyphs right of 'split_x' use 'col_split' instead of 'col', the glyphs straddling it are cut in two.
+static void AddTextCached(ImDrawList* draw_list, const ImVec2& pos, ImU32 col, const char* text, const char* text_end, float wrap_width, const ImVec4* cpu_fine_clip_rect, float split_x = FLT_MAX, ImU32 col_split = 0)
+{
+	if ((col & IM_COL32_A_MASK) == 0 && (split_x == FLT_MAX || (col_split & IM_COL32_A_MASK) == 0))
+		return;
+	if (text_end == NULL)
+		text_end = text + strlen(text);
+	if (text == text_end)
+		return;
+
+	ImExtContext& e = GetExtContext();
+	ImFont* font = draw_list->_Data->Font;
+	const float font_size = draw_list->_Data->FontSize;
+	if ((e.IO.ConfigFlags & ImExtConfigFlags_NoGlyphRunCache) || text_end - text > IMEXT_GLYPH_RUN_MAX_LENGTH)
+	{
+		if (split_x == FLT_MAX)
+		{
+			draw_list->AddText(font, font_size, pos, col, text, text_end, wrap_width, cpu_fine_clip_rect);
+			return;
+		}
+		ImVec4 clip_rect = cpu_fine_clip_rect ? *cpu_fine_clip_rect : draw_list->_CmdHeader.ClipRect;
+		const ImVec4 clip_rect_left(clip_rect.x, clip_rect.y, ImMin(clip_rect.z, split_x), clip_rect.w);
+		const ImVec4 clip_rect_right(ImMax(clip_rect.x, split_x), clip_rect.y, clip_rect.z, clip_rect.w);
+		if (clip_rect_left.x < clip_rect_left.z)
+			draw_list->AddText(font, font_size, pos, col, text, text_end, wrap_width, &clip_rect_left);
+		if (clip_rect_right.x < clip_rect_right.z)
+			draw_list->AddText(font, font_size, pos, col_split, text, text_end, wrap_width, &clip_rect_right);
+		return;
+	}
+	IM_ASSERT(font->ContainerAtlas->TexID == draw_list->_CmdHeader.TextureId);  // Use high-level ImGui::PushFont() or low-level ImDrawList::PushTextureId() to change font.
+
+	ImExtGlyphRunKey key;
+	memset((void*)&key, 0, sizeof(key)); // Clear padding
+	key.Font = font;
+	key.FontSize = font_size;
+	key.WrapWidth = wrap_width;
+	key.GlyphsGeneration = GImExtGlyphsGeneration;
+	key.TextLength = (int)(text_end - text);
+	const ImGuiID run_id = ImHashData(text, (size_t)(text_end - text), ImHashData(&key, sizeof(key)));
+
+	const ImVec2 origin(IM_FLOOR(pos.x), IM_FLOOR(pos.y));
+	ImExtGlyphRun* run = e.GlyphRuns.GetOrAddByKey(run_id);
+	if (run->LastFrame == -1 || memcmp(&run->Key, &key, sizeof(key)) != 0 || memcmp(run->GetText(), text, (size_t)key.TextLength) != 0)
+	{
+		// Lay out unclipped in black, colored glyphs come out white. A colliding run is laid out again in place.
+		e.GlyphRunMisses++;
+		ImDrawList* layout = &e.GlyphRunDrawList;
+		layout->_Data = draw_list->_Data;
+		layout->_ResetForNewFrame();
+		font->RenderText(layout, font_size, origin, IM_COL32_BLACK, ImVec4(-FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX), text, text_end, wrap_width, false);
+
+		// Copy the quads then the text
+		const int vtx_count = layout->VtxBuffer.Size;
+		e.GlyphRunBuffers.Reserve(run->VtxBuffer, vtx_count + (key.TextLength + (int)sizeof(ImDrawVert) - 1) / (int)sizeof(ImDrawVert));
+		run->VtxBuffer.resize(vtx_count);
+		memcpy(run->VtxBuffer.Data, layout->VtxBuffer.Data, (size_t)vtx_count * sizeof(ImDrawVert));
+		memcpy((char*)(run->VtxBuffer.Data + vtx_count), text, (size_t)key.TextLength);
+		run->Key = key;
+		run->Origin = origin;
+		run->Bb = ImRect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+		for (int n = 0; n < run->VtxBuffer.Size; n++)
+		{
+			ImDrawVert& v = run->VtxBuffer[n];
+			v.col = (v.col == IM_COL32_BLACK) ? 0 : ~IM_COL32_A_MASK;
+			run->Bb.Add(v.pos);
+		}
+	}
+	else
+	{
+		e.GlyphRunHits++;
+		if (origin.x != run->Origin.x || origin.y != run->Origin.y)
+		{
+			const ImVec2 delta(origin.x - run->Origin.x, origin.y - run->Origin.y);
+			TranslateVerts(run->VtxBuffer.Data, run->VtxBuffer.Data + run->VtxBuffer.Size, delta);
+			run->Bb.Translate(delta);
+			run->Origin = origin;
+		}
+	}
+	run->LastFrame = GImGui->FrameCount;
+	if (ImExtRenderCacheEntry* entry = e.RecordEntry)
+		if (entry->GlyphRunIdsCount < IM_ARRAYSIZE(entry->GlyphRunIds))
+			entry->GlyphRunIds[entry->GlyphRunIdsCount++] = run_id;
+
+	ImVec4 clip_rect = draw_list->_CmdHeader.ClipRect;
+	if (cpu_fine_clip_rect)
+	{
+		clip_rect.x = ImMax(clip_rect.x, cpu_fine_clip_rect->x);
+		clip_rect.y = ImMax(clip_rect.y, cpu_fine_clip_rect->y);
+		clip_rect.z = ImMin(clip_rect.z, cpu_fine_clip_rect->z);
+		clip_rect.w = ImMin(clip_rect.w, cpu_fine_clip_rect->w);
+	}
+	const ImRect& bb = run->Bb;
+	if (run->VtxBuffer.Size == 0 || bb.Min.x > clip_rect.z || bb.Max.x < clip_rect.x || bb.Min.y > clip_rect.w || bb.Max.y < clip_rect.y)
+		return;
+	const bool fully_visible = bb.Min.x >= clip_rect.x && bb.Min.y >= clip_rect.y && bb.Max.x <= clip_rect.z && bb.Max.y <= clip_rect.w;
+	const bool split = bb.Min.x < split_x && bb.Max.x > split_x;
+	if (!split && bb.Min.x >= split_x)
+		col = col_split;
+	const ImVec4* fine_clip_rect = cpu_fine_clip_rect ? &clip_rect : NULL;
+
+	// Straddling quads are emitted twice
+	const int quads_count = run->VtxBuffer.Size / 4;
+	const int quads_max = split ? quads_count * 2 : quads_count;
+	draw_list->PrimReserve(quads_max * 6, quads_max * 4);
+	ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+	ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+	unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+	const ImDrawVert* vtx_read = run->VtxBuffer.Data;
+	if (fully_visible && !split) // Copied whole, the clipped runs go quad by quad
+	{
+		CopyVertsOrColor(vtx_write, vtx_read, quads_count * 4, col);
+		vtx_write += quads_count * 4;
+		for (int n = 0; n < quads_count; n++, idx_write += 6, vtx_current_idx += 4)
+		{
+			idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx + 1); idx_write[2] = (ImDrawIdx)(vtx_current_idx + 2);
+			idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx + 2); idx_write[5] = (ImDrawIdx)(vtx_current_idx + 3);
+		}
+	}
+	else
+	{
+		for (int n = 0; n < quads_count; n++, vtx_read += 4)
+		{
+			const float x1 = vtx_read[0].pos.x, y1 = vtx_read[0].pos.y, x2 = vtx_read[2].pos.x, y2 = vtx_read[2].pos.y;
+			if (x1 > clip_rect.z || x2 < clip_rect.x || y1 > clip_rect.w || y2 < clip_rect.y)
+				continue;
+			const float u1 = vtx_read[0].uv.x, v1 = vtx_read[0].uv.y, u2 = vtx_read[2].uv.x, v2 = vtx_read[2].uv.y;
+			if (split && x1 < split_x && x2 > split_x)
+			{
+				const float u_split = u1 + ((split_x - x1) / (x2 - x1)) * (u2 - u1);
+				if (PrimGlyphQuad(vtx_write, idx_write, vtx_current_idx, x1, y1, split_x, y2, u1, v1, u_split, v2, col | vtx_read[0].col, fine_clip_rect))
+				{
+					vtx_write += 4;
+					idx_write += 6;
+					vtx_current_idx += 4;
+				}
+				if (PrimGlyphQuad(vtx_write, idx_write, vtx_current_idx, split_x, y1, x2, y2, u_split, v1, u2, v2, col_split | vtx_read[0].col, fine_clip_rect))
+				{
+					vtx_write += 4;
+					idx_write += 6;
+					vtx_current_idx += 4;
+				}
+				continue;
+			}
+			const ImU32 glyph_col = ((split && x1 >= split_x) ? col_split : col) | vtx_read[0].col;
+			if (PrimGlyphQuad(vtx_write, idx_write, vtx_current_idx, x1, y1, x2, y2, u1, v1, u2, v2, glyph_col, fine_clip_rect))
+			{
+				vtx_write += 4;
+				idx_write += 6;
+				vtx_current_idx += 4;
+			}
+		}
+	}
+
+	// Give back the culled quads
+	const int quads_written = (int)(vtx_write - draw_list->_VtxWritePtr) / 4;
+	draw_list->_VtxWritePtr = vtx_write;
+	draw_list->_IdxWritePtr = idx_write;
+	draw_list->_VtxCurrentIdx = vtx_current_idx;
+	if (quads_written < quads_max)
+		draw_list->PrimUnreserve((quads_max - quads_written) * 6, (quads_max - quads_written) * 4);
+}
+
+static void RenderTextClippedSplit(ImDrawList* draw_list, const ImVec2& pos_min, const ImVec2& pos_max, const char* text, const char* text_display_end, const ImVec2* text_size_if_known, ImU32 color, float split_x, ImU32 color_split, const ImVec2& align, const ImRect* clip_rect)
+{
+	// Perform CPU side clipping for single clipped element to avoid using scissor state
+	ImVec2 pos = pos_min;
+	const ImVec2 text_size = text_size_if_known ? *text_size_if_known : CalcTextSizeFast(text, text_display_end);
+
+	const ImVec2* clip_min = clip_rect ? &clip_rect->Min : &pos_min;
+	const ImVec2* clip_max = clip_rect ? &clip_rect->Max : &pos_max;
+	bool need_clipping = (pos.x + text_size.x >= clip_max->x) || (pos.y + text_size.y >= clip_max->y);
+	if (clip_rect) // If we had no explicit clipping rectangle then pos==clip_min
+		need_clipping |= (pos.x < clip_min->x) || (pos.y < clip_min->y);
+
+	// Align whole block. We should defer that to the better rendering function when we'll have support for individual line alignment.
+	if (align.x > 0.0f) pos.x = ImMax(pos.x, pos.x + (pos_max.x - pos.x - text_size.x) * align.x);
+	if (align.y > 0.0f) pos.y = ImMax(pos.y, pos.y + (pos_max.y - pos.y - text_size.y) * align.y);
+
+	// Render
+	if (need_clipping)
+	{
+		ImVec4 fine_clip_rect(clip_min->x, clip_min->y, clip_max->x, clip_max->y);
+		AddTextCached(draw_list, pos, color, text, text_display_end, 0.0f, &fine_clip_rect, split_x, color_split);
+	}
+	else
+	{
+		AddTextCached(draw_list, pos, color, text, text_display_end, 0.0f, NULL, split_x, color_split);
+	}
+}
+
+void ImExt::ImDraw::RenderTextClippedEx(ImDrawList* draw_list, const ImVec2& pos_min, const ImVec2& pos_max, const char* text, const char* text_display_end, const ImVec2* text_size_if_known, const ImU32 color, const ImVec2& align, const ImRect* clip_rect)
+{
+	RenderTextClippedSplit(draw_list, pos_min, pos_max, text, text_display_end, text_size_if_known, color, FLT_MAX, color, align, clip_rect);
+}
+
+void ImExt::ImDraw::RenderTextClippedTwoToneEx(ImDrawList* draw_list, const ImVec2& pos_min, const ImVec2& pos_max, const char* text, const char* text_display_end, const ImVec2* text_size_if_known, const float split_x, const ImU32 color_left, const ImU32 color_right, const ImVec2& align, const ImRect* clip_rect)
+{
+	RenderTextClippedSplit(draw_list, pos_min, pos_max, text, text_display_end, text_size_if_known, color_left, split_x, color_right, align, clip_rect);
+}
+
+void ImExt::ImDraw::RenderTextClipped(const ImVec2& pos_min, const ImVec2& pos_max, const char* text, const char* text_end, const ImVec2* text_size_if_known, const ImU32 color, const ImVec2& align, const ImRect* clip_rect)
+{
+	// Hide anything after a '##' string
+	const char* text_display_end = FindRenderedTextEnd(text, text_end);
+	const int text_len = (int)(text_display_end - text);
+	if (text_len == 0)
+		return;
+
+	ImGuiContext& g = *GImGui;
+	ImGuiWindow* window = g.CurrentWindow;
+	RenderTextClippedEx(window->DrawList, pos_min, pos_max, text, text_display_end, text_size_if_known, color, align, clip_rect);
+	if (g.LogEnabled)
+		LogRenderedText(&pos_min, text, text_display_end);
+}
+
+void ImExt::ImDraw::RenderTextClippedTwoTone(const ImVec2& pos_min, const ImVec2& pos_max, const char* text, const char* text_end, const ImVec2* text_size_if_known, const float split_x, const ImU32 color_left, const ImU32 color_right, const ImVec2& align, const ImRect* clip_rect)
+{
+	// Hide anything after a '##' string
+	const char* text_display_end = FindRenderedTextEnd(text, text_end);
+	const int text_len = (int)(text_display_end - text);
+	if (text_len == 0)
+		return;
+
+	ImGuiContext& g = *GImGui;
+	ImGuiWindow* window = g.CurrentWindow;
+	RenderTextClippedTwoToneEx(window->DrawList, pos_min, pos_max, text, text_display_end, text_size_if_known, split_x, color_left, color_right, align, clip_rect);
+	if (g.LogEnabled)
+		LogRenderedText(&pos_min, text, text_display_end);
+}
+#pragma endregion
+
+#pragma region Hash
+// ImHashStr() replacement for widget IDs: same CRC32 polynomial and "###" rule, so IDs don't change, but 8 bytes per step.
+// Opt-in with IMEXT_ENABLE_FAST_HASH. Uses the ARMv8 CRC32 instructions when available (checked at runtime on Linux),
+// slicing-by-8 tables otherwise. x86 SSE4.2 crc32 implements CRC32C, a different polynomial, and would change every ID.
+#ifdef IMEXT_ENABLE_FAST_HASH
+
+struct ImExtCrc32Tables
+{
+	ImU32 Lut[8][256];                  // Lut[n][c] = CRC of byte c followed by n zero bytes
+
+	ImExtCrc32Tables()
+	{
+		for (ImU32 c = 0; c < 256; c++)
+		{
+			ImU32 crc = c;
+			for (int bit = 0; bit < 8; bit++)
+				crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320u : 0u);
+			Lut[0][c] = crc;
+		}
+		for (int n = 1; n < 8; n++)
+			for (int c = 0; c < 256; c++)
+				Lut[n][c] = (Lut[n - 1][c] >> 8) ^ Lut[0][Lut[n - 1][c] & 0xFF];
+	}
+};
+
+static ImU32 Crc32Update(ImU32 crc, const unsigned char* data, size_t data_size)
+{
+	static const ImExtCrc32Tables tables;
+	const ImU32 (*lut)[256] = tables.Lut;
+	for (; data_size >= 8; data_size -= 8, data += 8)
+	{
+		ImU32 lo, hi; // Little-endian loads
+		memcpy(&lo, data, 4);
+		memcpy(&hi, data + 4, 4);
+		lo ^= crc;
+		crc = lut[7][lo & 0xFF] ^ lut[6][(lo >> 8) & 0xFF] ^ lut[5][(lo >> 16) & 0xFF] ^ lut[4][lo >> 24] ^
+			lut[3][hi & 0xFF] ^ lut[2][(hi >> 8) & 0xFF] ^ lut[1][(hi >> 16) & 0xFF] ^ lut[0][hi >> 24];
+	}
+	while (data_size-- != 0)
+		crc = (crc >> 8) ^ lut[0][(crc & 0xFF) ^ *data++];
+	return crc;
+}
+
+#ifdef IMEXT_CRC32_HW
+#ifdef IMEXT_CRC32_HW_RUNTIME_CHECK
+__attribute__((target("+crc")))
+#endif
+static ImU32 Crc32UpdateHw(ImU32 crc, const unsigned char* data, size_t data_size)
+{
+	for (; data_size >= 8; data_size -= 8, data += 8)
+	{
+		uint64_t v;
+		memcpy(&v, data, 8);
+		crc = __crc32d(crc, v);
+	}
+	while (data_size-- != 0)
+		crc = __crc32b(crc, *data++);
+	return crc;
+}
+#endif
+
+// Same result as ImHashStr()
+static ImGuiID HashStr(const char* data, size_t data_size, ImU32 seed)
+{
+	if (data_size == 0)
+		data_size = strlen(data);
+
+	// Hashing restarts from the seed at the last "###"
+	const char* data_end = data + data_size;
+	for (const char* p = data; (p = (const char*)memchr(p, '#', data_end - p)) != NULL; p++)
+		if (data_end - p >= 3 && p[1] == '#' && p[2] == '#')
+			data = p;
+
+#ifdef IMEXT_CRC32_HW
+#ifdef IMEXT_CRC32_HW_RUNTIME_CHECK
+	static const bool has_crc32 = (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+	if (has_crc32)
+#endif
+		return ~Crc32UpdateHw(~seed, (const unsigned char*)data, (size_t)(data_end - data));
+#endif
+	return ~Crc32Update(~seed, (const unsigned char*)data, (size_t)(data_end - data));
+}
+#else
+static ImGuiID HashStr(const char* data, size_t data_size, ImU32 seed)
+{
+	return ImHashStr(data, data_size, seed);
+}
+#endif
+#pragma endregion
+
+#pragma region Label
+// Widgets are implemented once in their Ex() version taking the ID and the end of the displayed label,
+// so that ImExtLabel overloads skip both the string hashing and the "##" scan.
+namespace ImExt
+{
+	static bool ButtonEx(ImGuiID id, const char* label, const char* label_end, const ImVec2& size, const float dt, ImGuiButtonFlags flags);
+	static bool ProgressButtonEx(ImGuiID id, const char* label, const char* label_end, bool* v, float* v_progress, const ImVec2& size, const float v_speed, const float dt, ImGuiButtonFlags flags);
+	static bool ToggleButtonEx(ImGuiID id, const char* label, const char* label_end, bool* v, const ImVec2& size, const float dt, ImGuiButtonFlags flags);
+	static bool ProgressToggleButtonEx(ImGuiID id, const char* label, const char* label_end, bool* v, float* v_progress, const ImVec2& size, const float v_speed, const float dt, ImGuiButtonFlags flags);
+	static bool ToggleSwitchEx(ImGuiID id, const char* label, const char* label_end, bool* v, const float dt);
+	static bool RadioButtonEx(ImGuiID id, const char* label, const char* label_end, bool active, const float dt);
+	static bool CheckboxEx(ImGuiID id, const char* label, const char* label_end, bool* v, const float dt);
+	static bool TaskButtonEx(ImGuiID id, const char* label, const char* label_end, ImExtTaskFunc func, void* user_data, const ImVec2& size, const float dt, ImGuiButtonFlags flags);
+	static bool SliderScalarEx(ImGuiID id, const char* label, const char* label_end, ImGuiDataType data_type, void* p_data, const void* p_min, const void* p_max, const char* format, const float dt, ImGuiSliderFlags flags);
+	static bool DragScalarEx(ImGuiID id, const char* label, const char* label_end, ImGuiDataType data_type, void* p_data, float v_speed, const void* p_min, const void* p_max, const char* format, const float dt, ImGuiSliderFlags flags);
+	static void ProgressBarEx(ImGuiID id, const char* label, const char* label_end, float fraction, const ImVec2& size, const float dt, bool poll);
+	static void SpinnerEx(ImGuiID id, ImExtSpinnerType type, const ImVec2& size, const float dt);
+	static void AnimatedNumberEx(ImGuiID id, double value, const char* format, const float dt);
+	static void SparklineEx(ImGuiID id, const ImExtSparklineBuffer& buffer, const ImVec2& size, float scale_min, float scale_max, int samples_count, const float dt);
+	static void PlotEx(ImGuiID id, const char* label, const char* label_end, const ImExtPlotSeries& series, const ImVec2& size, const float dt);
+	static void LogViewEx(ImGuiID id, ImExtLogFile& file, const char* filter, const ImVec2& size, const float dt);
+	static bool TextEditorEx(ImGuiID id, ImExtTextBuffer& buffer, const ImVec2& size, const float dt, ImGuiInputTextFlags flags);
+	static bool TreeNodeEx(ImGuiID id, const char* label, const char* label_end, const float dt, ImGuiTreeNodeFlags flags);
+	static bool BeginComboEx(ImGuiID id, const char* label, const char* label_end, const char* preview_value, const ImVec2& size, const float dt, ImGuiComboFlags flags);
+}
+
+static ImVec2 CalcLabelSize(const char* label, const char* label_end)
+{
+	ImExt::RequestGlyphs(GImGui->Font, label, label_end);
+	return CalcTextSizeFast(label, label_end);
+}
+
+// Same result as ImHashStr(label.Text, 0, seed), see ImExtLabel
+static ImGuiID HashLabel(const ImExtLabel& label, ImU32 seed)
+{
+	seed = ~seed;
+	ImU32 crc = label.HashCrc;
+	for (int n = 0; n < 32; n++, seed >>= 1)
+		crc ^= label.HashSeedCols[n] & (0u - (seed & 1));
+	return ~crc;
+}
+
+// Same result as window->GetID(label)
+static ImGuiID GetLabelID(ImGuiWindow* window, const char* label)
+{
+	const ImGuiID id = HashStr(label, 0, window->IDStack.back());
+	ImGuiContext& g = *GImGui;
+	if (g.DebugHookIdInfo == id)
+		DebugHookIdInfo(id, ImGuiDataType_String, label, NULL);
+	return id;
+}
+
+static ImGuiID GetLabelID(ImGuiWindow* window, const ImExtLabel& label)
+{
+	const ImGuiID id = HashLabel(label, window->IDStack.back());
+	ImGuiContext& g = *GImGui;
+	if (g.DebugHookIdInfo == id)
+		DebugHookIdInfo(id, ImGuiDataType_String, label.Text, NULL);
+	return id;
+}
+#pragma endregion
+
+bool ImExt::ButtonEx(ImGuiID id, const char* label, const char* label_end, const ImVec2& size, const float dt, ImGuiButtonFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+
+	ImGuiContext& g = *GImGui;
+	const ImGuiStyle& style = g.Style;
+	const ImVec2 label_size = CalcLabelSize(label, label_end);
+
+	ImVec2 pos = window->DC.CursorPos;
+	if ((flags & ImGuiButtonFlags_AlignTextBaseLine) && style.FramePadding.y < window->DC.CurrLineTextBaseOffset) // Try to vertically align buttons that are smaller/have no padding so that text baseline matches (bit hacky, since it shouldn't be a flag)
+		pos.y += window->DC.CurrLineTextBaseOffset - style.FramePadding.y;
+	ImVec2 item_size = CalcItemSize(ImVec2(size.x, size.y + label_size.y),
+		label_size.x + style.FramePadding.x * 2.0f,
+		label_size.y + style.FramePadding.y * 2.0f);
+
+	const ImRect bb(pos, ImVec2(pos.x + item_size.x, pos.y + item_size.y));
+	ItemSize(item_size, style.FramePadding.y);
+	if (!ItemAdd(bb, id))
+		return false;
+
+	if (g.LastItemData.InFlags & ImGuiItemFlags_ButtonRepeat)
+		flags |= ImGuiButtonFlags_Repeat;
+
+	bool hovered, held;
+	bool pressed = ButtonBehavior(bb, id, &hovered, &held, flags);
+	if (pressed)
+		MarkItemEdited(id);
+
+	//Animation
+	float last_active_id_timer = g.LastActiveIdTimer;
+	if (held || pressed)
+		g.LastActiveIdTimer = 0.f;
+
+	if (g.LastActiveIdTimer == 0.f && g.LastActiveId == id && !pressed)
+		g.LastActiveIdTimer = last_active_id_timer;
+
+	float t = held ? 1.0f : 0.0f;
+
+	if (g.LastActiveId == id)
+	{
+		float t_anim = LodAnimationTime(ImSaturate(g.LastActiveIdTimer / 0.08f * dt));
+		t = held ? (t_anim) : (1.0f - t_anim);
+		ScheduleActiveIdAnimation(id, 0.08f / dt, item_size.x / 20.f);
+	}
+
+	// Pressed buttons shrink by up to 5% towards a third of their size: cached vertices are scaled, not re-tessellated
+	const float shrink = 1.0f - 0.05f * t;
+
+	// Render
+	const ImU32 col = GetColorU32((held && hovered) ? ImGuiCol_ButtonActive : hovered ? ImGuiCol_ButtonHovered : ImGuiCol_Button);
+	RenderNavHighlight(bb, id);
+	const ImVec2 pos_min = ImVec2(bb.Min.x + style.FramePadding.x / 2, bb.Min.y + style.FramePadding.y / 2);
+	const ImVec2 pos_max = ImVec2(bb.Max.x - style.FramePadding.x, bb.Max.y - style.FramePadding.y);
+	PushTransform(ImVec2(bb.Min.x + item_size.x / 3.0f, bb.Min.y + item_size.y / 3.0f), ImVec2(shrink, shrink));
+	if (!RenderCacheBegin(id, bb, RenderCacheKey(bb, label, label_end, &col, 1, NULL, 0)))
+	{
+		RenderFrame(pos_min, pos_max, col, true, style.FrameRounding);
+
+		if (g.LogEnabled)
+			LogSetNextTextDecoration("[", "]");
+		ImExt::ImDraw::RenderTextClipped(pos_min, pos_max, label, label_end, &label_size, GetColorU32(ImGuiCol_Text), style.ButtonTextAlign, &bb);
+		RenderCacheEnd();
+	}
+	PopTransform();
+
+	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags);
+	return pressed;
+}
+
+bool ImExt::Button(const char* label, const ImVec2& size, const float dt, ImGuiButtonFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return ButtonEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), size, dt, flags);
+}
+
+bool ImExt::Button(const ImExtLabel& label, const ImVec2& size, const float dt, ImGuiButtonFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return ButtonEx(GetLabelID(window, label), label.Text, label.TextEnd, size, dt, flags);
+}
+
+// Progress fill over a frame spanning pos_min..pos_max, and the label on top of it, laid out up to text_max_x
+static void RenderProgressFill(const ImVec2& pos_min, const ImVec2& pos_max, float text_max_x, const ImRect& bb, const char* label, const char* label_end, const ImVec2& label_size, float progress)
+{
+	const ImVec2 text_max(text_max_x, pos_max.y);
+	const ImGuiStyle& style = GImGui->Style;
+	if (progress > 0.0f)
+	{
+		// Label emitted once, glyphs over the progress fill in the inverted colour
+		const float progress_size = pos_min.x + progress * (pos_max.x - pos_min.x);
+		ImColor frame_color = ImColor(0.5f + progress / 2.f, 0.5f + progress / 2.f, 0.5f + progress / 2.f, progress);
+		ImColor text_color = ImColor(1.f - frame_color.Value.x, 1.f - frame_color.Value.y, 1.f - frame_color.Value.z, 1.0f);
+		RenderFrame(pos_min, ImVec2(progress_size, pos_max.y), frame_color, true, style.FrameRounding);
+		const ImU32 text_col = GetColorU32(ImGuiCol_Text);
+		const ImU32 fill_text_col = (GetExtContext().IO.LodLevel < ImExtLod_Minimal) ? GetColorU32(ImLerp(style.Colors[ImGuiCol_Text], text_color.Value, progress)) : text_col;
+		ImExt::ImDraw::RenderTextClippedTwoTone(pos_min, text_max, label, label_end, &label_size, progress_size, fill_text_col, text_col, style.ButtonTextAlign, &bb);
+	}
+	else
+	{
+		// Same glyph run as above
+		ImExt::ImDraw::RenderTextClipped(pos_min, text_max, label, label_end, &label_size, GetColorU32(ImGuiCol_Text), style.ButtonTextAlign, &bb);
+	}
+}
+
+bool ImExt::ProgressButtonEx(ImGuiID id, const char* label, const char* label_end, bool* v, float* v_progress, const ImVec2& size, const float v_speed, const float dt, ImGuiButtonFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+
+	ImGuiContext& g = *GImGui;
+	const ImGuiStyle& style = g.Style;
+	const ImVec2 label_size = CalcLabelSize(label, label_end);
+
+	ImVec2 pos = window->DC.CursorPos;
+	if ((flags & ImGuiButtonFlags_AlignTextBaseLine) && style.FramePadding.y < window->DC.CurrLineTextBaseOffset) // Try to vertically align buttons that are smaller/have no padding so that text baseline matches (bit hacky, since it shouldn't be a flag)
+		pos.y += window->DC.CurrLineTextBaseOffset - style.FramePadding.y;
+	ImVec2 item_size = CalcItemSize(ImVec2(size.x, size.y + label_size.y),
+		label_size.x + style.FramePadding.x * 2.0f,
+		label_size.y + style.FramePadding.y * 2.0f);
+
+	const ImRect bb(pos, ImVec2(pos.x + item_size.x, pos.y + item_size.y));
+	ItemSize(item_size, style.FramePadding.y);
+	if (!ItemAdd(bb, id))
+		return false;
+
+	if (g.LastItemData.InFlags & ImGuiItemFlags_ButtonRepeat)
+		flags |= ImGuiButtonFlags_Repeat;
+
+	bool hovered, held;
+	bool pressed = ButtonBehavior(bb, id, &hovered, &held, flags);
+	if (pressed)
+		MarkItemEdited(id);
+
+	//Animation
+	float last_active_id_timer = g.LastActiveIdTimer;
+	if (held || pressed)
+		g.LastActiveIdTimer = 0.f;
+
+	if (g.LastActiveIdTimer == 0.f && g.LastActiveId == id && !pressed)
+		g.LastActiveIdTimer = last_active_id_timer;
+
+	float t = held ? 1.0f : 0.0f;
+
+	if (g.LastActiveId == id)
+	{
+		float t_anim = LodAnimationTime(ImSaturate(g.LastActiveIdTimer / 0.08f * dt));
+		t = held ? (t_anim) : (1.0f - t_anim);
+		ScheduleActiveIdAnimation(id, 0.08f / dt, item_size.x / 20.f);
+	}
+
+	// Press effect, see ButtonEx()
+	const float shrink = 1.0f - 0.05f * t;
+
+	// Render
+	const ImU32 col = GetColorU32((held && hovered) ? ImGuiCol_ButtonActive : hovered ? ImGuiCol_ButtonHovered : ImGuiCol_Button);
+	if (v && v_progress)
+	{
+		if (*v_progress == 1.0f && pressed)
+			*v = !*v;
+
+		*v_progress = held ? (*v_progress < 1.0f ? *v_progress + v_speed : 1.0f) : 0.0f;
+		if (held && *v_progress < 1.0f) // Progress advances per frame
+			ScheduleAnimation(id, FLT_MAX, FLT_MAX);
+	}
+	const float progress = (v && v_progress) ? *v_progress : 0.0f;
+
+	RenderNavHighlight(bb, id);
+	const ImVec2 pos_min = ImVec2(bb.Min.x + style.FramePadding.x / 2, bb.Min.y + style.FramePadding.y / 2);
+	const ImVec2 pos_max = ImVec2(bb.Max.x - style.FramePadding.x, bb.Max.y - style.FramePadding.y);
+	PushTransform(ImVec2(bb.Min.x + item_size.x / 3.0f, bb.Min.y + item_size.y / 3.0f), ImVec2(shrink, shrink));
+	if (!RenderCacheBegin(id, bb, RenderCacheKey(bb, label, label_end, &col, 1, &progress, 1)))
+	{
+		RenderFrame(pos_min, pos_max, col, true, style.FrameRounding);
+
+		if (g.LogEnabled)
+			LogSetNextTextDecoration("[", "]");
+		RenderProgressFill(pos_min, pos_max, pos_max.x, bb, label, label_end, label_size, progress);
+		RenderCacheEnd();
+	}
+	PopTransform();
+
+	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags);
+	return pressed;
+}
+
+bool ImExt::ProgressButton(const char* label, bool* v, float* v_progress, const ImVec2& size, const float v_speed, const float dt, ImGuiButtonFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return ProgressButtonEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), v, v_progress, size, v_speed, dt, flags);
+}
+
+bool ImExt::ProgressButton(const ImExtLabel& label, bool* v, float* v_progress, const ImVec2& size, const float v_speed, const float dt, ImGuiButtonFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return ProgressButtonEx(GetLabelID(window, label), label.Text, label.TextEnd, v, v_progress, size, v_speed, dt, flags);
+}
+
+bool ImExt::ToggleButtonEx(ImGuiID id, const char* label, const char* label_end, bool* v, const ImVec2& size, const float dt, ImGuiButtonFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+
+	ImGuiContext& g = *GImGui;
+	const ImGuiStyle& style = g.Style;
+	const ImVec2 label_size = CalcLabelSize(label, label_end);
+
+	ImVec2 pos = window->DC.CursorPos;
+	if ((flags & ImGuiButtonFlags_AlignTextBaseLine) && style.FramePadding.y < window->DC.CurrLineTextBaseOffset) // Try to vertically align buttons that are smaller/have no padding so that text baseline matches (bit hacky, since it shouldn't be a flag)
+		pos.y += window->DC.CurrLineTextBaseOffset - style.FramePadding.y;
+	ImVec2 item_size = CalcItemSize(ImVec2(size.x, size.y + label_size.y),
+		label_size.x + style.FramePadding.x * 2.0f, label_size.y + style.FramePadding.y * 2.0f);
+
+	const ImRect bb(pos, ImVec2(pos.x + item_size.x, pos.y + item_size.y));
+	ItemSize(item_size, style.FramePadding.y);
+	if (!ItemAdd(bb, id))
+		return false;
+
+	if (g.LastItemData.InFlags & ImGuiItemFlags_ButtonRepeat)
+		flags |= ImGuiButtonFlags_Repeat;
+
+	bool hovered, held;
+	bool pressed = ButtonBehavior(bb, id, &hovered, &held, flags);
+	if (pressed)
+	{
+		*v = !(*v);
+		MarkItemEdited(id);
+	}
+
+	// Animation
+	float last_active_id_timer = g.LastActiveIdTimer;
+	if (held || pressed)
+		g.LastActiveIdTimer = 0.f;
+
+	if (g.LastActiveIdTimer == 0.f && g.LastActiveId == id && !pressed)
+		g.LastActiveIdTimer = last_active_id_timer;
+
+	float t = held ? 1.0f : 0.0f;
+
+	if (g.LastActiveId == id)
+	{
+		float t_anim = LodAnimationTime(ImSaturate(g.LastActiveIdTimer / 0.08f * dt));
+		t = held ? (t_anim) : (1.0f - t_anim);
+		ScheduleActiveIdAnimation(id, 0.08f / dt, item_size.x / 20.f);
+	}
+
+	// Press effect, see ButtonEx()
+	const float shrink = 1.0f - 0.05f * t;
+
+	// Render
+	const ImU32 col = *v ? GetColorU32(ImGuiCol_ButtonActive) : GetColorU32((held && hovered) ? ImGuiCol_ButtonActive : hovered ? ImGuiCol_ButtonHovered : ImGuiCol_Button);
+	RenderNavHighlight(bb, id);
+	const ImVec2 pos_min = ImVec2(bb.Min.x + style.FramePadding.x / 2, bb.Min.y + style.FramePadding.y / 2);
+	const ImVec2 pos_max = ImVec2(bb.Max.x - style.FramePadding.x, bb.Max.y - style.FramePadding.y);
+	PushTransform(ImVec2(bb.Min.x + item_size.x / 3.0f, bb.Min.y + item_size.y / 3.0f), ImVec2(shrink, shrink));
+	if (!RenderCacheBegin(id, bb, RenderCacheKey(bb, label, label_end, &col, 1, NULL, 0)))
+	{
+		RenderFrame(pos_min, pos_max, col, true, style.FrameRounding);
+
+		if (g.LogEnabled)
+			LogSetNextTextDecoration("[", "]");
+		ImExt::ImDraw::RenderTextClipped(pos_min, pos_max, label, label_end, &label_size, GetColorU32(ImGuiCol_Text), style.ButtonTextAlign, &bb);
+		RenderCacheEnd();
+	}
+	PopTransform();
+
+	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags);
+	return pressed;
+}
+
+bool ImExt::ToggleButton(const char* label, bool* v, const ImVec2& size, const float dt, ImGuiButtonFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return ToggleButtonEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), v, size, dt, flags);
+}
+
+bool ImExt::ToggleButton(const ImExtLabel& label, bool* v, const ImVec2& size, const float dt, ImGuiButtonFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return ToggleButtonEx(GetLabelID(window, label), label.Text, label.TextEnd, v, size, dt, flags);
+}
+
+bool ImExt::ProgressToggleButtonEx(ImGuiID id, const char* label, const char* label_end, bool* v, float* v_progress, const ImVec2& size, const float v_speed, const float dt, ImGuiButtonFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+
+	ImGuiContext& g = *GImGui;
+	const ImGuiStyle& style = g.Style;
+	const ImVec2 label_size = CalcLabelSize(label, label_end);
+
+	ImVec2 pos = window->DC.CursorPos;
+	if ((flags & ImGuiButtonFlags_AlignTextBaseLine) && style.FramePadding.y < window->DC.CurrLineTextBaseOffset) // Try to vertically align buttons that are smaller/have no padding so that text baseline matches (bit hacky, since it shouldn't be a flag)
+		pos.y += window->DC.CurrLineTextBaseOffset - style.FramePadding.y;
+	ImVec2 item_size = CalcItemSize(ImVec2(size.x, size.y + label_size.y),
+		label_size.x + style.FramePadding.x * 2.0f, label_size.y + style.FramePadding.y * 2.0f);
+
+	const ImRect bb(pos, ImVec2(pos.x + item_size.x, pos.y + item_size.y));
+	ItemSize(item_size, style.FramePadding.y);
+	if (!ItemAdd(bb, id))
+		return false;
+
+	if (g.LastItemData.InFlags & ImGuiItemFlags_ButtonRepeat)
+		flags |= ImGuiButtonFlags_Repeat;
+
+	bool hovered, held;
+	bool pressed = ButtonBehavior(bb, id, &hovered, &held, flags);
+	if (pressed)
+		MarkItemEdited(id);
+
+	// Animation
+	float last_active_id_timer = g.LastActiveIdTimer;
+	if (held || pressed)
+		g.LastActiveIdTimer = 0.f;
+
+	if (g.LastActiveIdTimer == 0.f && g.LastActiveId == id && !pressed)
+		g.LastActiveIdTimer = last_active_id_timer;
+
+	float t = held ? 1.0f : 0.0f;
+
+	if (g.LastActiveId == id)
+	{
+		float t_anim = LodAnimationTime(ImSaturate(g.LastActiveIdTimer / 0.08f * dt));
+		t = held ? (t_anim) : (1.0f - t_anim);
+		ScheduleActiveIdAnimation(id, 0.08f / dt, item_size.x / 20.f);
+	}
+
+	// Press effect, see ButtonEx()
+	const float shrink = 1.0f - 0.05f * t;
+
+	// Render
+	const ImU32 col = *v ? GetColorU32(ImGuiCol_ButtonActive) : GetColorU32((held && hovered) ? ImGuiCol_ButtonActive : hovered ? ImGuiCol_ButtonHovered : ImGuiCol_Button);
+	if (v && v_progress)
+	{
+		if (*v_progress == 1.0f && pressed)
+			*v = !*v;
+
+		*v_progress = held ? (*v_progress < 1.0f ? *v_progress + v_speed : 1.0f) : 0.0f;
+		if (held && *v_progress < 1.0f) // Progress advances per frame
+			ScheduleAnimation(id, FLT_MAX, FLT_MAX);
+	}
+	const float progress = (v && v_progress) ? *v_progress : 0.0f;
+
+	RenderNavHighlight(bb, id);
+	const ImVec2 pos_min = ImVec2(bb.Min.x + style.FramePadding.x / 2, bb.Min.y + style.FramePadding.y / 2);
+	const ImVec2 pos_max = ImVec2(bb.Max.x - style.FramePadding.x, bb.Max.y - style.FramePadding.y);
+	PushTransform(ImVec2(bb.Min.x + item_size.x / 3.0f, bb.Min.y + item_size.y / 3.0f), ImVec2(shrink, shrink));
+	if (!RenderCacheBegin(id, bb, RenderCacheKey(bb, label, label_end, &col, 1, &progress, 1)))
+	{
+		RenderFrame(pos_min, pos_max, col, true, style.FrameRounding);
+
+		if (g.LogEnabled)
+			LogSetNextTextDecoration("[", "]");
+		RenderProgressFill(pos_min, pos_max, pos_max.x, bb, label, label_end, label_size, progress);
+		RenderCacheEnd();
+	}
+	PopTransform();
+
+	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags);
+	return pressed;
+}
+
+bool ImExt::ProgressToggleButton(const char* label, bool* v, float* v_progress, const ImVec2& size, const float v_speed, const float dt, ImGuiButtonFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return ProgressToggleButtonEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), v, v_progress, size, v_speed, dt, flags);
+}
+
+bool ImExt::ProgressToggleButton(const ImExtLabel& label, bool* v, float* v_progress, const ImVec2& size, const float v_speed, const float dt, ImGuiButtonFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return ProgressToggleButtonEx(GetLabelID(window, label), label.Text, label.TextEnd, v, v_progress, size, v_speed, dt, flags);
+}
+
+bool ImExt::ToggleSwitchEx(ImGuiID id, const char* label, const char* label_end, bool* v, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+
+	ImGuiContext& g = *GImGui;
+	const ImGuiStyle& style = g.Style;
+	const ImVec2 label_size = CalcLabelSize(label, label_end);
+
+	float height = ImGui::GetFrameHeight();
+	const ImVec2 pos = window->DC.CursorPos;
+
+	float width = height * 2.f;
+	float radius = height * 0.50f;
+
+	const ImRect total_bb(pos, ImVec2(pos.x + width + (label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f), pos.y + label_size.y + style.FramePadding.y * 2.0f));
+
+	ItemSize(total_bb, style.FramePadding.y);
+	if (!ItemAdd(total_bb, id))
+		return false;
+
+	float last_active_id_timer = g.LastActiveIdTimer;
+
+	bool hovered, held;
+	bool pressed = ButtonBehavior(total_bb, id, &hovered, &held);
+	if (pressed)
+	{
+		*v = !(*v);
+		MarkItemEdited(id);
+		g.LastActiveIdTimer = 0.f;
+	}
+
+	if (g.LastActiveIdTimer == 0.f && g.LastActiveId == id && !pressed)
+		g.LastActiveIdTimer = last_active_id_timer;
+
+	float t = *v ? 1.0f : 0.0f;
+	float circle_t = held ? 1.0f : 0.0f;
+
+	if (g.LastActiveId == id)
+	{
+		float t_anim = LodAnimationTime(ImSaturate(g.LastActiveIdTimer / 0.16f * dt));
+		t = *v ? (t_anim) : (1.0f - t_anim);
+		circle_t = held ? (t_anim) : (1.0f - t_anim);
+		ScheduleActiveIdAnimation(id, 0.16f / dt, width - radius * 2.0f);
+	}
+
+	ImU32 col_bg = GetColorU32((held && hovered) ? ImGuiCol_FrameBgActive : hovered ? ImGuiCol_FrameBgHovered : ImGuiCol_FrameBg);
+
+	const ImRect frame_bb(pos, ImVec2(pos.x + width, pos.y + height));
+
+	RenderNavHighlight(total_bb, id);
+	const float render_values[] = { t, circle_t };
+	if (!RenderCacheBegin(id, total_bb, RenderCacheKey(total_bb, label, label_end, &col_bg, 1, render_values, IM_ARRAYSIZE(render_values))))
+	{
+		RenderFrame(frame_bb.Min, frame_bb.Max, col_bg, true, height * 0.5f);
+
+		ImVec2 label_pos = ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, frame_bb.Min.y + style.FramePadding.y);
+		RenderText(label_pos, label, label_end, false);
+		window->DrawList->AddCircleFilled(ImVec2(pos.x + radius + t * (width - radius * 2.0f), pos.y + radius), radius - (circle_t * radius) / 5.f, ImGui::GetColorU32(ImGuiCol_CheckMark), LodCircleSegments(16));
+		RenderCacheEnd();
+	}
+
+	return pressed;
+}
+
+bool ImExt::ToggleSwitch(const char* label, bool* v, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return ToggleSwitchEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), v, dt);
+}
+
+bool ImExt::ToggleSwitch(const ImExtLabel& label, bool* v, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return ToggleSwitchEx(GetLabelID(window, label), label.Text, label.TextEnd, v, dt);
+}
+
+bool ImExt::RadioButtonEx(ImGuiID id, const char* label, const char* label_end, bool active, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+
+	ImGuiContext& g = *GImGui;
+	const ImGuiStyle& style = g.Style;
+	const ImVec2 label_size = CalcLabelSize(label, label_end);
+
+	const float square_sz = GetFrameHeight();
+	const ImVec2 pos = window->DC.CursorPos;
+	const ImRect total_bb(pos, ImVec2(pos.x + square_sz + (label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f), pos.y + label_size.y + style.FramePadding.y * 2.0f));
+	ItemSize(total_bb, style.FramePadding.y);
+	if (!ItemAdd(total_bb, id))
+		return false;
+
+	bool hovered, held;
+	bool pressed = ButtonBehavior(total_bb, id, &hovered, &held);
+	if (pressed)
+		MarkItemEdited(id);
+
+	// Animation
+	float last_active_id_timer = g.LastActiveIdTimer;
+	if (held || pressed)
+		g.LastActiveIdTimer = 0.f;
+
+	if (g.LastActiveIdTimer == 0.f && g.LastActiveId == id && !pressed)
+		g.LastActiveIdTimer = last_active_id_timer;
+
+	float t = active ? 1.0f : 0.0f;
+	float circle_t = held ? 1.0f : 0.0f;
+
+	if (g.LastActiveId == id)
+	{
+		float t_anim = LodAnimationTime(ImSaturate(g.LastActiveIdTimer / 0.16f * dt));
+		t = active ? (t_anim) : (1.0f - t_anim);
+		circle_t = held ? (t_anim) : (1.0f - t_anim);
+		ScheduleActiveIdAnimation(id, 0.16f / dt, square_sz * 0.5f);
+	}
+
+	// Render
+	const ImRect check_bb(pos, ImVec2(pos.x + square_sz, pos.y + square_sz));
+	ImVec2 center = check_bb.GetCenter();
+	center.x = IM_ROUND(center.x);
+	center.y = IM_ROUND(center.y);
+	const float radius = (square_sz - 1.0f) * 0.5f;
+
+	RenderNavHighlight(total_bb, id);
+	const ImU32 col_bg = GetColorU32((held && hovered) ? ImGuiCol_FrameBgActive : hovered ? ImGuiCol_FrameBgHovered : ImGuiCol_FrameBg);
+	const float render_values[] = { active ? t : 0.0f, circle_t };
+	if (!RenderCacheBegin(id, total_bb, RenderCacheKey(total_bb, label, label_end, &col_bg, 1, render_values, IM_ARRAYSIZE(render_values))))
+	{
+		window->DrawList->AddCircleFilled(center, radius - (circle_t * radius) / 5.f, col_bg, LodCircleSegments(16));
+		if (active)
+		{
+			const float pad = ImMax(1.0f, IM_FLOOR(square_sz / 6.0f));
+			window->DrawList->AddCircleFilled(center, (radius - pad) * t, GetColorU32(ImGuiCol_CheckMark), LodCircleSegments(16));
+		}
+
+		if (style.FrameBorderSize > 0.0f)
+		{
+			window->DrawList->AddCircle(ImVec2(center.x + 1, center.y + 1), radius, GetColorU32(ImGuiCol_BorderShadow), LodCircleSegments(16), style.FrameBorderSize);
+			window->DrawList->AddCircle(center, radius, GetColorU32(ImGuiCol_Border), LodCircleSegments(16), style.FrameBorderSize);
+		}
+
+		ImVec2 label_pos = ImVec2(check_bb.Max.x + style.ItemInnerSpacing.x, check_bb.Min.y + style.FramePadding.y);
+		if (g.LogEnabled)
+			LogRenderedText(&label_pos, active ? "(x)" : "( )");
+		if (label_size.x > 0.0f)
+			RenderText(label_pos, label, label_end, false);
+		RenderCacheEnd();
+	}
+
+	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags);
+	return pressed;
+}
+
+bool ImExt::RadioButton(const char* label, bool active, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return RadioButtonEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), active, dt);
+}
+
+bool ImExt::RadioButton(const ImExtLabel& label, bool active, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return RadioButtonEx(GetLabelID(window, label), label.Text, label.TextEnd, active, dt);
+}
+
+bool ImExt::RadioButton(const char* label, int* v, int v_button, const float dt)
+{
+	const bool pressed = RadioButton(label, *v == v_button, dt);
+	if (pressed)
+		*v = v_button;
+	return pressed;
+}
+
+bool ImExt::RadioButton(const ImExtLabel& label, int* v, int v_button, const float dt)
+{
+	const bool pressed = RadioButton(label, *v == v_button, dt);
+	if (pressed)
+		*v = v_button;
+	return pressed;
+}
+
+bool ImExt::CheckboxEx(ImGuiID id, const char* label, const char* label_end, bool* v, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+
+	ImGuiContext& g = *GImGui;
+	const ImGuiStyle& style = g.Style;
+	const ImVec2 label_size = CalcLabelSize(label, label_end);
+
+	const float square_sz = GetFrameHeight();
+	const ImVec2 pos = window->DC.CursorPos;
+	const ImRect total_bb(pos, ImVec2(pos.x + square_sz + (label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f), pos.y + label_size.y + style.FramePadding.y * 2.0f));
+	ItemSize(total_bb, style.FramePadding.y);
+	if (!ItemAdd(total_bb, id))
+	{
+		IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags | ImGuiItemStatusFlags_Checkable | (*v ? ImGuiItemStatusFlags_Checked : 0));
+		return false;
+	}
+
+	bool hovered, held;
+	bool pressed = ButtonBehavior(total_bb, id, &hovered, &held);
+
+	if (pressed)
+	{
+		*v = !(*v);
+		MarkItemEdited(id);
+	}
+
+	// Animation
+	float last_active_id_timer = g.LastActiveIdTimer;
+	if (held || pressed)
+		g.LastActiveIdTimer = 0.f;
+
+	if (g.LastActiveIdTimer == 0.f && g.LastActiveId == id && !pressed)
+		g.LastActiveIdTimer = last_active_id_timer;
+
+	float t = held ? 1.0f : 0.0f;
+	float mark_t = *v ? 1.0f : 0.0f;
+
+	if (g.LastActiveId == id)
+	{
+		float t_anim = LodAnimationTime(ImSaturate(g.LastActiveIdTimer / 0.16f * dt));
+		t = held ? (t_anim) : (1.0f - t_anim);
+		mark_t = *v ? (t_anim) : (0.0f);
+		ScheduleActiveIdAnimation(id, 0.16f / dt, square_sz);
+	}
+
+	const float scale = 5.f * t;
+	const ImRect check_bb(pos, ImVec2(pos.x + square_sz, pos.y + square_sz));
+	const ImRect rect_bb(ImVec2(pos.x + scale / 2, pos.y + scale / 2), ImVec2(pos.x + square_sz - scale, pos.y + square_sz - scale));
+
+	RenderNavHighlight(total_bb, id);
+	const ImU32 col_bg = GetColorU32((held && hovered) ? ImGuiCol_FrameBgActive : hovered ? ImGuiCol_FrameBgHovered : ImGuiCol_FrameBg);
+	ImU32 check_col = GetColorU32(ImGuiCol_CheckMark);
+	bool mixed_value = (g.LastItemData.InFlags & ImGuiItemFlags_MixedValue) != 0;
+	const float render_values[] = { t, (*v || mark_t > 0.f) ? mark_t : -1.0f, mixed_value ? 1.0f : 0.0f };
+	if (!RenderCacheBegin(id, total_bb, RenderCacheKey(total_bb, label, label_end, &col_bg, 1, render_values, IM_ARRAYSIZE(render_values))))
+	{
+		RenderFrame(rect_bb.Min, rect_bb.Max, col_bg, true, style.FrameRounding);
+		if (mixed_value)
+		{
+			// Undocumented tristate/mixed/indeterminate checkbox (#2644)
+			// This may seem awkwardly designed because the aim is to make ImGuiItemFlags_MixedValue supported by all widgets (not just checkbox)
+			ImVec2 pad(ImMax(1.0f, IM_FLOOR(square_sz / 3.6f)), ImMax(1.0f, IM_FLOOR(square_sz / 3.6f)));
+			const ImVec2 pos_min = ImVec2(rect_bb.Min.x + pad.x + scale, rect_bb.Min.y + pad.y + scale);
+			const ImVec2 pos_max = ImVec2(rect_bb.Max.x - pad.x + scale, rect_bb.Max.y - pad.y + scale);
+			window->DrawList->AddRectFilled(pos_min, pos_max, check_col, style.FrameRounding);
+		}
+		else if (*v || mark_t > 0.f)
+		{
+			const float pad = ImMax(1.0f, IM_FLOOR(square_sz / 6.0f));
+			const ImVec2 pos_min = ImVec2(check_bb.Min.x + pad, check_bb.Min.y + pad);
+
+			float sz = square_sz - pad * 2.0f;
+			float thickness = ImMax(sz * mark_t / 5.0f, 1.0f) * mark_t;
+			sz -= thickness * 0.5f;
+			const ImVec2 mark_pos = ImVec2(pos_min.x + thickness * 0.25f, pos_min.y + thickness * 0.25f);
+
+			float third = sz / 3.0f;
+			float bx = mark_pos.x + third;
+			float by = mark_pos.y + sz - third * 0.5f;
+			window->DrawList->PathLineTo(ImVec2(bx - third, by - third));
+			window->DrawList->PathLineTo(ImVec2(bx, by));
+			window->DrawList->PathLineTo(ImVec2(bx + third * 2.0f, by - third * 2.0f));
+			window->DrawList->PathStroke(check_col, 0, thickness);
+		}
+
+		ImVec2 label_pos = ImVec2(check_bb.Max.x + style.ItemInnerSpacing.x, check_bb.Min.y + style.FramePadding.y);
+		if (g.LogEnabled)
+			LogRenderedText(&label_pos, mixed_value ? "[~]" : *v ? "[x]" : "[ ]");
+		if (label_size.x > 0.0f)
+			RenderText(label_pos, label, label_end, false);
+		RenderCacheEnd();
+	}
+
+	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags | ImGuiItemStatusFlags_Checkable | (*v ? ImGuiItemStatusFlags_Checked : 0));
+	return pressed;
+}
+
+bool ImExt::Checkbox(const char* label, bool* v, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return CheckboxEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), v, dt);
+}
+
+bool ImExt::Checkbox(const ImExtLabel& label, bool* v, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return CheckboxEx(GetLabelID(window, label), label.Text, label.TextEnd, v, dt);
+}
+
+// Displayed progress 'shown' eases exponentially toward 'target' and snaps within half of ImExtIO::AnimationMinPixelDelta, over a 'width' pixels fill
+static float AnimateProgress(ImGuiID id, float shown, float target, float width, const float dt)
+{
+	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
+	const float rate = 10.0f * dt;
+	const float snap_distance = ImMax(e.IO.AnimationMinPixelDelta * 0.5f, 0.01f);
+	const float distance = ImFabs(target - shown) * width;
+	if (distance <= snap_distance || e.IO.LodLevel >= ImExtLod_Minimal)
+		return target;
+	ScheduleAnimation(id, ImLog(distance / snap_distance) / rate, distance * rate);
+	return ImLerp(shown, target, 1.0f - expf(-rate * g.IO.DeltaTime));
+}
+
+// 'poll': the value is written by other threads, nothing wakes an event-driven host when it changes
+void ImExt::ProgressBarEx(ImGuiID id, const char* label, const char* label_end, float fraction, const ImVec2& size, const float dt, bool poll)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	ImGuiContext& g = *GImGui;
+	const ImGuiStyle& style = g.Style;
+
+	const ImVec2 item_size = CalcItemSize(size, CalcItemWidth(), g.FontSize + style.FramePadding.y * 2.0f);
+	const ImRect bb(window->DC.CursorPos, ImVec2(window->DC.CursorPos.x + item_size.x, window->DC.CursorPos.y + item_size.y));
+	ItemSize(item_size, style.FramePadding.y);
+
+	fraction = ImSaturate(fraction);
+	ImGuiStorage* storage = window->DC.StateStorage;
+	float progress = storage->GetFloat(id, fraction);
+	if (!ItemAdd(bb, id)) // Clipped bars jump to the value and request no frames
+	{
+		storage->SetFloat(id, fraction);
+		return;
+	}
+	progress = AnimateProgress(id, progress, fraction, item_size.x, dt);
+	if (poll && progress == fraction && fraction < 1.0f)
+		ScheduleAnimation(id, 0.1f, 0.0f);
+	storage->SetFloat(id, progress);
+
+	char overlay[16];
+	if (label == label_end)
+	{
+		ImFormatString(overlay, IM_ARRAYSIZE(overlay), "%.0f%%", progress * 100.0f + 0.01f);
+		label = overlay;
+		label_end = overlay + strlen(overlay);
+	}
+	const ImVec2 label_size = CalcLabelSize(label, label_end);
+
+	const ImU32 col = GetColorU32(ImGuiCol_FrameBg);
+	if (!RenderCacheBegin(id, bb, RenderCacheKey(bb, label, label_end, &col, 1, &progress, 1)))
+	{
+		RenderFrame(bb.Min, bb.Max, col, true, style.FrameRounding);
+		RenderProgressFill(bb.Min, bb.Max, bb.Max.x, bb, label, label_end, label_size, progress);
+		RenderCacheEnd();
+	}
+}
+
+void ImExt::ProgressBar(const char* label, float fraction, const ImVec2& size, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return;
+	ProgressBarEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), fraction, size, dt, false);
+}
+
+void ImExt::ProgressBar(const char* label, const std::atomic<float>& fraction, const ImVec2& size, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return;
+	ProgressBarEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), fraction.load(std::memory_order_relaxed), size, dt, true); // Only the value is shared, nothing to order against it
+}
+
+void ImExt::ProgressBar(const ImExtLabel& label, float fraction, const ImVec2& size, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return;
+	ProgressBarEx(GetLabelID(window, label), label.Text, label.TextEnd, fraction, size, dt, false);
+}
+
+void ImExt::ProgressBar(const ImExtLabel& label, const std::atomic<float>& fraction, const ImVec2& size, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return;
+	ProgressBarEx(GetLabelID(window, label), label.Text, label.TextEnd, fraction.load(std::memory_order_relaxed), size, dt, true);
+}
+
+// Spinners step through 'steps' positions per cycle of 'period' seconds on g.Time: all of them move together, and between
+// two positions the widget is replayed from the render cache and asks the scheduler for nothing but the next step.
+static int SpinnerStep(ImGuiID id, int steps, float period)
+{
+	ImGuiContext& g = *GImGui;
+	const double phase = fmod(g.Time / period, 1.0) * steps;
+	const int step = ImMin((int)phase, steps - 1);
+	ScheduleAnimation(id, (float)(((double)step + 1.0 - phase) * period / steps), 0.0f);
+	return step;
+}
+
+// Arc spinner fitting a square of 'size' pixels, at position 'step' of IM_DRAWLIST_ARCFAST_SAMPLE_MAX
+static void RenderSpinnerArc(ImDrawList* draw_list, const ImVec2& center, float size, int step, ImU32 col)
+{
+	// Integer width: anti-aliased through the baked line texture, 2 vertices per point
+	const float thickness = ImMax(1.0f, IM_ROUND(size * 0.12f));
+	const float radius = size * 0.5f - thickness;
+	const int length = IM_DRAWLIST_ARCFAST_SAMPLE_MAX / 8 + (int)(IM_DRAWLIST_ARCFAST_SAMPLE_MAX * 0.25f * (1.0f - draw_list->_Data->ArcFastVtx[step].x)); // 1/8 to 5/8 of a turn
+	draw_list->_PathArcToFastEx(center, radius, step, step + length, 0);
+	draw_list->PathStroke(col, 0, thickness);
+}
+
+void ImExt::SpinnerEx(ImGuiID id, ImExtSpinnerType type, const ImVec2& size, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	ImGuiContext& g = *GImGui;
+	const ImGuiStyle& style = g.Style;
+
+	const float height = GetFrameHeight();
+	const ImVec2 item_size = (type == ImExtSpinnerType_Bar) ? CalcItemSize(size, CalcItemWidth(), ImMax(2.0f, IM_FLOOR(g.FontSize * 0.25f)))
+		: CalcItemSize(size, (type == ImExtSpinnerType_Dots) ? height * 2.0f : height, height);
+	const ImRect bb(window->DC.CursorPos, ImVec2(window->DC.CursorPos.x + item_size.x, window->DC.CursorPos.y + item_size.y));
+	ItemSize(item_size, (type == ImExtSpinnerType_Bar) ? -1.0f : style.FramePadding.y);
+	if (!ItemAdd(bb, id)) // Clipped spinners don't request frames
+		return;
+
+	// Positions are samples of the draw list arc table: under ImExtLod_Minimal only every 4th one is used
+	const int stride = (GetExtContext().IO.LodLevel >= ImExtLod_Minimal) ? 4 : 1;
+	const float period = ((type == ImExtSpinnerType_Bar) ? 1.5f : 1.0f) / dt;
+	const float travel = item_size.x * (4.0f / 3.0f); // Bar segment, a third of the track, from fully left to fully right
+	const int steps = (type == ImExtSpinnerType_Bar) ? ImMax((int)(travel / ImMax(GetExtContext().IO.AnimationMinPixelDelta, 1.0f)) / stride, 1) : IM_DRAWLIST_ARCFAST_SAMPLE_MAX / stride;
+	const int step = SpinnerStep(id, steps, period) * ((type == ImExtSpinnerType_Bar) ? 1 : stride);
+
+	const ImU32 cols[] = { GetColorU32(ImGuiCol_CheckMark), GetColorU32(ImGuiCol_FrameBg) };
+	const float render_values[] = { (float)type, (float)step };
+	if (RenderCacheBegin(id, bb, RenderCacheKey(bb, NULL, NULL, cols, IM_ARRAYSIZE(cols), render_values, IM_ARRAYSIZE(render_values))))
+		return;
+
+	ImDrawList* draw_list = window->DrawList;
+	const ImVec2* arc = draw_list->_Data->ArcFastVtx; // cos, sin of each sample
+	if (type == ImExtSpinnerType_Arc)
+	{
+		RenderSpinnerArc(draw_list, bb.GetCenter(), ImMin(item_size.x, item_size.y), step, cols[0]);
+	}
+	else if (type == ImExtSpinnerType_Dots)
+	{
+		const float radius = ImMin(item_size.y * 0.25f, item_size.x / 8.0f);
+		const int segments = 6; // Hexagons, a few pixels wide
+		for (int n = 0; n < 3; n++)
+		{
+			const float pulse = ImMax(arc[(step + IM_DRAWLIST_ARCFAST_SAMPLE_MAX - n * IM_DRAWLIST_ARCFAST_SAMPLE_MAX / 8) % IM_DRAWLIST_ARCFAST_SAMPLE_MAX].y, 0.0f);
+			const ImVec2 center(bb.Min.x + item_size.x * (1.0f + n * 2.0f) / 6.0f, bb.Min.y + item_size.y * 0.5f);
+			draw_list->_PathArcToFastEx(center, radius * (0.5f + 0.5f * pulse), 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, IM_DRAWLIST_ARCFAST_SAMPLE_MAX / segments);
+			draw_list->_Path.Size--;
+			draw_list->PathFillConvex(cols[0]);
+		}
+	}
+	else
+	{
+		const float rounding = ImMin(style.FrameRounding, item_size.y * 0.5f);
+		const float x = bb.Min.x - item_size.x / 3.0f + travel * step / steps;
+		draw_list->AddRectFilled(bb.Min, bb.Max, cols[1], rounding);
+		if (ImMin(x + item_size.x / 3.0f, bb.Max.x) > ImMax(x, bb.Min.x))
+			draw_list->AddRectFilled(ImVec2(ImMax(x, bb.Min.x), bb.Min.y), ImVec2(ImMin(x + item_size.x / 3.0f, bb.Max.x), bb.Max.y), cols[0], rounding);
+	}
+	RenderCacheEnd();
+}
+
+void ImExt::Spinner(const char* str_id, ImExtSpinnerType type, const ImVec2& size, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return;
+	SpinnerEx(GetLabelID(window, str_id), type, size, dt);
+}
+
+void ImExt::Spinner(const ImExtLabel& str_id, ImExtSpinnerType type, const ImVec2& size, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return;
+	SpinnerEx(GetLabelID(window, str_id), type, size, dt);
+}
+
+bool ImExt::TaskButtonEx(ImGuiID id, const char* label, const char* label_end, ImExtTaskFunc func, void* user_data, const ImVec2& size, const float dt, ImGuiButtonFlags flags)
+{
+	// Jobs keep running and report their completion while the button is hidden or clipped
+	ImExtContext& e = GetExtContext();
+	ImExtTask* task = FindTask(e, id);
+	bool completed = task ? UpdateTask(e, task) : false;
+
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return completed;
+
+	ImGuiContext& g = *GImGui;
+	const ImGuiStyle& style = g.Style;
+	const ImVec2 label_size = CalcLabelSize(label, label_end);
+	const float spinner_size = g.FontSize;
+	const float spinner_slot = spinner_size + style.ItemInnerSpacing.x; // Room the label makes for the spinner while busy
+
+	ImVec2 pos = window->DC.CursorPos;
+	if ((flags & ImGuiButtonFlags_AlignTextBaseLine) && style.FramePadding.y < window->DC.CurrLineTextBaseOffset)
+		pos.y += window->DC.CurrLineTextBaseOffset - style.FramePadding.y;
+	ImVec2 item_size = CalcItemSize(ImVec2(size.x, size.y + label_size.y),
+		label_size.x + spinner_slot + style.FramePadding.x * 2.0f,
+		label_size.y + style.FramePadding.y * 2.0f);
+
+	const ImRect bb(pos, ImVec2(pos.x + item_size.x, pos.y + item_size.y));
+	ItemSize(item_size, style.FramePadding.y);
+	if (!ItemAdd(bb, id))
+		return completed;
+
+	bool hovered, held;
+	bool pressed = ButtonBehavior(bb, id, &hovered, &held, flags);
+	if (pressed)
+	{
+		MarkItemEdited(id);
+		if (task && !task->Finished)
+		{
+			task->Context.CancelRequested.store(true, std::memory_order_relaxed);
+		}
+		else
+		{
+			if (task == NULL)
+				task = NewTask(e, id);
+			task->Func = func;
+			task->Context.UserData = user_data;
+			task->Context.Progress.store(0.0f, std::memory_order_relaxed);
+			task->Context.CancelRequested.store(false, std::memory_order_relaxed);
+			task->State.store(ImExtTaskState_Pending, std::memory_order_relaxed);
+			task->StateTime = g.Time;
+			task->Finished = false;
+			completed |= UpdateTask(e, task);
+		}
+	}
+
+	//Animation
+	float last_active_id_timer = g.LastActiveIdTimer;
+	if (held || pressed)
+		g.LastActiveIdTimer = 0.f;
+
+	if (g.LastActiveIdTimer == 0.f && g.LastActiveId == id && !pressed)
+		g.LastActiveIdTimer = last_active_id_timer;
+
+	float t = held ? 1.0f : 0.0f;
+
+	if (g.LastActiveId == id)
+	{
+		float t_anim = LodAnimationTime(ImSaturate(g.LastActiveIdTimer / 0.08f * dt));
+		t = held ? (t_anim) : (1.0f - t_anim);
+		ScheduleActiveIdAnimation(id, 0.08f / dt, item_size.x / 20.f);
+	}
+
+	// Press effect, see ButtonEx()
+	const float shrink = 1.0f - 0.05f * t;
+
+	const ImVec2 pos_min = ImVec2(bb.Min.x + style.FramePadding.x / 2, bb.Min.y + style.FramePadding.y / 2);
+	const ImVec2 pos_max = ImVec2(bb.Max.x - style.FramePadding.x, bb.Max.y - style.FramePadding.y);
+
+	// Busy state eases in from the submission and back out from the completion, the fill retracts meanwhile
+	float busy_t = 0.0f, progress = 0.0f;
+	int step = 0;
+	if (task)
+	{
+		const float t_anim = LodAnimationTime(ImSaturate((float)(g.Time - task->StateTime) / 0.16f * dt));
+		busy_t = task->Finished ? (1.0f - t_anim) : (t_anim);
+		if (t_anim < 1.0f)
+			ScheduleAnimation(GetAnimationId(id, 0), 0.16f / dt - (float)(g.Time - task->StateTime), spinner_slot * dt / 0.16f);
+		task->Progress = AnimateProgress(GetAnimationId(id, 1), task->Progress, task->Finished ? 0.0f : ImSaturate(task->Context.Progress.load(std::memory_order_relaxed)), pos_max.x - pos_min.x, dt);
+		progress = task->Progress;
+		if (busy_t > 0.0f)
+		{
+			const int stride = (e.IO.LodLevel >= ImExtLod_Minimal) ? 4 : 1; // See SpinnerEx()
+			step = SpinnerStep(GetAnimationId(id, 2), IM_DRAWLIST_ARCFAST_SAMPLE_MAX / stride, 1.0f / dt) * stride;
+		}
+		else if (task->Finished && progress == 0.0f)
+		{
+			e.Tasks.find_erase_unsorted(task);
+			e.FreeTasks.push_back(task);
+		}
+	}
+
+	// Render
+	const ImU32 col = GetColorU32((held && hovered) ? ImGuiCol_ButtonActive : hovered ? ImGuiCol_ButtonHovered : ImGuiCol_Button);
 	RenderNavHighlight(bb, id);
-	const ImVec2 pos_min = ImVec2(render_bb.Min.x + style.FramePadding.x / 2, render_bb.Min.y + style.FramePadding.y / 2);
-	const ImVec2 pos_max = ImVec2(render_bb.Max.x - style.FramePadding.x, render_bb.Max.y - style.FramePadding.y);
-	RenderFrame(pos_min, pos_max, col, true, style.FrameRounding);
+	const float render_values[] = { busy_t, progress, (float)step };
+	PushTransform(ImVec2(bb.Min.x + item_size.x / 3.0f, bb.Min.y + item_size.y / 3.0f), ImVec2(shrink, shrink));
+	if (!RenderCacheBegin(id, bb, RenderCacheKey(bb, label, label_end, &col, 1, render_values, IM_ARRAYSIZE(render_values))))
+	{
+		RenderFrame(pos_min, pos_max, col, true, style.FrameRounding);
+
+		if (g.LogEnabled)
+			LogSetNextTextDecoration("[", "]");
+		RenderProgressFill(pos_min, pos_max, pos_max.x - spinner_slot * busy_t, bb, label, label_end, label_size, progress);
+		if (busy_t > 0.0f)
+			RenderSpinnerArc(window->DrawList, ImVec2(pos_max.x - spinner_size * 0.5f, (pos_min.y + pos_max.y) * 0.5f), spinner_size * busy_t, step, GetColorU32(ImGuiCol_CheckMark, busy_t));
+		RenderCacheEnd();
+	}
+	PopTransform();
+
+	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags);
+	return completed;
+}
+
+bool ImExt::TaskButton(const char* label, ImExtTaskFunc func, void* user_data, const ImVec2& size, const float dt, ImGuiButtonFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	return TaskButtonEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), func, user_data, size, dt, flags); // TaskButtonEx() still tracks the job when skipped
+}
+
+bool ImExt::TaskButton(const ImExtLabel& label, ImExtTaskFunc func, void* user_data, const ImVec2& size, const float dt, ImGuiButtonFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	return TaskButtonEx(GetLabelID(window, label), label.Text, label.TextEnd, func, user_data, size, dt, flags);
+}
+
+// Magnitudes 'v' keeps the same "%.Nf" text within: printf rounds the exact binary value to N decimals, half to even only on
+// exact ties. The bounds are pulled in well past double rounding errors, so values near a tie are always formatted.
+static bool GetFormatRoundingInterval(const char* format, double v, double* out_min, double* out_max)
+{
+	static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+	const char* fmt_start = ImParseFormatFindStart(format);
+	const char* fmt_end = ImParseFormatFindEnd(fmt_start);
+	const int precision = ImParseFormatPrecision(format, 6);
+	if (fmt_end <= fmt_start || (fmt_end[-1] != 'f' && fmt_end[-1] != 'F') || precision < 0 || precision >= IM_ARRAYSIZE(pow10) || !(fabs(v) < 1e15))
+		return false;
+	const double scale = pow10[precision];
+	const double digits = floor(fabs(v) * scale + 0.5);
+	const double margin = (digits + 1.0) * 1e-12 / scale;
+	*out_min = (digits - 0.5) / scale + margin;
+	*out_max = (digits + 0.5) / scale - margin;
+	return fabs(v) > *out_min && fabs(v) < *out_max; // The guessed digits are printf's
+}
+
+// Format the value into state->Text when it changes, and measure the text only when its characters change. A float value
+// staying within the rounding interval of the displayed digits isn't formatted again, see GetFormatRoundingInterval().
+static void FormatValueCached(ImExtSliderState* state, ImGuiDataType data_type, const void* p_data, const char* format)
+{
+	ImGuiContext& g = *GImGui;
+	ImU64 key = 0;
+	memcpy(&key, p_data, (data_type == ImGuiDataType_Float) ? sizeof(float) : sizeof(int));
+	const ImU32 format_hash = ImHashStr(format);
+	bool cached = (state->TextLen != 0 && state->TextFormatHash == format_hash && state->TextKey == key);
+	if (!cached && state->TextLen != 0 && state->TextFormatHash == format_hash && data_type == ImGuiDataType_Float)
+	{
+		const double v = *(const float*)p_data;
+		cached = (signbit(v) != 0) == state->TextNegative && fabs(v) > state->TextMin && fabs(v) < state->TextMax; // "-0.00" differs from "0.00"
+	}
+	if (!cached)
+	{
+		char text[IM_ARRAYSIZE(state->Text)];
+		const int text_len = DataTypeFormatString(text, IM_ARRAYSIZE(text), data_type, p_data, format);
+		if (text_len != state->TextLen || memcmp(text, state->Text, (size_t)text_len) != 0)
+		{
+			memcpy(state->Text, text, (size_t)text_len + 1);
+			state->TextLen = text_len;
+			state->TextFont = NULL;
+		}
+		state->TextFormatHash = format_hash;
+		state->TextNegative = false;
+		state->TextMin = state->TextMax = 0.0;
+		if (data_type == ImGuiDataType_Float)
+		{
+			const double v = *(const float*)p_data;
+			state->TextNegative = (signbit(v) != 0);
+			if (!GetFormatRoundingInterval(format, v, &state->TextMin, &state->TextMax))
+				state->TextMin = state->TextMax = 0.0;
+		}
+	}
+	state->TextKey = key;
+	if (state->TextFont != g.Font || state->TextFontSize != g.FontSize)
+	{
+		state->TextSize = CalcLabelSize(state->Text, state->Text + state->TextLen);
+		state->TextFont = g.Font;
+		state->TextFontSize = g.FontSize;
+	}
+}
+
+// Critically damped spring pulling the displayed grab toward 'target'. Exact solution: stable at any frame rate.
+static float AnimateGrab(ImGuiID id, ImExtSliderState* state, float target, const float dt)
+{
+	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
+	const float omega = 30.0f * dt;
+	const float snap_distance = ImMax(e.IO.AnimationMinPixelDelta * 0.5f, 0.01f);
+	const float x0 = state->GrabPos - target;
+	if (state->LastFrame < g.FrameCount - 1 || e.IO.LodLevel >= ImExtLod_Minimal || (ImFabs(x0) <= snap_distance && ImFabs(state->GrabVelocity) <= snap_distance * omega))
+	{
+		state->GrabVelocity = 0.0f;
+		return state->GrabPos = target;
+	}
+	const float t = g.IO.DeltaTime;
+	const float c = state->GrabVelocity + omega * x0;
+	const float decay = expf(-omega * t);
+	state->GrabPos = target + (x0 + c * t) * decay;
+	state->GrabVelocity = (state->GrabVelocity - omega * c * t) * decay;
+	const float distance = ImFabs(state->GrabPos - target);
+	ScheduleAnimation(GetAnimationId(id, 0), (ImLog(ImMax(distance, snap_distance) / snap_distance) + 2.0f) / omega, ImFabs(state->GrabVelocity) + omega * distance);
+	return state->GrabPos;
+}
+
+// Called after the slider/drag behavior, estimates the value velocity while the widget is held
+static void TrackValueVelocity(ImGuiID id, ImExtSliderState* state, ImGuiDataType data_type, const void* p_data)
+{
+	ImGuiContext& g = *GImGui;
+	const float frame_dt = g.IO.DeltaTime;
+	const double v = (data_type == ImGuiDataType_Float) ? (double)*(const float*)p_data : (double)*(const int*)p_data;
+	if (g.ActiveId == id)
+	{
+		if (!state->Active || state->LastFrame < g.FrameCount - 1 || frame_dt <= 0.0f)
+			state->ValueVelocity = 0.0f;
+		else if (v != state->Value)
+			state->ValueVelocity = ImLerp(state->ValueVelocity, (float)((v - state->Value) / frame_dt), 1.0f - expf(-20.0f * frame_dt));
+		else
+			state->ValueVelocity *= expf(-10.0f * frame_dt); // Mouse held still: a tenth of a second of pause cancels the flick
+		state->Active = true;
+	}
+	state->Value = v;
+	state->LastFrame = g.FrameCount;
+}
+
+// Called before the slider/drag behavior. Released faster than 400 pixels per second, the value coasts and decelerates,
+// up to the bounds. 'px_per_unit' converts value units to mouse pixels, 0.0f disables.
+static bool UpdateInertia(ImGuiID id, ImExtSliderState* state, ImGuiDataType data_type, void* p_data, const void* p_min, const void* p_max, float px_per_unit, const float dt)
+{
+	ImGuiContext& g = *GImGui;
+	const float frame_dt = g.IO.DeltaTime;
+	const bool is_float = (data_type == ImGuiDataType_Float);
+	const double v = is_float ? (double)*(float*)p_data : (double)*(int*)p_data;
+	if (g.ActiveId == id || state->LastFrame < g.FrameCount - 1 || frame_dt <= 0.0f)
+	{
+		state->Active &= (g.ActiveId == id);
+		state->Inertia = false;
+		return false;
+	}
+	if (state->Active)
+	{
+		state->Active = false;
+		state->Inertia = ImFabs(state->ValueVelocity) * px_per_unit > 400.0f && GetExtContext().IO.LodLevel < ImExtLod_Minimal;
+		state->InertiaValue = v;
+	}
+	if (!state->Inertia || v != state->Value) // Stopped, or edited by the application meanwhile
+	{
+		state->Inertia = false;
+		return false;
+	}
+
+	state->ValueVelocity *= expf(-4.0f * dt * frame_dt);
+	double v_new = state->InertiaValue + state->ValueVelocity * frame_dt;
+	const double v_min = !p_min ? 0.0 : is_float ? (double)*(const float*)p_min : (double)*(const int*)p_min;
+	const double v_max = !p_max ? 0.0 : is_float ? (double)*(const float*)p_max : (double)*(const int*)p_max;
+	if (v_min < v_max && (v_new <= v_min || v_new >= v_max))
+	{
+		v_new = ImClamp(v_new, v_min, v_max);
+		state->Inertia = false;
+	}
+	const float speed = ImFabs(state->ValueVelocity) * px_per_unit;
+	if (speed < 10.0f)
+		state->Inertia = false;
+	else if (state->Inertia)
+		ScheduleAnimation(GetAnimationId(id, 1), ImLog(speed / 10.0f) / (4.0f * dt), speed);
+	state->InertiaValue = v_new;
+	if (is_float)
+		*(float*)p_data = (float)v_new;
+	else
+		*(int*)p_data = (int)floor(v_new + 0.5);
+	return (is_float ? (double)*(float*)p_data : (double)*(int*)p_data) != v;
+}
+
+// MarkItemEdited() wants the item active or nothing active: a value coasting while another item is held is only flagged
+static void MarkValueEdited(ImGuiID id)
+{
+	ImGuiContext& g = *GImGui;
+	if (g.ActiveId == id || g.ActiveId == 0 || g.DragDropActive)
+		MarkItemEdited(id);
+	else
+		g.LastItemData.StatusFlags |= ImGuiItemStatusFlags_Edited;
+}
+
+bool ImExt::SliderScalarEx(ImGuiID id, const char* label, const char* label_end, ImGuiDataType data_type, void* p_data, const void* p_min, const void* p_max, const char* format, const float dt, ImGuiSliderFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+
+	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
+	const ImGuiStyle& style = g.Style;
+	const float w = CalcItemWidth();
+
+	const ImVec2 label_size = CalcLabelSize(label, label_end);
+	const ImRect frame_bb(window->DC.CursorPos, ImVec2(window->DC.CursorPos.x + w, window->DC.CursorPos.y + label_size.y + style.FramePadding.y * 2.0f));
+	const ImRect total_bb(frame_bb.Min, ImVec2(frame_bb.Max.x + (label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f), frame_bb.Max.y));
+
+	const bool temp_input_allowed = (flags & ImGuiSliderFlags_NoInput) == 0;
+	ItemSize(total_bb, style.FramePadding.y);
+	if (!ItemAdd(total_bb, id, &frame_bb, temp_input_allowed ? ImGuiItemFlags_Inputable : 0))
+		return false;
+
+	// Default format string when passing NULL
+	if (format == NULL)
+		format = DataTypeGetInfo(data_type)->PrintFmt;
+	else if (data_type == ImGuiDataType_S32 && strcmp(format, "%d") != 0) // Legacy "%.0f" format strings
+		format = PatchFormatStringFloatToInt(format);
+
+	const bool hovered = ItemHoverable(frame_bb, id);
+	bool temp_input_is_active = temp_input_allowed && TempInputIsActive(id);
+	if (!temp_input_is_active)
+	{
+		// Tabbing or CTRL-clicking on Slider turns it into an input box
+		const bool input_requested_by_tabbing = temp_input_allowed && (g.LastItemData.StatusFlags & ImGuiItemStatusFlags_FocusedByTabbing) != 0;
+		const bool clicked = (hovered && g.IO.MouseClicked[0]);
+		const bool make_active = (input_requested_by_tabbing || clicked || g.NavActivateId == id || g.NavActivateInputId == id);
+		if (make_active && temp_input_allowed)
+			if (input_requested_by_tabbing || (clicked && g.IO.KeyCtrl) || g.NavActivateInputId == id)
+				temp_input_is_active = true;
+
+		if (make_active && !temp_input_is_active)
+		{
+			SetActiveID(id, window);
+			SetFocusID(id, window);
+			FocusWindow(window);
+			g.ActiveIdUsingNavDirMask |= (1 << ImGuiDir_Left) | (1 << ImGuiDir_Right);
+		}
+	}
+
+	if (temp_input_is_active)
+	{
+		// Only clamp CTRL+Click input when ImGuiSliderFlags_AlwaysClamp is set
+		const bool is_clamp_input = (flags & ImGuiSliderFlags_AlwaysClamp) != 0;
+		return TempInputScalar(frame_bb, id, label, data_type, p_data, format, is_clamp_input ? p_min : NULL, is_clamp_input ? p_max : NULL);
+	}
+
+	// Flicked values coast, then the slider behavior places the grab on the result
+	ImExtSliderState* state = e.Sliders.GetOrAddByKey(id);
+	const double range = (data_type == ImGuiDataType_Float) ? (double)*(const float*)p_max - *(const float*)p_min : (double)*(const int*)p_max - *(const int*)p_min;
+	const float px_per_unit = (range != 0.0 && !(flags & ImGuiSliderFlags_Logarithmic)) ? (float)ImFabs((frame_bb.GetWidth() - 4.0f) / range) : 0.0f;
+	bool value_changed = UpdateInertia(id, state, data_type, p_data, p_min, p_max, px_per_unit, dt);
+	ImRect grab_bb;
+	value_changed |= SliderBehavior(frame_bb, id, data_type, p_data, p_min, p_max, format, flags, &grab_bb);
+	if (value_changed)
+		MarkValueEdited(id);
+
+	const float grab_pos = (grab_bb.Max.x > grab_bb.Min.x) ? AnimateGrab(id, state, grab_bb.Min.x - frame_bb.Min.x, dt) : 0.0f;
+	FormatValueCached(state, data_type, p_data, format);
+	TrackValueVelocity(id, state, data_type, p_data);
+
+	// Render
+	const ImU32 frame_col = GetColorU32(g.ActiveId == id ? ImGuiCol_FrameBgActive : hovered ? ImGuiCol_FrameBgHovered : ImGuiCol_FrameBg);
+	const ImU32 grab_col = GetColorU32(g.ActiveId == id ? ImGuiCol_SliderGrabActive : ImGuiCol_SliderGrab);
+	const ImU32 render_cols[] = { frame_col, grab_col, ImHashData(state->Text, (size_t)state->TextLen) };
+	const float render_values[] = { grab_pos, grab_bb.GetWidth(), grab_bb.Min.y - frame_bb.Min.y, style.GrabRounding };
+	RenderNavHighlight(frame_bb, id);
+	if (!RenderCacheBegin(id, total_bb, RenderCacheKey(total_bb, label, label_end, render_cols, IM_ARRAYSIZE(render_cols), render_values, IM_ARRAYSIZE(render_values))))
+	{
+		RenderFrame(frame_bb.Min, frame_bb.Max, frame_col, true, style.FrameRounding);
+		if (grab_bb.Max.x > grab_bb.Min.x)
+			window->DrawList->AddRectFilled(ImVec2(frame_bb.Min.x + grab_pos, grab_bb.Min.y), ImVec2(frame_bb.Min.x + grab_pos + grab_bb.GetWidth(), grab_bb.Max.y), grab_col, style.GrabRounding);
+
+		// Display value using user-provided display format so user can add prefix/suffix/decorations to the value.
+		if (g.LogEnabled)
+			LogSetNextTextDecoration("{", "}");
+		ImDraw::RenderTextClipped(frame_bb.Min, frame_bb.Max, state->Text, state->Text + state->TextLen, &state->TextSize, GetColorU32(ImGuiCol_Text), ImVec2(0.5f, 0.5f));
+
+		if (label_size.x > 0.0f)
+			RenderText(ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, frame_bb.Min.y + style.FramePadding.y), label, label_end, false);
+		RenderCacheEnd();
+	}
+
+	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags);
+	return value_changed;
+}
+
+bool ImExt::DragScalarEx(ImGuiID id, const char* label, const char* label_end, ImGuiDataType data_type, void* p_data, float v_speed, const void* p_min, const void* p_max, const char* format, const float dt, ImGuiSliderFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+
+	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
+	const ImGuiStyle& style = g.Style;
+	const float w = CalcItemWidth();
+
+	const ImVec2 label_size = CalcLabelSize(label, label_end);
+	const ImRect frame_bb(window->DC.CursorPos, ImVec2(window->DC.CursorPos.x + w, window->DC.CursorPos.y + label_size.y + style.FramePadding.y * 2.0f));
+	const ImRect total_bb(frame_bb.Min, ImVec2(frame_bb.Max.x + (label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f), frame_bb.Max.y));
+
+	const bool temp_input_allowed = (flags & ImGuiSliderFlags_NoInput) == 0;
+	ItemSize(total_bb, style.FramePadding.y);
+	if (!ItemAdd(total_bb, id, &frame_bb, temp_input_allowed ? ImGuiItemFlags_Inputable : 0))
+		return false;
+
+	// Default format string when passing NULL
+	if (format == NULL)
+		format = DataTypeGetInfo(data_type)->PrintFmt;
+	else if (data_type == ImGuiDataType_S32 && strcmp(format, "%d") != 0) // Legacy "%.0f" format strings
+		format = PatchFormatStringFloatToInt(format);
+
+	const bool hovered = ItemHoverable(frame_bb, id);
+	bool temp_input_is_active = temp_input_allowed && TempInputIsActive(id);
+	if (!temp_input_is_active)
+	{
+		// Tabbing or CTRL-clicking on Drag turns it into an InputText
+		const bool input_requested_by_tabbing = temp_input_allowed && (g.LastItemData.StatusFlags & ImGuiItemStatusFlags_FocusedByTabbing) != 0;
+		const bool clicked = (hovered && g.IO.MouseClicked[0]);
+		const bool double_clicked = (hovered && g.IO.MouseClickedCount[0] == 2);
+		const bool make_active = (input_requested_by_tabbing || clicked || double_clicked || g.NavActivateId == id || g.NavActivateInputId == id);
+		if (make_active && temp_input_allowed)
+			if (input_requested_by_tabbing || (clicked && g.IO.KeyCtrl) || double_clicked || g.NavActivateInputId == id)
+				temp_input_is_active = true;
+
+		// (Optional) simple click (without moving) turns Drag into an InputText
+		if (g.IO.ConfigDragClickToInputText && temp_input_allowed && !temp_input_is_active)
+			if (g.ActiveId == id && hovered && g.IO.MouseReleased[0] && !IsMouseDragPastThreshold(0, g.IO.MouseDragThreshold * 0.50f)) // Same threshold factor as DragBehavior()
+			{
+				g.NavActivateId = g.NavActivateInputId = id;
+				g.NavActivateFlags = ImGuiActivateFlags_PreferInput;
+				temp_input_is_active = true;
+			}
+
+		if (make_active && !temp_input_is_active)
+		{
+			SetActiveID(id, window);
+			SetFocusID(id, window);
+			FocusWindow(window);
+			g.ActiveIdUsingNavDirMask = (1 << ImGuiDir_Left) | (1 << ImGuiDir_Right);
+		}
+	}
 
-	if (g.LogEnabled)
-		LogSetNextTextDecoration("[", "]");
-	RenderTextClipped(pos_min, pos_max, label, NULL, &label_size, style.ButtonTextAlign, &render_bb);
+	if (temp_input_is_active)
+	{
+		// Only clamp CTRL+Click input when ImGuiSliderFlags_AlwaysClamp is set
+		const bool is_clamp_input = (flags & ImGuiSliderFlags_AlwaysClamp) != 0 && (p_min == NULL || p_max == NULL || DataTypeCompare(data_type, p_min, p_max) < 0);
+		return TempInputScalar(frame_bb, id, label, data_type, p_data, format, is_clamp_input ? p_min : NULL, is_clamp_input ? p_max : NULL);
+	}
+
+	// Flicked values coast at the drag speed the mouse left them at
+	ImExtSliderState* state = e.Sliders.GetOrAddByKey(id);
+	if (v_speed == 0.0f && p_min && p_max && DataTypeCompare(data_type, p_min, p_max) < 0) // Same default speed as DragBehavior()
+		v_speed = (float)((data_type == ImGuiDataType_Float ? (double)*(const float*)p_max - *(const float*)p_min : (double)*(const int*)p_max - *(const int*)p_min) * g.DragSpeedDefaultRatio);
+	const float px_per_unit = (v_speed != 0.0f && !(flags & ImGuiSliderFlags_Logarithmic)) ? 1.0f / ImFabs(v_speed) : 0.0f;
+	bool value_changed = UpdateInertia(id, state, data_type, p_data, p_min, p_max, px_per_unit, dt);
+	value_changed |= DragBehavior(id, data_type, p_data, v_speed, p_min, p_max, format, flags);
+	if (value_changed)
+		MarkValueEdited(id);
+
+	FormatValueCached(state, data_type, p_data, format);
+	TrackValueVelocity(id, state, data_type, p_data);
+
+	// Render
+	const ImU32 frame_col = GetColorU32(g.ActiveId == id ? ImGuiCol_FrameBgActive : hovered ? ImGuiCol_FrameBgHovered : ImGuiCol_FrameBg);
+	const ImU32 render_cols[] = { frame_col, ImHashData(state->Text, (size_t)state->TextLen) };
+	RenderNavHighlight(frame_bb, id);
+	if (!RenderCacheBegin(id, total_bb, RenderCacheKey(total_bb, label, label_end, render_cols, IM_ARRAYSIZE(render_cols), NULL, 0)))
+	{
+		RenderFrame(frame_bb.Min, frame_bb.Max, frame_col, true, style.FrameRounding);
+
+		// Display value using user-provided display format so user can add prefix/suffix/decorations to the value.
+		if (g.LogEnabled)
+			LogSetNextTextDecoration("{", "}");
+		ImDraw::RenderTextClipped(frame_bb.Min, frame_bb.Max, state->Text, state->Text + state->TextLen, &state->TextSize, GetColorU32(ImGuiCol_Text), ImVec2(0.5f, 0.5f));
+
+		if (label_size.x > 0.0f)
+			RenderText(ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, frame_bb.Min.y + style.FramePadding.y), label, label_end, false);
+		RenderCacheEnd();
+	}
 
 	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags);
-	return pressed;
+	return value_changed;
+}
+
+bool ImExt::SliderFloat(const char* label, float* v, float v_min, float v_max, const char* format, const float dt, ImGuiSliderFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return SliderScalarEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), ImGuiDataType_Float, v, &v_min, &v_max, format, dt, flags);
+}
+
+bool ImExt::SliderFloat(const ImExtLabel& label, float* v, float v_min, float v_max, const char* format, const float dt, ImGuiSliderFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return SliderScalarEx(GetLabelID(window, label), label.Text, label.TextEnd, ImGuiDataType_Float, v, &v_min, &v_max, format, dt, flags);
+}
+
+bool ImExt::SliderInt(const char* label, int* v, int v_min, int v_max, const char* format, const float dt, ImGuiSliderFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return SliderScalarEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), ImGuiDataType_S32, v, &v_min, &v_max, format, dt, flags);
+}
+
+bool ImExt::SliderInt(const ImExtLabel& label, int* v, int v_min, int v_max, const char* format, const float dt, ImGuiSliderFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return SliderScalarEx(GetLabelID(window, label), label.Text, label.TextEnd, ImGuiDataType_S32, v, &v_min, &v_max, format, dt, flags);
+}
+
+bool ImExt::DragFloat(const char* label, float* v, float v_speed, float v_min, float v_max, const char* format, const float dt, ImGuiSliderFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return DragScalarEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), ImGuiDataType_Float, v, v_speed, &v_min, &v_max, format, dt, flags);
 }
 
-IMGUI_API bool ImExt::ProgressToggleButton(const char* label, bool* v, float* v_progress, const ImVec2& size, const float v_speed, const float dt, ImGuiButtonFlags flags)
+bool ImExt::DragFloat(const ImExtLabel& label, float* v, float v_speed, float v_min, float v_max, const char* format, const float dt, ImGuiSliderFlags flags)
 {
 	ImGuiWindow* window = GetCurrentWindow();
 	if (window->SkipItems)
 		return false;
+	return DragScalarEx(GetLabelID(window, label), label.Text, label.TextEnd, ImGuiDataType_Float, v, v_speed, &v_min, &v_max, format, dt, flags);
+}
 
+#define IMEXT_NUMBER_MAX_PLACES         15 // Digits of the largest value rolled, above that doubles no longer hold every unit
+#define IMEXT_NUMBER_TWEEN_DURATION     0.3f
+
+// Glyphs of the current font for AnimatedNumber(), laid out again when the font, its size or the atlas glyphs change
+static const ImExtDigitGlyphs& GetDigitGlyphs()
+{
 	ImGuiContext& g = *GImGui;
-	const ImGuiStyle& style = g.Style;
-	const ImGuiID id = window->GetID(label);
-	const ImVec2 label_size = CalcTextSize(label, NULL, true);
+	ImExtDigitGlyphs& d = GetExtContext().DigitGlyphs;
+	if (d.Font == g.Font && d.FontSize == g.FontSize && d.GlyphsGeneration == GImExtGlyphsGeneration)
+		return d;
+
+	static const char chars[] = "0123456789.-";
+	ImExt::RequestGlyphs(g.Font, chars, chars + 12);
+	const float scale = g.FontSize / g.Font->FontSize;
+	d.Font = g.Font;
+	d.FontSize = g.FontSize;
+	d.GlyphsGeneration = GImExtGlyphsGeneration;
+	d.DigitWidth = 0.0f;
+	for (int n = 0; n < 12; n++)
+	{
+		ImFontGlyph& glyph = d.Glyphs[n];
+		if (const ImFontGlyph* src = g.Font->FindGlyph((ImWchar)chars[n]))
+			glyph = *src;
+		else
+			memset((void*)&glyph, 0, sizeof(glyph));
+		glyph.X0 *= scale; glyph.Y0 *= scale; glyph.X1 *= scale; glyph.Y1 *= scale;
+		glyph.AdvanceX *= scale;
+		if (n < 10)
+			d.DigitWidth = ImMax(d.DigitWidth, glyph.AdvanceX);
+	}
+	return d;
+}
 
-	ImVec2 pos = window->DC.CursorPos;
-	if ((flags & ImGuiButtonFlags_AlignTextBaseLine) && style.FramePadding.y < window->DC.CurrLineTextBaseOffset) // Try to vertically align buttons that are smaller/have no padding so that text baseline matches (bit hacky, since it shouldn't be a flag)
-		pos.y += window->DC.CurrLineTextBaseOffset - style.FramePadding.y;
-	ImVec2 item_size = CalcItemSize(ImVec2(size.x, size.y + label_size.y),
-		label_size.x + style.FramePadding.x * 2.0f, label_size.y + style.FramePadding.y * 2.0f);
+// Split "prefix%.Nfsuffix" or "prefix%dsuffix" formats, the ones whose digits can be rolled. Anything else (flags, width,
+// other conversions, long prefixes) leaves Precision at -1 and is formatted as text.
+static void ParseNumberFormat(ImExtNumberState* state, const char* format)
+{
+	state->Precision = -1;
+	state->PrefixLen = state->SuffixLen = 0;
+	state->TextFont = NULL;
+	const char* fmt_start = ImParseFormatFindStart(format);
+	const char* fmt_end = ImParseFormatFindEnd(fmt_start);
+	if (*fmt_start != '%' || fmt_end == fmt_start)
+		return;
+	const char type = fmt_end[-1];
+	int precision = 0;
+	const char* p = fmt_start + 1;
+	if ((type == 'f' || type == 'F') && *p == '.')
+	{
+		for (p++, precision = 0; *p >= '0' && *p <= '9'; p++)
+			precision = precision * 10 + (*p - '0');
+	}
+	else if (type == 'f' || type == 'F')
+	{
+		precision = 6;
+	}
+	else if (type != 'd' && type != 'i')
+	{
+		return;
+	}
+	if (p != fmt_end - 1 || precision > 9)
+		return;
 
-	const ImRect bb(pos, ImVec2(pos.x + item_size.x, pos.y + item_size.y));
+	// Unescape "%%" around the conversion
+	int len = 0;
+	for (const char* c = format; c < fmt_start; c++)
+	{
+		if (len == IM_ARRAYSIZE(state->Prefix) - 1)
+			return;
+		state->Prefix[len++] = *c;
+		if (c[0] == '%' && c[1] == '%')
+			c++;
+	}
+	state->PrefixLen = len;
+	len = 0;
+	for (const char* c = fmt_end; *c; c++)
+	{
+		if (len == IM_ARRAYSIZE(state->Suffix) - 1 || (c[0] == '%' && c[1] != '%'))
+			return;
+		state->Suffix[len++] = *c;
+		if (c[0] == '%')
+			c++;
+	}
+	state->SuffixLen = len;
+	state->Precision = precision;
+}
+
+// Draw 'glyph' with its cell top-left at 'pos', clipped to 'clip_rect'
+static void AddDigitGlyph(ImDrawList* draw_list, const ImFontGlyph& glyph, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect)
+{
+	const float x1 = pos.x + glyph.X0, y1 = pos.y + glyph.Y0, x2 = pos.x + glyph.X1, y2 = pos.y + glyph.Y1;
+	if (!glyph.Visible || x1 >= clip_rect.z || x2 <= clip_rect.x || y1 >= clip_rect.w || y2 <= clip_rect.y)
+		return;
+	draw_list->PrimReserve(6, 4);
+	if (PrimGlyphQuad(draw_list->_VtxWritePtr, draw_list->_IdxWritePtr, draw_list->_VtxCurrentIdx, x1, y1, x2, y2, glyph.U0, glyph.V0, glyph.U1, glyph.V1, glyph.Colored ? (col | ~IM_COL32_A_MASK) : col, &clip_rect))
+	{
+		draw_list->_VtxWritePtr += 4;
+		draw_list->_IdxWritePtr += 6;
+		draw_list->_VtxCurrentIdx += 4;
+	}
+	else
+	{
+		draw_list->PrimUnreserve(6, 4);
+	}
+}
+
+// Odometer: the value is tweened in units of its last displayed digit, and each digit is a wheel drawn from the cached
+// quads of its two visible faces. A digit turns while the digit below it goes from 9 to 0, and a new leading digit's
+// column opens as its wheel turns from blank to 1, so the text width changes smoothly. No text is formatted nor measured
+// while the value changes, and a settled number is replayed from the render cache.
+void ImExt::AnimatedNumberEx(ImGuiID id, double value, const char* format, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
+	static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16 };
+
+	ImExtNumberState* state = e.Numbers.GetOrAddByKey(id);
+	const ImU32 format_hash = ImHashStr(format);
+	const bool format_changed = (state->LastFrame == -1 || state->FormatHash != format_hash);
+	if (format_changed)
+	{
+		ParseNumberFormat(state, format);
+		state->FormatHash = format_hash;
+	}
+	const double scale = pow10[ImMax(state->Precision, 0)];
+	const double target = (value >= 0.0) ? floor(value * scale + 0.5) : -floor(-value * scale + 0.5);
+	if (format_changed || state->LastFrame < g.FrameCount - 1 || e.IO.LodLevel >= ImExtLod_Minimal || value != value)
+	{
+		state->From = state->Target = target;
+		state->Time = 1.0f;
+	}
+	else if (target != state->Target)
+	{
+		const float t = 1.0f - state->Time;
+		state->From = state->From + (state->Target - state->From) * (1.0 - t * t * t);
+		state->Target = target;
+		state->Time = 0.0f;
+	}
+	else if (state->Time < 1.0f)
+	{
+		state->Time = ImMin(state->Time + g.IO.DeltaTime * dt / IMEXT_NUMBER_TWEEN_DURATION, 1.0f);
+	}
+	state->LastFrame = g.FrameCount;
+	const float t = 1.0f - state->Time;
+	const double shown = (state->Time >= 1.0f) ? state->Target : state->From + (state->Target - state->From) * (1.0 - t * t * t);
+
+	// Formats we can't roll, and values too large to, are formatted as text
+	const ImVec2 pos = window->DC.CursorPos;
+	if (state->Precision < 0 || ImMax(fabs(state->From), fabs(state->Target)) >= pow10[IMEXT_NUMBER_MAX_PLACES] || value != value)
+	{
+		const double text_value = (state->Precision < 0) ? value : shown / scale;
+		const char* fmt_end = ImParseFormatFindEnd(ImParseFormatFindStart(format));
+		const char* text_end = g.TempBuffer.Data + ((fmt_end > format && strchr("diouxXc", fmt_end[-1])) ? ImFormatString(g.TempBuffer.Data, g.TempBuffer.Size, format, (int)text_value) : ImFormatString(g.TempBuffer.Data, g.TempBuffer.Size, format, text_value));
+		const ImVec2 text_size = CalcLabelSize(g.TempBuffer.Data, text_end);
+		const ImRect bb(pos, ImVec2(pos.x + text_size.x, pos.y + text_size.y));
+		ItemSize(text_size, 0.0f);
+		if (!ItemAdd(bb, id))
+			return;
+		ImDraw::RenderTextClipped(bb.Min, bb.Max, g.TempBuffer.Data, text_end, &text_size, GetColorU32(ImGuiCol_Text));
+		if (state->Time < 1.0f)
+			ScheduleAnimation(id, (1.0f - state->Time) * IMEXT_NUMBER_TWEEN_DURATION / dt, 0.0f);
+		return;
+	}
+
+	// Wheel positions from the lowest digit up: 'wheels[k]' in [0, 10) and 'columns[k]' in [0, 1] for leading digits.
+	// A wheel turns while the one below it covers its last 'window' units: 1 like a mechanical counter, up to all 10 when
+	// the wheel below spins faster than the eye follows, so large changes roll every digit instead of flipping them.
+	const ImExtDigitGlyphs& d = GetDigitGlyphs();
+	const int precision = state->Precision;
+	const double n = fabs(shown);
+	const float units_per_second = (float)fabs(state->Target - state->From) * 3.0f * t * t / IMEXT_NUMBER_TWEEN_DURATION * dt;
+	float units_per_frame = units_per_second * g.IO.DeltaTime;
+	float wheels[IMEXT_NUMBER_MAX_PLACES + 1];
+	float columns[IMEXT_NUMBER_MAX_PLACES + 1];
+	bool leading[IMEXT_NUMBER_MAX_PLACES + 1];
+	int places = 0;
+	for (int k = 0; k <= IMEXT_NUMBER_MAX_PLACES; k++, units_per_frame *= 0.1f)
+	{
+		const double above = floor(n / pow10[k]); // Value of this digit and the ones above it
+		const float window = ImClamp(units_per_frame * 2.0f, 1.0f, 10.0f); // Of the wheel below, which moves at 'units_per_frame'
+		const float carry = (k == 0) ? (float)(n - above) : ImMax(wheels[k - 1] - (10.0f - window), 0.0f) / window;
+		if (k > precision && above == 0.0 && carry == 0.0f)
+			break;
+		wheels[k] = (float)fmod(above, 10.0) + carry;
+		columns[k] = (k > precision) ? ImMin((float)above + carry, 1.0f) : 1.0f;
+		leading[k] = (k > precision && above == 0.0);
+		places = k + 1;
+	}
+
+	// Layout
+	if (state->TextFont != g.Font || state->TextFontSize != g.FontSize)
+	{
+		state->PrefixWidth = CalcLabelSize(state->Prefix, state->Prefix + state->PrefixLen).x;
+		state->SuffixWidth = CalcLabelSize(state->Suffix, state->Suffix + state->SuffixLen).x;
+		state->TextFont = g.Font;
+		state->TextFontSize = g.FontSize;
+	}
+	const bool negative = (shown < 0.0);
+	float width = state->PrefixWidth + state->SuffixWidth + (negative ? d.Glyphs[11].AdvanceX : 0.0f) + (precision > 0 ? d.Glyphs[10].AdvanceX : 0.0f);
+	for (int k = 0; k < places; k++)
+		width += columns[k] * d.DigitWidth;
+	const ImVec2 size(IM_FLOOR(width + 0.99999f), g.FontSize);
+	const ImRect bb(pos, ImVec2(pos.x + size.x, pos.y + size.y));
+	ItemSize(size, 0.0f);
+	if (!ItemAdd(bb, id)) // Clipped numbers don't request frames
+		return;
+	if (state->Time < 1.0f)
+	{
+		ScheduleAnimation(id, t * IMEXT_NUMBER_TWEEN_DURATION / dt, units_per_second * g.FontSize); // Lowest wheel faces move a line per unit
+	}
+
+	const ImU32 col = GetColorU32(ImGuiCol_Text);
+	const ImU32 cols[] = { col, format_hash, ImHashData(&shown, sizeof(shown)) };
+	if (RenderCacheBegin(id, bb, RenderCacheKey(bb, NULL, NULL, cols, IM_ARRAYSIZE(cols), NULL, 0)))
+		return;
+
+	ImDrawList* draw_list = window->DrawList;
+	const ImVec4& window_clip = draw_list->_CmdHeader.ClipRect;
+	const float line_height = g.FontSize;
+	float x = IM_FLOOR(pos.x);
+	const float y = IM_FLOOR(pos.y);
+	if (state->PrefixLen > 0)
+		AddTextCached(draw_list, ImVec2(x, y), col, state->Prefix, state->Prefix + state->PrefixLen, 0.0f, NULL);
+	x += state->PrefixWidth;
+	if (negative)
+	{
+		AddDigitGlyph(draw_list, d.Glyphs[11], ImVec2(x, y), col, window_clip);
+		x += d.Glyphs[11].AdvanceX;
+	}
+	for (int k = places - 1; k >= 0; k--)
+	{
+		// Faces 'a' and 'a + 1' of the wheel, centered in a column clipped to the line (and to its opened part)
+		const float column_width = columns[k] * d.DigitWidth;
+		const ImVec4 clip(ImMax(window_clip.x, columns[k] < 1.0f ? x : -FLT_MAX), ImMax(window_clip.y, y), ImMin(window_clip.z, columns[k] < 1.0f ? x + column_width : FLT_MAX), ImMin(window_clip.w, y + line_height));
+		const int a = (int)wheels[k];
+		const float f = wheels[k] - (float)a;
+		const float face_x = x + column_width - d.DigitWidth;
+		if (clip.x < clip.z && clip.y < clip.w)
+		{
+			if (!leading[k] || a != 0)
+				AddDigitGlyph(draw_list, d.Glyphs[a], ImVec2(face_x + (d.DigitWidth - d.Glyphs[a].AdvanceX) * 0.5f, y - f * line_height), col, clip);
+			if (f > 0.0f)
+				AddDigitGlyph(draw_list, d.Glyphs[(a + 1) % 10], ImVec2(face_x + (d.DigitWidth - d.Glyphs[(a + 1) % 10].AdvanceX) * 0.5f, y + (1.0f - f) * line_height), col, clip);
+		}
+		x += column_width;
+		if (k == precision && precision > 0)
+		{
+			AddDigitGlyph(draw_list, d.Glyphs[10], ImVec2(x, y), col, window_clip);
+			x += d.Glyphs[10].AdvanceX;
+		}
+	}
+	if (state->SuffixLen > 0)
+		AddTextCached(draw_list, ImVec2(x, y), col, state->Suffix, state->Suffix + state->SuffixLen, 0.0f, NULL);
+	RenderCacheEnd();
+}
+
+void ImExt::AnimatedNumber(const char* str_id, double value, const char* format, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return;
+	AnimatedNumberEx(GetLabelID(window, str_id), value, format, dt);
+}
+
+void ImExt::AnimatedNumber(const ImExtLabel& str_id, double value, const char* format, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return;
+	AnimatedNumberEx(GetLabelID(window, str_id), value, format, dt);
+}
+
+// One vertex pair per column at its center, spanning its min..max, triangulated into a ribbon in a single PrimReserve().
+// Columns span at least to their neighbours so steep edges stay connected, and at least a pixel.
+void ImExt::SparklineEx(ImGuiID id, const ImExtSparklineBuffer& buffer, const ImVec2& size, float scale_min, float scale_max, int samples_count, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
+	const ImGuiStyle& style = g.Style;
+
+	const ImVec2 item_size = CalcItemSize(size, CalcItemWidth(), GetFrameHeight());
+	const ImRect frame_bb(window->DC.CursorPos, ImVec2(window->DC.CursorPos.x + item_size.x, window->DC.CursorPos.y + item_size.y));
+	const ImRect inner_bb(ImVec2(frame_bb.Min.x + style.FramePadding.x, frame_bb.Min.y + style.FramePadding.y), ImVec2(frame_bb.Max.x - style.FramePadding.x, frame_bb.Max.y - style.FramePadding.y));
 	ItemSize(item_size, style.FramePadding.y);
-	if (!ItemAdd(bb, id))
-		return false;
+	if (!ItemAdd(frame_bb, id)) // Clipped sparklines request no frames, they catch up from the buffer once visible
+		return;
 
-	if (g.LastItemData.InFlags & ImGuiItemFlags_ButtonRepeat)
-		flags |= ImGuiButtonFlags_Repeat;
+	// One column per pixel, each a whole number of samples
+	if (samples_count <= 0 || samples_count > buffer.Capacity)
+		samples_count = buffer.Capacity;
+	const float width = ImMax(inner_bb.GetWidth(), 1.0f);
+	const int samples_per_column = ImMax((int)ceilf((float)samples_count / width), 1);
+	const int columns_count = (samples_count + samples_per_column - 1) / samples_per_column + 2; // And a partial one at each end
+	ImExtSparklineState* state = e.Sparklines.GetOrAddByKey(id);
+	if (state->Buffer != &buffer || state->SamplesPerColumn != samples_per_column || state->ColumnMin.Size != columns_count)
+	{
+		state->Buffer = &buffer;
+		state->SamplesPerColumn = samples_per_column;
+		state->Decimated = 0;
+		state->ColumnMin.resize(columns_count);
+		state->ColumnMax.resize(columns_count);
+		for (int n = 0; n < columns_count; n++)
+		{
+			state->ColumnMin[n] = FLT_MAX;
+			state->ColumnMax[n] = -FLT_MAX;
+		}
+		state->LastFrame = -1;
+	}
+	DecimateSparkline(e, state, buffer);
+	const ImU64 decimated = state->Decimated;
+	const bool fresh = state->LastFrame < g.FrameCount - 1;
+
+	// New columns scroll in. Producers can't wake an event-driven host: poll while idle, follow the stream while it flows.
+	const double px_per_sample = (double)width / samples_count;
+	if (fresh)
+		state->ScrollHead = (double)decimated;
+	else
+		state->ScrollHead = (double)decimated - AnimateProgress(GetAnimationId(id, 0), (float)ImMin(((double)decimated - state->ScrollHead) / samples_count, 1.0), 0.0f, width, dt) * samples_count;
+	const ImU64 head = buffer.Head.load(std::memory_order_relaxed);
+	const float arrival_speed = fresh ? 0.0f : (float)((double)(head - state->LastHead) * px_per_sample / ImMax(g.IO.DeltaTime, 0.001f));
+	ScheduleAnimation(GetAnimationId(id, 1), 0.1f, arrival_speed);
+	state->LastHead = head;
+	state->LastFrame = g.FrameCount;
+
+	// Visible columns, from the one sliding out on the left to the newest one
+	const int ring = state->ColumnMin.Size;
+	const ImU64 spc = (ImU64)samples_per_column;
+	const double first_sample = ImMax(state->ScrollHead - samples_count, 0.0);
+	ImU64 column_first = (ImU64)first_sample / spc;
+	const ImU64 column_last = (decimated > 0) ? (decimated - 1) / spc : 0;
+	if (column_last >= (ImU64)ring)
+		column_first = ImMax(column_first, column_last - (ImU64)ring + 1);
+	const int visible_count = (decimated > 0 && column_last >= column_first) ? (int)(column_last - column_first + 1) : 0;
+
+	// Scale: given, or eased toward the visible range
+	float range_min = FLT_MAX, range_max = -FLT_MAX;
+	if (scale_min == FLT_MAX || scale_max == FLT_MAX)
+		for (int n = 0; n < visible_count; n++)
+		{
+			const int slot = (int)((column_first + n) % (ImU64)ring);
+			range_min = ImMin(range_min, state->ColumnMin[slot]);
+			range_max = ImMax(range_max, state->ColumnMax[slot]);
+		}
+	if (scale_min != FLT_MAX)
+		range_min = scale_min;
+	if (scale_max != FLT_MAX)
+		range_max = scale_max;
+	if (range_min > range_max)
+		range_min = range_max = 0.0f;
+	if (range_min == range_max)
+	{
+		range_min -= 0.5f;
+		range_max += 0.5f;
+	}
+	const float height = inner_bb.GetHeight();
+	const float range = range_max - range_min;
+	if (fresh)
+	{
+		state->ScaleMin = range_min;
+		state->ScaleMax = range_max;
+	}
+	else
+	{
+		state->ScaleMin = range_min + AnimateProgress(GetAnimationId(id, 2), ImClamp((state->ScaleMin - range_min) / range, -1.0f, 1.0f), 0.0f, height, dt) * range;
+		state->ScaleMax = range_max + AnimateProgress(GetAnimationId(id, 3), ImClamp((state->ScaleMax - range_max) / range, -1.0f, 1.0f), 0.0f, height, dt) * range;
+	}
 
-	bool hovered, held;
-	bool pressed = ButtonBehavior(bb, id, &hovered, &held, flags);
-	if (pressed)
-		MarkItemEdited(id);
+	const double scroll_head = state->ScrollHead;
+	const ImU32 cols[] = { GetColorU32(ImGuiCol_FrameBg), GetColorU32(ImGuiCol_PlotLines), ImHashData(&scroll_head, sizeof(scroll_head), ImHashData(&decimated, sizeof(decimated))) };
+	const float render_values[] = { state->ScaleMin, state->ScaleMax, (float)samples_count };
+	if (RenderCacheBegin(id, frame_bb, RenderCacheKey(frame_bb, NULL, NULL, cols, IM_ARRAYSIZE(cols), render_values, IM_ARRAYSIZE(render_values))))
+		return;
 
-	// Animation
-	float last_active_id_timer = g.LastActiveIdTimer;
-	if (held || pressed)
-		g.LastActiveIdTimer = 0.f;
+	RenderFrame(frame_bb.Min, frame_bb.Max, cols[0], true, style.FrameRounding);
+	if (visible_count > 0)
+	{
+		ImDrawList* draw_list = window->DrawList;
+		const ImVec2 uv = draw_list->_Data->TexUvWhitePixel;
+		const float scale = (state->ScaleMax != state->ScaleMin) ? height / (state->ScaleMax - state->ScaleMin) : 0.0f;
+		const int idx_count = visible_count > 1 ? (visible_count - 1) * 6 : 6;
+		const int vtx_count = visible_count > 1 ? visible_count * 2 : 4;
+		draw_list->PrimReserve(idx_count, vtx_count);
+		ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+		ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+		const unsigned int vtx_start = draw_list->_VtxCurrentIdx;
+		int vtx_written = 0;
+		float prev_top = 0.0f, prev_bottom = 0.0f;
+		for (int n = 0; n < visible_count; n++)
+		{
+			const ImU64 column = column_first + n;
+			const int slot = (int)(column % (ImU64)ring);
+			const float v_min = state->ColumnMin[slot], v_max = state->ColumnMax[slot];
+			if (v_min > v_max) // No number in this column
+				continue;
+			float top = ImClamp(inner_bb.Max.y - (v_max - state->ScaleMin) * scale, inner_bb.Min.y, inner_bb.Max.y);
+			float bottom = ImClamp(inner_bb.Max.y - (v_min - state->ScaleMin) * scale, inner_bb.Min.y, inner_bb.Max.y);
+			const float t = top, b = bottom;
+			if (vtx_written > 0)
+			{
+				top = ImMin(top, prev_bottom);
+				bottom = ImMax(bottom, prev_top);
+			}
+			if (bottom - top < 1.0f)
+			{
+				const float center = ImClamp((top + bottom) * 0.5f, inner_bb.Min.y + 0.5f, inner_bb.Max.y - 0.5f);
+				top = center - 0.5f;
+				bottom = center + 0.5f;
+			}
+			prev_top = t;
+			prev_bottom = b;
+			const float x = ImClamp((float)((double)inner_bb.Max.x - (scroll_head - ((double)column + 0.5) * spc) * px_per_sample), inner_bb.Min.x, inner_bb.Max.x);
+			vtx_write[0].pos = ImVec2(x, top); vtx_write[0].uv = uv; vtx_write[0].col = cols[1];
+			vtx_write[1].pos = ImVec2(x, bottom); vtx_write[1].uv = uv; vtx_write[1].col = cols[1];
+			if (vtx_written > 0)
+			{
+				const unsigned int i = vtx_start + (unsigned int)vtx_written;
+				idx_write[0] = (ImDrawIdx)(i - 2); idx_write[1] = (ImDrawIdx)(i); idx_write[2] = (ImDrawIdx)(i + 1);
+				idx_write[3] = (ImDrawIdx)(i - 2); idx_write[4] = (ImDrawIdx)(i + 1); idx_write[5] = (ImDrawIdx)(i - 1);
+				idx_write += 6;
+			}
+			vtx_write += 2;
+			vtx_written += 2;
+		}
+		if (vtx_written == 2) // A single column: a pixel wide bar
+		{
+			vtx_write[0].pos = ImVec2(vtx_write[-2].pos.x + 1.0f, vtx_write[-2].pos.y); vtx_write[0].uv = uv; vtx_write[0].col = cols[1];
+			vtx_write[1].pos = ImVec2(vtx_write[-1].pos.x + 1.0f, vtx_write[-1].pos.y); vtx_write[1].uv = uv; vtx_write[1].col = cols[1];
+			idx_write[0] = (ImDrawIdx)(vtx_start); idx_write[1] = (ImDrawIdx)(vtx_start + 2); idx_write[2] = (ImDrawIdx)(vtx_start + 3);
+			idx_write[3] = (ImDrawIdx)(vtx_start); idx_write[4] = (ImDrawIdx)(vtx_start + 3); idx_write[5] = (ImDrawIdx)(vtx_start + 1);
+			vtx_write += 2;
+			idx_write += 6;
+			vtx_written += 2;
+		}
+		const int idx_written = (int)(idx_write - draw_list->_IdxWritePtr);
+		draw_list->_VtxWritePtr = vtx_write;
+		draw_list->_IdxWritePtr = idx_write;
+		draw_list->_VtxCurrentIdx += (unsigned int)vtx_written;
+		draw_list->PrimUnreserve(idx_count - idx_written, vtx_count - vtx_written);
+	}
+	RenderCacheEnd();
+}
 
-	if (g.LastActiveIdTimer == 0.f && g.LastActiveId == id && !pressed)
-		g.LastActiveIdTimer = last_active_id_timer;
+void ImExt::Sparkline(const char* str_id, const ImExtSparklineBuffer& buffer, const ImVec2& size, float scale_min, float scale_max, int samples_count, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return;
+	SparklineEx(GetLabelID(window, str_id), buffer, size, scale_min, scale_max, samples_count, dt);
+}
 
-	float t = held ? 1.0f : 0.0f;
+void ImExt::Sparkline(const ImExtLabel& str_id, const ImExtSparklineBuffer& buffer, const ImVec2& size, float scale_min, float scale_max, int samples_count, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return;
+	SparklineEx(GetLabelID(window, str_id), buffer, size, scale_min, scale_max, samples_count, dt);
+}
 
-	if (g.LastActiveId == id)
+// Columns are aligned on multiples of the values per pixel, so panning doesn't re-bin the values under a fixed pixel. Each
+// column reads the coarsest pyramid level with blocks smaller than a pixel, at most 8 blocks per pixel: the cost depends on
+// the width, not on the number of values shown. Columns are drawn as a zigzag through their min and max, a line per segment:
+// a joined polyline would spike at the sharp turns.
+static void BuildPlotPolyline(ImVector<ImVec2>& points, const ImExtPlotSeries& series, double view_min, double view_max, const ImRect& bb, float scale_min, float scale_max, float* out_min, float* out_max)
+{
+	points.resize(0);
+	const int count = series.Values.Size;
+	const double values_per_px = (view_max - view_min) / bb.GetWidth();
+	const float y_scale = (scale_max != scale_min) ? (bb.GetHeight() - 1.0f) / (scale_max - scale_min) : 0.0f;
+	float range_min = FLT_MAX, range_max = -FLT_MAX;
+	if (values_per_px < 1.0)
 	{
-		float t_anim = ImSaturate(g.LastActiveIdTimer / 0.08f * dt);
-		t = held ? (t_anim) : (1.0f - t_anim);
+		// Zoomed in: the values themselves, the ones just outside the view included
+		const int i0 = ImMax((int)floor(view_min - 0.5), 0), i1 = ImMin((int)ceil(view_max + 0.5), count);
+		for (int i = i0; i < i1; i++)
+		{
+			const float v = series.Values.Data[i];
+			if (v != v)
+				continue;
+			points.push_back(ImVec2((float)(bb.Min.x + (i + 0.5 - view_min) / values_per_px), bb.Max.y - 1.0f - (v - scale_min) * y_scale));
+			if (i + 0.5 >= view_min && i + 0.5 <= view_max)
+			{
+				range_min = ImMin(range_min, v);
+				range_max = ImMax(range_max, v);
+			}
+		}
 	}
+	else
+	{
+		int level = -1;
+		while (level + 1 < IMEXT_PLOT_SERIES_LEVELS && (double)(1 << (3 * (level + 2))) <= values_per_px)
+			level++;
+		const double column_first = floor(view_min / values_per_px), column_last = ceil(view_max / values_per_px);
+		bool down = false;
+		for (double column = column_first; column < column_last; column++)
+		{
+			const int i0 = ImMax((int)(column * values_per_px), 0), i1 = ImMin((int)((column + 1.0) * values_per_px), count);
+			if (i0 >= i1)
+				continue;
+			float v_min, v_max;
+			PlotSeriesMinMax(series, level, i0, i1, &v_min, &v_max);
+			if (v_min > v_max)
+				continue;
+			range_min = ImMin(range_min, v_min);
+			range_max = ImMax(range_max, v_max);
+			const float x = (float)(bb.Min.x + column - view_min / values_per_px);
+			const float y_min = bb.Max.y - 1.0f - (v_min - scale_min) * y_scale, y_max = bb.Max.y - 1.0f - (v_max - scale_min) * y_scale;
+			points.push_back(ImVec2(x, down ? y_max : y_min));
+			if (y_min != y_max)
+				points.push_back(ImVec2(x, down ? y_min : y_max));
+			down = !down;
+		}
+	}
+	*out_min = range_min;
+	*out_max = range_max;
+
+	// Cut the first and last segments at the edges, the render cache needs a single draw command: no clip rectangle.
+	// AddLine() draws through pixel centers, hence the last pixel row and column left out.
+	const float x_min = bb.Min.x, x_max = bb.Max.x - 1.0f;
+	int first = 0;
+	while (first + 1 < points.Size && points[first + 1].x <= x_min)
+		first++;
+	if (first > 0)
+		points.erase(points.Data, points.Data + first);
+	if (points.Size >= 2 && points[0].x < x_min)
+		points[0] = ImLerp(points[0], points[1], (x_min - points[0].x) / (points[1].x - points[0].x));
+	while (points.Size >= 2 && points[points.Size - 2].x >= x_max)
+		points.pop_back();
+	if (points.Size >= 2 && points.back().x > x_max)
+	{
+		const ImVec2& prev = points[points.Size - 2];
+		points.back() = ImLerp(prev, points.back(), (x_max - prev.x) / (points.back().x - prev.x));
+	}
+	for (int n = 0; n < points.Size; n++)
+		points[n].y = ImClamp(points[n].y, bb.Min.y, bb.Max.y - 1.0f);
+}
 
-	const float scale = item_size.x / 30.f * t;
-	const ImRect render_bb = ImRect(ImVec2(pos.x + (scale / 2), pos.y + (scale / 2 * (item_size.y / item_size.x))), ImVec2(pos.x + (item_size.x - scale), pos.y + (item_size.y - (scale * (item_size.y / item_size.x)))));
+void ImExt::PlotEx(ImGuiID id, const char* label, const char* label_end, const ImExtPlotSeries& series, const ImVec2& size, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
+	const ImGuiStyle& style = g.Style;
 
-	// Render
-	const ImU32 col = *v ? GetColorU32(ImGuiCol_ButtonActive) : GetColorU32((held && hovered) ? ImGuiCol_ButtonActive : hovered ? ImGuiCol_ButtonHovered : ImGuiCol_Button);
-	RenderNavHighlight(bb, id);
-	const ImVec2 pos_min = ImVec2(render_bb.Min.x + style.FramePadding.x / 2, render_bb.Min.y + style.FramePadding.y / 2);
-	const ImVec2 pos_max = ImVec2(render_bb.Max.x - style.FramePadding.x, render_bb.Max.y - style.FramePadding.y);
-	RenderFrame(pos_min, pos_max, col, true, style.FrameRounding);
+	const ImVec2 label_size = CalcLabelSize(label, label_end);
+	const ImVec2 frame_size = CalcItemSize(size, CalcItemWidth(), GetFrameHeight() * 6.0f);
+	const ImRect frame_bb(window->DC.CursorPos, ImVec2(window->DC.CursorPos.x + frame_size.x, window->DC.CursorPos.y + frame_size.y));
+	const ImRect inner_bb(ImVec2(frame_bb.Min.x + style.FramePadding.x, frame_bb.Min.y + style.FramePadding.y), ImVec2(frame_bb.Max.x - style.FramePadding.x, frame_bb.Max.y - style.FramePadding.y));
+	const ImRect total_bb(frame_bb.Min, ImVec2(frame_bb.Max.x + (label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f), frame_bb.Max.y));
+	ItemSize(total_bb, style.FramePadding.y);
+	if (!ItemAdd(total_bb, id, &frame_bb))
+		return;
 
-	if (g.LogEnabled)
-		LogSetNextTextDecoration("[", "]");
-	RenderTextClipped(pos_min, pos_max, label, NULL, &label_size, style.ButtonTextAlign, &render_bb);
+	bool hovered, held;
+	ButtonBehavior(frame_bb, id, &hovered, &held);
+	SetItemUsingMouseWheel();
 
-	float progress_size = pos_min.x;
-	if (v && v_progress)
+	ImExtPlotState* state = e.Plots.GetOrAddByKey(id);
+	const int count = series.Values.Size;
+	const bool fresh = state->LastFrame < g.FrameCount - 1;
+	const double width = ImMax(inner_bb.GetWidth(), 1.0f);
+	const double min_span = ImMin(8.0, (double)ImMax(count, 1));
+
+	// Follow appended values while the view reaches the end
+	if (!state->FitAll && count > state->LastCount && state->ViewMax >= state->LastCount)
 	{
-		if (*v_progress == 1.0f && pressed)
-			*v = !*v;
+		state->ViewMin += count - state->LastCount;
+		state->ViewMax += count - state->LastCount;
+	}
+	state->LastCount = count;
+	state->LastFrame = g.FrameCount;
 
-		*v_progress = held ? (*v_progress < 1.0f ? *v_progress + v_speed : 1.0f) : 0.0f;
+	// Zoom around the mouse, pan by dragging (immediate), fit all on double-click
+	if (hovered && g.IO.MouseClickedCount[0] == 2)
+		state->FitAll = true;
+	if (hovered && g.IO.MouseWheel != 0.0f)
+	{
+		const double zoom = pow(0.8, (double)g.IO.MouseWheel);
+		const double pivot = state->ViewMin + (state->ViewMax - state->ViewMin) * ImSaturate((g.IO.MousePos.x - inner_bb.Min.x) / (float)width);
+		const double span = ImClamp((state->ViewMax - state->ViewMin) * zoom, min_span, (double)ImMax(count, 1));
+		const double pivot_t = (pivot - state->ViewMin) / (state->ViewMax - state->ViewMin);
+		state->ViewMin = pivot - span * pivot_t;
+		state->ViewMax = state->ViewMin + span;
+		state->FitAll = false;
+	}
+	if (held && g.IO.MouseDelta.x != 0.0f)
+	{
+		const double delta = -g.IO.MouseDelta.x * (state->ShownMax - state->ShownMin) / width;
+		state->ViewMin += delta;
+		state->ViewMax += delta;
+		state->ShownMin += delta;
+		state->ShownMax += delta;
+		state->FitAll = false;
+	}
+	if (state->FitAll)
+	{
+		state->ViewMin = 0.0;
+		state->ViewMax = ImMax(count, 1);
+	}
+	const double span = state->ViewMax - state->ViewMin;
+	const double shift = (state->ViewMin < 0.0) ? -state->ViewMin : (state->ViewMax > ImMax(count, 1)) ? ImMax(ImMax(count, 1) - state->ViewMax, -state->ViewMin) : 0.0;
+	state->ViewMin += shift;
+	state->ViewMax += shift;
+
+	// Eased through the scheduler, without reading the values: only the polyline below depends on them
+	if (fresh)
+	{
+		state->ShownMin = state->ViewMin;
+		state->ShownMax = state->ViewMax;
+	}
+	else
+	{
+		state->ShownMin = state->ViewMin + AnimateProgress(GetAnimationId(id, 0), (float)((state->ShownMin - state->ViewMin) / span), 0.0f, (float)width, dt) * span;
+		state->ShownMax = state->ViewMax + AnimateProgress(GetAnimationId(id, 1), (float)((state->ShownMax - state->ViewMax) / span), 0.0f, (float)width, dt) * span;
+	}
+
+	// The vertical range is the one of the values drawn during the previous frame, eased
+	ImVector<ImVec2>& points = e.PlotPoints;
+	float range_min, range_max;
+	BuildPlotPolyline(points, series, state->ShownMin, state->ShownMax, inner_bb, state->ScaleMin, state->ScaleMax, &range_min, &range_max);
+	if (range_min > range_max)
+		range_min = range_max = 0.0f;
+	const float margin = ImMax((range_max - range_min) * 0.05f, 0.5f);
+	range_min -= margin;
+	range_max += margin;
+	const float range = range_max - range_min;
+	const float height = inner_bb.GetHeight();
+	const float scale_min = state->ScaleMin, scale_max = state->ScaleMax;
+	if (fresh || scale_min == scale_max)
+	{
+		state->ScaleMin = range_min;
+		state->ScaleMax = range_max;
+	}
+	else
+	{
+		state->ScaleMin = range_min + AnimateProgress(GetAnimationId(id, 2), ImClamp((state->ScaleMin - range_min) / range, -1.0f, 1.0f), 0.0f, height, dt) * range;
+		state->ScaleMax = range_max + AnimateProgress(GetAnimationId(id, 3), ImClamp((state->ScaleMax - range_max) / range, -1.0f, 1.0f), 0.0f, height, dt) * range;
+	}
+	if (state->ScaleMin != scale_min || state->ScaleMax != scale_max)
+		BuildPlotPolyline(points, series, state->ShownMin, state->ShownMax, inner_bb, state->ScaleMin, state->ScaleMax, &range_min, &range_max);
+
+	const ImU32 cols[] = { GetColorU32(ImGuiCol_FrameBg), GetColorU32(hovered ? ImGuiCol_PlotLinesHovered : ImGuiCol_PlotLines), ImHashData(points.Data, (size_t)points.Size * sizeof(ImVec2)) };
+	if (RenderCacheBegin(id, total_bb, RenderCacheKey(total_bb, label, label_end, cols, IM_ARRAYSIZE(cols), NULL, 0)))
+		return;
+	RenderFrame(frame_bb.Min, frame_bb.Max, cols[0], true, style.FrameRounding);
+	for (int n = 0; n + 1 < points.Size; n++)
+		window->DrawList->AddLine(points[n], points[n + 1], cols[1]);
+	if (label_size.x > 0.0f)
+		RenderText(ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, inner_bb.Min.y), label, label_end, false);
+	RenderCacheEnd();
+}
+
+void ImExt::Plot(const char* label, const ImExtPlotSeries& series, const ImVec2& size, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return;
+	PlotEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), series, size, dt);
+}
+
+void ImExt::Plot(const ImExtLabel& label, const ImExtPlotSeries& series, const ImVec2& size, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return;
+	PlotEx(GetLabelID(window, label), label.Text, label.TextEnd, series, size, dt);
+}
+
+// Only the rows ImGuiListClipper reports visible are looked up: from the closest indexed offset, or from the end of the
+// row above. A thin bar along the top shows indexing then filtering progress.
+void ImExt::LogViewEx(ImGuiID id, ImExtLogFile& file, const char* filter, const ImVec2& size, const float dt)
+{
+	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
+	ImExtLogFileData* data = file.Data;
+	if (data != NULL)
+	{
+		SyncLogFile(data, g.Time);
+		UpdateRetiredLogFilters(data);
+		const bool filtered = (filter != NULL && filter[0] != 0);
+		if (data->Filter != NULL && (!filtered || strcmp(filter, data->Filter->Pattern.Data) != 0))
+		{
+			RetireLogFilter(data, data->Filter);
+			data->Filter = NULL;
+		}
+		if (filtered && data->Filter == NULL)
+			data->Filter = CreateLogFilter(filter);
+		if (data->Filter != NULL)
+			UpdateLogFilter(e, data, data->Filter);
+		int faded = 0;
+		while (faded < data->Arrivals.Size && (float)(g.Time - data->Arrivals[faded].Time) * dt >= IMEXT_LOG_FADE_DURATION)
+			faded++;
+		if (faded > 0)
+			data->Arrivals.erase(data->Arrivals.Data, data->Arrivals.Data + faded);
+	}
 
-		progress_size += *v_progress * (pos_max.x - pos_min.x);
-		if (*v_progress > 0.0f)
+	if (!BeginChild(id, size, true, ImGuiWindowFlags_HorizontalScrollbar) || data == NULL)
+	{
+		EndChild();
+		return;
+	}
+	ImGuiWindow* window = GetCurrentWindow();
+	const ImExtLogFilter* log_filter = data->Filter;
+	const ImExtLogMapping* mapping = data->ViewMapping;
+	const bool partial_line = (log_filter == NULL && data->ViewCaughtUp && mapping != NULL && mapping->Size > data->ViewIndexedEnd);
+	const int rows_count = log_filter ? log_filter->Matches.Size : data->ViewLinesCount + (partial_line ? 1 : 0);
+	const bool follow = (GetScrollY() >= GetScrollMaxY());
+	const float line_height = GetTextLineHeightWithSpacing();
+	const bool highlight = (e.IO.LodLevel < ImExtLod_Minimal);
+	float fade_max = 0.0f;
+
+	ImGuiListClipper clipper;
+	clipper.Begin(rows_count, line_height);
+	while (clipper.Step())
+	{
+		int line = -2;
+		ImU64 offset = 0;
+		for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
 		{
-			ImColor frame_color = ImColor(0.5f + (*v_progress) / 2.f, 0.5f + (*v_progress) / 2.f, 0.5f + (*v_progress) / 2.f, *v_progress);
-			ImColor text_color = ImColor(1.f - frame_color.Value.x, 1.f - frame_color.Value.y, 1.f - frame_color.Value.z, *v_progress);
-			RenderFrame(pos_min, ImVec2(progress_size, pos_max.y), frame_color, true, style.FrameRounding);
-			ImDraw::RenderTextClipped(pos_min, pos_max, label, NULL, &label_size, text_color, style.ButtonTextAlign, &render_bb);
+			const int row_line = log_filter ? log_filter->Matches[row] : row;
+			if (row_line != line + 1)
+				offset = GetLogLineOffset(data, row_line);
+			line = row_line;
+			const char* text;
+			const char* text_end;
+			offset = GetLogLine(mapping, offset, mapping->Size, &text, &text_end);
+			const float fade = highlight ? GetLogLineFade(data, line, g.Time, dt) : 0.0f;
+			if (fade > 0.0f)
+			{
+				const float y = window->DC.CursorPos.y;
+				window->DrawList->AddRectFilled(ImVec2(window->InnerClipRect.Min.x, y), ImVec2(window->InnerClipRect.Max.x, y + line_height), GetColorU32(ImGuiCol_TextSelectedBg, fade));
+				fade_max = ImMax(fade_max, fade);
+			}
+			TextUnformatted(text, text_end);
 		}
 	}
+	clipper.End();
+	if (follow)
+		SetScrollHereY(1.0f);
+
+	float progress = 1.0f;
+	if (!data->ViewCaughtUp && mapping != NULL)
+		progress = (float)((double)data->ViewIndexedEnd / (double)mapping->Size);
+	else if (log_filter != NULL && log_filter->LinesDone < data->ViewLinesCount)
+		progress = (float)log_filter->LinesDone / (float)data->ViewLinesCount;
+	if (progress < 1.0f)
+	{
+		const ImRect& bar_bb = window->InnerRect;
+		window->DrawList->AddRectFilled(bar_bb.Min, ImVec2(ImLerp(bar_bb.Min.x, bar_bb.Max.x, progress), bar_bb.Min.y + 2.0f), GetColorU32(ImGuiCol_PlotHistogram));
+	}
+	EndChild();
 
-	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags);
-	return pressed;
+	// Appended lines are picked up without input, new ones fade a colour step per frame
+	ScheduleAnimation(GetAnimationId(id, 0), IMEXT_LOG_POLL_INTERVAL / 1000.0f, 0.0f);
+	if (fade_max > 0.0f)
+		ScheduleAnimation(GetAnimationId(id, 1), fade_max * IMEXT_LOG_FADE_DURATION / dt, 255.0f * dt / IMEXT_LOG_FADE_DURATION);
 }
 
-IMGUI_API bool ImExt::ToggleSwitch(const char* label, bool* v, const float dt)
+void ImExt::LogView(const char* str_id, ImExtLogFile& file, const char* filter, const ImVec2& size, const float dt)
 {
 	ImGuiWindow* window = GetCurrentWindow();
 	if (window->SkipItems)
-		return false;
-
-	ImGuiContext& g = *GImGui;
-	const ImGuiStyle& style = g.Style;
-	const ImGuiID id = window->GetID(label);
-	const ImVec2 label_size = CalcTextSize(label, NULL, true);
-
-	float height = ImGui::GetFrameHeight();
-	const ImVec2 pos = window->DC.CursorPos;
-
-	float width = height * 2.f;
-	float radius = height * 0.50f;
+		return;
+	LogViewEx(GetLabelID(window, str_id), file, filter, size, dt);
+}
 
-	const ImRect total_bb(pos, ImVec2(pos.x + width + (label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f), pos.y + label_size.y + style.FramePadding.y * 2.0f));
+void ImExt::LogView(const ImExtLabel& str_id, ImExtLogFile& file, const char* filter, const ImVec2& size, const float dt)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return;
+	LogViewEx(GetLabelID(window, str_id), file, filter, size, dt);
+}
 
-	ItemSize(total_bb, style.FramePadding.y);
-	if (!ItemAdd(total_bb, id))
-		return false;
+// Line 'line' of 'buffer' into e.TextEditorLine, without its line break. Return its offset.
+static int ReadTextEditorLine(ImExtContext& e, const ImExtTextBuffer& buffer, int line)
+{
+	const int start = buffer.GetLineStart(line);
+	const int end = (line + 1 < buffer.GetLinesCount()) ? buffer.GetLineStart(line + 1) - 1 : buffer.GetLength();
+	buffer.GetText(start, end - start, &e.TextEditorLine);
+	return start;
+}
 
-	float last_active_id_timer = g.LastActiveIdTimer;
+static float CalcTextEditorColumnX(const char* text, const char* column)
+{
+	ImGuiContext& g = *GImGui;
+	return g.Font->CalcTextSizeA(g.FontSize, FLT_MAX, 0.0f, text, column).x;
+}
 
-	bool hovered, held;
-	bool pressed = ButtonBehavior(total_bb, id, &hovered, &held);
-	if (pressed)
+// Byte of 'text' closest to 'x', on a character boundary
+static int FindTextEditorColumn(const char* text, const char* text_end, float x)
+{
+	ImGuiContext& g = *GImGui;
+	const float scale = g.FontSize / g.Font->FontSize;
+	float line_x = 0.0f;
+	for (const char* p = text; p < text_end; )
 	{
-		*v = !(*v);
-		MarkItemEdited(id);
-		g.LastActiveIdTimer = 0.f;
+		unsigned int c;
+		const int bytes = ImTextCharFromUtf8(&c, p, text_end);
+		const float advance = (c == '\r') ? 0.0f : g.Font->GetCharAdvance((ImWchar)c) * scale;
+		if (x < line_x + advance * 0.5f)
+			return (int)(p - text);
+		line_x += advance;
+		p += bytes;
 	}
+	return (int)(text_end - text);
+}
 
-	if (g.LastActiveIdTimer == 0.f && g.LastActiveId == id && !pressed)
-		g.LastActiveIdTimer = last_active_id_timer;
-
-	float t = *v ? 1.0f : 0.0f;
-	float circle_t = held ? 1.0f : 0.0f;
+static bool IsTextEditorWordChar(char c)
+{
+	return (c & 0x80) || c == '_' || (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
 
-	if (g.LastActiveId == id)
+// Offset of the character before/after 'offset', or of the word start/end with 'word'. Crosses line breaks.
+static int MoveTextEditorCursor(ImExtContext& e, const ImExtTextBuffer& buffer, int offset, int dir, bool word)
+{
+	const int line = buffer.GetLineFromOffset(offset);
+	const int start = ReadTextEditorLine(e, buffer, line);
+	const char* text = e.TextEditorLine.Data;
+	const int column = offset - start, length = e.TextEditorLine.Size - 1;
+	if (dir < 0 && column == 0)
+		return ImMax(offset - 1, 0);
+	if (dir > 0 && column == length)
+		return ImMin(offset + 1, buffer.GetLength());
+	int n = column;
+	if (dir < 0)
 	{
-		float t_anim = ImSaturate(g.LastActiveIdTimer / 0.16f * dt);
-		t = *v ? (t_anim) : (1.0f - t_anim);
-		circle_t = held ? (t_anim) : (1.0f - t_anim);
+		do { n--; } while (n > 0 && (text[n] & 0xC0) == 0x80);
+		if (word)
+		{
+			while (n > 0 && !IsTextEditorWordChar(text[n]))
+				n--;
+			while (n > 0 && IsTextEditorWordChar(text[n - 1]))
+				n--;
+		}
 	}
+	else
+	{
+		do { n++; } while (n < length && (text[n] & 0xC0) == 0x80);
+		if (word)
+		{
+			while (n < length && IsTextEditorWordChar(text[n - 1]) && IsTextEditorWordChar(text[n]))
+				n++;
+			while (n < length && !IsTextEditorWordChar(text[n]))
+				n++;
+		}
+	}
+	return start + n;
+}
 
-	ImU32 col_bg = GetColorU32((held && hovered) ? ImGuiCol_FrameBgActive : hovered ? ImGuiCol_FrameBgHovered : ImGuiCol_FrameBg);
-
-	const ImRect frame_bb(pos, ImVec2(pos.x + width, pos.y + height));
-
-	RenderFrame(frame_bb.Min, frame_bb.Max, col_bg, true, height * 0.5f);
-	RenderNavHighlight(total_bb, id);
+// Offset on line 'line' closest to 'x'
+static int FindTextEditorOffset(ImExtContext& e, const ImExtTextBuffer& buffer, int line, float x)
+{
+	line = ImClamp(line, 0, buffer.GetLinesCount() - 1);
+	const int start = ReadTextEditorLine(e, buffer, line);
+	return start + FindTextEditorColumn(e.TextEditorLine.Data, e.TextEditorLine.Data + e.TextEditorLine.Size - 1, x);
+}
 
-	ImVec2 label_pos = ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, frame_bb.Min.y + style.FramePadding.y);
-	RenderText(label_pos, label);
-	window->DrawList->AddCircleFilled(ImVec2(pos.x + radius + t * (width - radius * 2.0f), pos.y + radius), radius - (circle_t * radius) / 5.f, ImGui::GetColorU32(ImGuiCol_CheckMark), 16);
+// Caret position from the top left of the text
+static ImVec2 CalcTextEditorCaretPos(ImExtContext& e, const ImExtTextBuffer& buffer, int offset)
+{
+	ImGuiContext& g = *GImGui;
+	const int line = buffer.GetLineFromOffset(offset);
+	const int start = ReadTextEditorLine(e, buffer, line);
+	return ImVec2(CalcTextEditorColumnX(e.TextEditorLine.Data, e.TextEditorLine.Data + (offset - start)), line * g.FontSize);
+}
 
-	return pressed;
+static void DeleteTextEditorSelection(ImExtTextBuffer& buffer, ImExtTextEditorState* state)
+{
+	const int sel_min = ImMin(state->Cursor, state->SelectionAnchor), sel_max = ImMax(state->Cursor, state->SelectionAnchor);
+	buffer.Delete(sel_min, sel_max - sel_min);
+	state->Cursor = state->SelectionAnchor = sel_min;
 }
 
-bool ImExt::RadioButton(const char* label, bool active, const float dt)
+static void InsertTextEditorText(ImExtTextBuffer& buffer, ImExtTextEditorState* state, const char* text, const char* text_end)
 {
-	ImGuiWindow* window = GetCurrentWindow();
-	if (window->SkipItems)
-		return false;
+	DeleteTextEditorSelection(buffer, state);
+	buffer.Insert(state->Cursor, text, text_end);
+	state->Cursor = state->SelectionAnchor = state->Cursor + (int)(text_end - text);
+}
 
+// Only the lines in view are read from the buffer, measured and drawn, most lines from cached glyph runs. The caret
+// slides to its new position through the animation scheduler, the selection follows its displayed end.
+bool ImExt::TextEditorEx(ImGuiID id, ImExtTextBuffer& buffer, const ImVec2& size, const float dt, ImGuiInputTextFlags flags)
+{
 	ImGuiContext& g = *GImGui;
+	ImGuiIO& io = g.IO;
+	ImExtContext& e = GetExtContext();
 	const ImGuiStyle& style = g.Style;
-	const ImGuiID id = window->GetID(label);
-	const ImVec2 label_size = CalcTextSize(label, NULL, true);
-
-	const float square_sz = GetFrameHeight();
-	const ImVec2 pos = window->DC.CursorPos;
-	const ImRect total_bb(pos, ImVec2(pos.x + square_sz + (label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f), pos.y + label_size.y + style.FramePadding.y * 2.0f));
-	ItemSize(total_bb, style.FramePadding.y);
-	if (!ItemAdd(total_bb, id))
+	const bool read_only = (flags & ImGuiInputTextFlags_ReadOnly) != 0;
+
+	const ImVec2 frame_size = CalcItemSize(size, CalcItemWidth(), g.FontSize * 8.0f + style.FramePadding.y * 2.0f);
+	PushStyleColor(ImGuiCol_ChildBg, style.Colors[ImGuiCol_FrameBg]);
+	PushStyleVar(ImGuiStyleVar_ChildRounding, style.FrameRounding);
+	PushStyleVar(ImGuiStyleVar_ChildBorderSize, style.FrameBorderSize);
+	PushStyleVar(ImGuiStyleVar_WindowPadding, style.FramePadding);
+	const bool visible = BeginChild(id, frame_size, true, ImGuiWindowFlags_HorizontalScrollbar | ImGuiWindowFlags_NoMove);
+	PopStyleVar(3);
+	PopStyleColor();
+	if (!visible)
+	{
+		EndChild();
 		return false;
+	}
 
-	bool hovered, held;
-	bool pressed = ButtonBehavior(total_bb, id, &hovered, &held);
-	if (pressed)
-		MarkItemEdited(id);
-
-	// Animation
-	float last_active_id_timer = g.LastActiveIdTimer;
-	if (held || pressed)
-		g.LastActiveIdTimer = 0.f;
-
-	if (g.LastActiveIdTimer == 0.f && g.LastActiveId == id && !pressed)
-		g.LastActiveIdTimer = last_active_id_timer;
-
-	float t = active ? 1.0f : 0.0f;
-	float circle_t = held ? 1.0f : 0.0f;
-
-	if (g.LastActiveId == id)
+	ImGuiWindow* window = GetCurrentWindow();
+	ImExtTextEditorState* state = e.TextEditors.GetOrAddByKey(id);
+	state->LastFrame = g.FrameCount;
+	state->Cursor = ImClamp(state->Cursor, 0, buffer.GetLength());
+	state->SelectionAnchor = ImClamp(state->SelectionAnchor, 0, buffer.GetLength());
+
+	const float line_height = g.FontSize;
+	const ImRect view_bb = window->InnerClipRect;
+	const ImVec2 origin = window->DC.CursorPos; // Top left of the text
+	ItemAdd(view_bb, id, NULL, ImGuiItemFlags_Inputable);
+	const bool hovered = ItemHoverable(view_bb, id);
+	if (hovered)
+		g.MouseCursor = ImGuiMouseCursor_TextInput;
+
+	// Mouse: click places the caret, shift-click and dragging select, double-click selects a word
+	const int cursor_prev = state->Cursor;
+	bool edited = false;
+	if (hovered && io.MouseClicked[0])
 	{
-		float t_anim = ImSaturate(g.LastActiveIdTimer / 0.16f * dt);
-		t = active ? (t_anim) : (1.0f - t_anim);
-		circle_t = held ? (t_anim) : (1.0f - t_anim);
+		if (g.ActiveId != id)
+		{
+			SetActiveID(id, window);
+			SetFocusID(id, window);
+			FocusWindow(window);
+			g.ActiveIdUsingNavDirMask |= (1 << ImGuiDir_Left) | (1 << ImGuiDir_Right) | (1 << ImGuiDir_Up) | (1 << ImGuiDir_Down);
+			g.ActiveIdUsingNavInputMask |= (1 << ImGuiNavInput_Cancel);
+			SetActiveIdUsingKey(ImGuiKey_Home);
+			SetActiveIdUsingKey(ImGuiKey_End);
+			SetActiveIdUsingKey(ImGuiKey_PageUp);
+			SetActiveIdUsingKey(ImGuiKey_PageDown);
+			if (flags & ImGuiInputTextFlags_AllowTabInput)
+				SetActiveIdUsingKey(ImGuiKey_Tab);
+		}
+		state->Cursor = FindTextEditorOffset(e, buffer, (int)ImFloor((io.MousePos.y - origin.y) / line_height), io.MousePos.x - origin.x);
+		if (io.MouseClickedCount[0] == 2)
+		{
+			state->SelectionAnchor = MoveTextEditorCursor(e, buffer, MoveTextEditorCursor(e, buffer, state->Cursor, +1, false), -1, true);
+			state->Cursor = MoveTextEditorCursor(e, buffer, state->SelectionAnchor, +1, true);
+		}
+		else if (!io.KeyShift)
+		{
+			state->SelectionAnchor = state->Cursor;
+		}
+		state->Dragging = true;
+		state->PreferredX = -1.0f;
 	}
+	else if (g.ActiveId == id && io.MouseClicked[0] && g.HoveredWindow != window)
+	{
+		ClearActiveID();
+	}
+	if (state->Dragging && !io.MouseDown[0])
+		state->Dragging = false;
+	else if (state->Dragging && !io.MouseClicked[0] && (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f))
+		state->Cursor = FindTextEditorOffset(e, buffer, (int)ImFloor((io.MousePos.y - origin.y) / line_height), io.MousePos.x - origin.x);
 
-	// Render
-	const ImRect check_bb(pos, ImVec2(pos.x + square_sz, pos.y + square_sz));
-	ImVec2 center = check_bb.GetCenter();
-	center.x = IM_ROUND(center.x);
-	center.y = IM_ROUND(center.y);
-	const float radius = (square_sz - 1.0f) * 0.5f;
-
-	RenderNavHighlight(total_bb, id);
-	window->DrawList->AddCircleFilled(center, radius - (circle_t * radius) / 5.f, GetColorU32((held && hovered) ? ImGuiCol_FrameBgActive : hovered ? ImGuiCol_FrameBgHovered : ImGuiCol_FrameBg), 16);
+	// Keyboard
+	const bool active = (g.ActiveId == id);
 	if (active)
 	{
-		const float pad = ImMax(1.0f, IM_FLOOR(square_sz / 6.0f));
-		window->DrawList->AddCircleFilled(center, (radius - pad) * t, GetColorU32(ImGuiCol_CheckMark), 16);
+		g.ActiveIdAllowOverlap = !io.MouseDown[0];
+		g.WantTextInputNextFrame = 1;
+	}
+	if (active && !g.ActiveIdIsJustActivated)
+	{
+		const bool is_osx = io.ConfigMacOSXBehaviors;
+		const bool is_wordmove_key_down = is_osx ? io.KeyAlt : io.KeyCtrl;
+		const bool is_shortcut_key = is_osx ? (io.KeyMods == ImGuiModFlags_Super) : (io.KeyMods == ImGuiModFlags_Ctrl);
+		const bool has_selection = (state->Cursor != state->SelectionAnchor);
+		const int page_lines = ImMax((int)(view_bb.GetHeight() / line_height) - 1, 1);
+		const int cursor_line = buffer.GetLineFromOffset(state->Cursor);
+		bool moved = false, vertical = false;
+		if (IsKeyPressed(ImGuiKey_LeftArrow))
+		{
+			state->Cursor = (has_selection && !io.KeyShift) ? ImMin(state->Cursor, state->SelectionAnchor) : MoveTextEditorCursor(e, buffer, state->Cursor, -1, is_wordmove_key_down);
+			moved = true;
+		}
+		else if (IsKeyPressed(ImGuiKey_RightArrow))
+		{
+			state->Cursor = (has_selection && !io.KeyShift) ? ImMax(state->Cursor, state->SelectionAnchor) : MoveTextEditorCursor(e, buffer, state->Cursor, +1, is_wordmove_key_down);
+			moved = true;
+		}
+		else if (IsKeyPressed(ImGuiKey_UpArrow) || IsKeyPressed(ImGuiKey_DownArrow) || IsKeyPressed(ImGuiKey_PageUp) || IsKeyPressed(ImGuiKey_PageDown))
+		{
+			const int lines = IsKeyPressed(ImGuiKey_UpArrow) ? -1 : IsKeyPressed(ImGuiKey_DownArrow) ? 1 : IsKeyPressed(ImGuiKey_PageUp) ? -page_lines : page_lines;
+			if (state->PreferredX < 0.0f)
+				state->PreferredX = CalcTextEditorCaretPos(e, buffer, state->Cursor).x;
+			const int line = cursor_line + lines;
+			state->Cursor = (line < 0) ? 0 : (line >= buffer.GetLinesCount()) ? buffer.GetLength() : FindTextEditorOffset(e, buffer, line, state->PreferredX);
+			moved = vertical = true;
+		}
+		else if (IsKeyPressed(ImGuiKey_Home))
+		{
+			state->Cursor = io.KeyCtrl ? 0 : buffer.GetLineStart(cursor_line);
+			moved = true;
+		}
+		else if (IsKeyPressed(ImGuiKey_End))
+		{
+			state->Cursor = io.KeyCtrl ? buffer.GetLength() : (cursor_line + 1 < buffer.GetLinesCount()) ? buffer.GetLineStart(cursor_line + 1) - 1 : buffer.GetLength();
+			moved = true;
+		}
+		else if ((IsKeyPressed(ImGuiKey_Delete) || IsKeyPressed(ImGuiKey_Backspace)) && !read_only)
+		{
+			if (!has_selection)
+				state->SelectionAnchor = MoveTextEditorCursor(e, buffer, state->Cursor, IsKeyPressed(ImGuiKey_Delete) ? +1 : -1, is_wordmove_key_down);
+			DeleteTextEditorSelection(buffer, state);
+			edited = true;
+		}
+		else if ((IsKeyPressed(ImGuiKey_Enter) || IsKeyPressed(ImGuiKey_KeypadEnter)) && !read_only)
+		{
+			InsertTextEditorText(buffer, state, "\n", "\n" + 1);
+			edited = true;
+		}
+		else if (IsKeyPressed(ImGuiKey_Tab) && (flags & ImGuiInputTextFlags_AllowTabInput) && !read_only && !io.KeyCtrl && !io.KeyAlt)
+		{
+			InsertTextEditorText(buffer, state, "\t", "\t" + 1);
+			edited = true;
+		}
+		else if (IsKeyPressed(ImGuiKey_Escape))
+		{
+			ClearActiveID();
+		}
+		else if (is_shortcut_key && IsKeyPressed(ImGuiKey_A))
+		{
+			state->SelectionAnchor = 0;
+			state->Cursor = buffer.GetLength();
+		}
+		else if (is_shortcut_key && (IsKeyPressed(ImGuiKey_C) || IsKeyPressed(ImGuiKey_X)) && has_selection)
+		{
+			const int sel_min = ImMin(state->Cursor, state->SelectionAnchor), sel_max = ImMax(state->Cursor, state->SelectionAnchor);
+			buffer.GetText(sel_min, sel_max - sel_min, &e.TextEditorLine);
+			SetClipboardText(e.TextEditorLine.Data);
+			if (IsKeyPressed(ImGuiKey_X) && !read_only)
+			{
+				DeleteTextEditorSelection(buffer, state);
+				edited = true;
+			}
+		}
+		else if (is_shortcut_key && IsKeyPressed(ImGuiKey_V) && !read_only)
+		{
+			if (const char* clipboard = GetClipboardText())
+			{
+				InsertTextEditorText(buffer, state, clipboard, clipboard + strlen(clipboard));
+				edited = true;
+			}
+		}
+		if (moved && !io.KeyShift)
+			state->SelectionAnchor = state->Cursor;
+		if (!vertical)
+			state->PreferredX = -1.0f;
+
+		// Characters, Ctrl alone is a shortcut but AltGr (Ctrl+Alt) types
+		if (!read_only && !(io.KeyCtrl && !io.KeyAlt) && !(is_osx && io.KeySuper))
+			for (int n = 0; n < io.InputQueueCharacters.Size; n++)
+			{
+				const unsigned int c = (unsigned int)io.InputQueueCharacters[n];
+				if (c < 0x20 || c == 0x7F || (c >= 0xE000 && c <= 0xF8FF)) // Control codes and private use area, like ImGui::InputText()
+					continue;
+				char utf8[5];
+				ImTextCharToUtf8(utf8, c);
+				InsertTextEditorText(buffer, state, utf8, utf8 + strlen(utf8));
+				edited = true;
+			}
+		io.InputQueueCharacters.resize(0);
+	}
+	if (state->Cursor != cursor_prev || edited)
+	{
+		state->BlinkStart = g.Time;
+		state->CaretFollow = true;
 	}
 
-	if (style.FrameBorderSize > 0.0f)
+	// Scroll the caret into view, applied now like ImGui::InputText() does
+	const ImVec2 caret_pos = CalcTextEditorCaretPos(e, buffer, state->Cursor);
+	ImVec2 draw_origin = origin;
+	if (state->CaretFollow)
 	{
-		window->DrawList->AddCircle(ImVec2(center.x + 1, center.y + 1), radius, GetColorU32(ImGuiCol_BorderShadow), 16, style.FrameBorderSize);
-		window->DrawList->AddCircle(center, radius, GetColorU32(ImGuiCol_Border), 16, style.FrameBorderSize);
+		state->CaretFollow = false;
+		const ImVec2 view_size = view_bb.GetSize();
+		ImVec2 scroll = window->Scroll;
+		if (caret_pos.y < scroll.y)
+			scroll.y = caret_pos.y;
+		else if (caret_pos.y + line_height > scroll.y + view_size.y - style.FramePadding.y * 2.0f)
+			scroll.y = caret_pos.y + line_height - view_size.y + style.FramePadding.y * 2.0f;
+		if (caret_pos.x < scroll.x)
+			scroll.x = ImMax(caret_pos.x - view_size.x * 0.25f, 0.0f);
+		else if (caret_pos.x + 1.0f > scroll.x + view_size.x - style.FramePadding.x * 2.0f)
+			scroll.x = caret_pos.x + 1.0f - view_size.x * 0.75f;
+		draw_origin = ImVec2(origin.x - (scroll.x - window->Scroll.x), origin.y - (scroll.y - window->Scroll.y));
+		window->Scroll = scroll;
 	}
 
-	ImVec2 label_pos = ImVec2(check_bb.Max.x + style.ItemInnerSpacing.x, check_bb.Min.y + style.FramePadding.y);
-	if (g.LogEnabled)
-		LogRenderedText(&label_pos, active ? "(x)" : "( )");
-	if (label_size.x > 0.0f)
-		RenderText(label_pos, label);
+	// The caret eases toward its position, jumps when out of view
+	if (ImFabs(caret_pos.y - state->CaretShown.y) > view_bb.GetHeight() || ImFabs(caret_pos.x - state->CaretShown.x) > view_bb.GetWidth())
+		state->CaretShown = caret_pos;
+	state->CaretShown.x = AnimateProgress(GetAnimationId(id, 0), state->CaretShown.x, caret_pos.x, 1.0f, dt);
+	state->CaretShown.y = AnimateProgress(GetAnimationId(id, 1), state->CaretShown.y, caret_pos.y, 1.0f, dt);
+
+	// Visible lines
+	ImDrawList* draw_list = window->DrawList;
+	const int lines_count = buffer.GetLinesCount();
+	const int line_first = ImMax((int)ImFloor((view_bb.Min.y - draw_origin.y) / line_height), 0);
+	const int line_last = ImMin((int)ImCeil((view_bb.Max.y - draw_origin.y) / line_height), lines_count);
+	const int sel_min = ImMin(state->Cursor, state->SelectionAnchor), sel_max = ImMax(state->Cursor, state->SelectionAnchor);
+	const int caret_line = (int)(caret_pos.y / line_height);
+	const ImU32 text_col = GetColorU32(ImGuiCol_Text);
+	const ImU32 selection_col = GetColorU32(ImGuiCol_TextSelectedBg);
+	const ImVec4 clip_rect(view_bb.Min.x, view_bb.Min.y, view_bb.Max.x, view_bb.Max.y);
+	const float space_width = g.Font->GetCharAdvance(' ') * g.FontSize / g.Font->FontSize;
+	for (int line = line_first; line < line_last; line++)
+	{
+		const int start = ReadTextEditorLine(e, buffer, line);
+		const char* text = e.TextEditorLine.Data;
+		const char* text_end = text + e.TextEditorLine.Size - 1;
+		const float y = draw_origin.y + line * line_height;
+		const float width = CalcTextEditorColumnX(text, text_end);
+		state->WidestLine = ImMax(state->WidestLine, width);
+		const int end = start + (int)(text_end - text);
+		if (sel_min < sel_max && sel_min <= end && sel_max > start)
+		{
+			// The caret end of the selection is drawn at the displayed caret
+			float x1 = (sel_min > start) ? CalcTextEditorColumnX(text, text + (sel_min - start)) : 0.0f;
+			float x2 = (sel_max <= end) ? CalcTextEditorColumnX(text, text + (sel_max - start)) : width + space_width;
+			if (line == caret_line)
+				(state->Cursor == sel_min ? x1 : x2) = state->CaretShown.x;
+			if (x1 != x2)
+				draw_list->AddRectFilled(ImVec2(draw_origin.x + ImMin(x1, x2), y), ImVec2(draw_origin.x + ImMax(x1, x2), y + line_height), selection_col);
+		}
+		AddTextCached(draw_list, ImVec2(draw_origin.x, y), text_col, text, text_end, 0.0f, &clip_rect);
+	}
 
-	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags);
-	return pressed;
+	// Caret, blinking like ImGui::InputText()
+	if (active)
+	{
+		const float blink_time = (float)(g.Time - state->BlinkStart) - 0.30f;
+		const float blink_phase = ImFmod(ImMax(blink_time, 0.0f), 1.20f);
+		const bool caret_visible = !io.ConfigInputTextCursorBlink || blink_time <= 0.0f || blink_phase <= 0.80f;
+		const ImVec2 caret_screen_pos(IM_FLOOR(draw_origin.x + state->CaretShown.x) + 0.5f, draw_origin.y + state->CaretShown.y);
+		if (caret_visible && view_bb.Contains(caret_screen_pos))
+			draw_list->AddLine(caret_screen_pos, ImVec2(caret_screen_pos.x, caret_screen_pos.y + line_height - 0.5f), text_col);
+		if (io.ConfigInputTextCursorBlink)
+			ScheduleAnimation(GetAnimationId(id, 2), (blink_time <= 0.0f) ? -blink_time : (blink_phase <= 0.80f) ? 0.80f - blink_phase : 1.20f - blink_phase, 0.0f);
+		if (!read_only)
+		{
+			g.PlatformImeData.WantVisible = true;
+			g.PlatformImeData.InputPos = ImVec2(caret_screen_pos.x - 1.0f, caret_screen_pos.y - g.FontSize);
+			g.PlatformImeData.InputLineHeight = g.FontSize;
+		}
+	}
+
+	// Content size, from the widest line seen
+	window->DC.CursorPos = origin;
+	ItemSize(ImVec2(state->WidestLine + space_width, lines_count * line_height));
+	EndChild();
+	return edited;
 }
 
-bool ImExt::RadioButton(const char* label, int* v, int v_button, const float dt)
+bool ImExt::TextEditor(const char* str_id, ImExtTextBuffer& buffer, const ImVec2& size, const float dt, ImGuiInputTextFlags flags)
 {
-	const bool pressed = RadioButton(label, *v == v_button);
-	if (pressed)
-		*v = v_button;
-	return pressed;
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return TextEditorEx(GetLabelID(window, str_id), buffer, size, dt, flags);
 }
 
-bool ImExt::Checkbox(const char* label, bool* v, const float dt)
+bool ImExt::TextEditor(const ImExtLabel& str_id, ImExtTextBuffer& buffer, const ImVec2& size, const float dt, ImGuiInputTextFlags flags)
 {
 	ImGuiWindow* window = GetCurrentWindow();
 	if (window->SkipItems)
 		return false;
+	return TextEditorEx(GetLabelID(window, str_id), buffer, size, dt, flags);
+}
+
+// Content of an open or animating node: clipped to its shown height while animating, indented for TreeNode()
+static bool PushTreeNodeContent(ImGuiWindow* window, ImGuiID id, const ImExtTreeNodeState* state, ImGuiTreeNodeFlags flags)
+{
+	ImExtContext& e = GetExtContext();
+	ImExtTreeNodeStackData data;
+	data.Id = id;
+	data.ContentStartY = window->DC.CursorPos.y;
+	data.BackupCursorMaxPos = window->DC.CursorMaxPos;
+	data.Clipping = (state->Shown < 1.0f);
+	data.TreePushed = !(flags & ImGuiTreeNodeFlags_NoTreePushOnOpen);
+	if (data.Clipping)
+		ImGui::PushClipRect(ImVec2(window->ClipRect.Min.x, data.ContentStartY), ImVec2(window->ClipRect.Max.x, data.ContentStartY + ImMax(state->Height, 0.0f) * state->Shown), true);
+	if (data.TreePushed)
+		ImGui::TreePushOverrideID(id);
+	e.TreeNodeStack.push_back(data);
+	return true;
+}
 
+// Same layout as ImGui::TreeNodeBehavior(). The content height is measured on ImExt::TreePop(): an open node out of view
+// returns false and only moves the cursor past it, so a large tree costs its visible nodes whichever are open.
+bool ImExt::TreeNodeEx(ImGuiID id, const char* label, const char* label_end, const float dt, ImGuiTreeNodeFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
 	ImGuiContext& g = *GImGui;
+	ImExtContext& e = GetExtContext();
 	const ImGuiStyle& style = g.Style;
-	const ImGuiID id = window->GetID(label);
-	const ImVec2 label_size = CalcTextSize(label, NULL, true);
-
-	const float square_sz = GetFrameHeight();
-	const ImVec2 pos = window->DC.CursorPos;
-	const ImRect total_bb(pos, ImVec2(pos.x + square_sz + (label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f), pos.y + label_size.y + style.FramePadding.y * 2.0f));
-	ItemSize(total_bb, style.FramePadding.y);
-	if (!ItemAdd(total_bb, id))
+	const bool framed = (flags & ImGuiTreeNodeFlags_Framed) != 0;
+	const bool is_leaf = (flags & ImGuiTreeNodeFlags_Leaf) != 0;
+	const ImVec2 padding = framed ? style.FramePadding : ImVec2(style.FramePadding.x, ImMin(window->DC.CurrLineTextBaseOffset, style.FramePadding.y));
+	const ImVec2 label_size = CalcLabelSize(label, label_end);
+
+	const float frame_height = ImMax(ImMin(window->DC.CurrLineSize.y, g.FontSize + style.FramePadding.y * 2.0f), label_size.y + padding.y * 2.0f);
+	ImRect frame_bb(window->DC.CursorPos.x, window->DC.CursorPos.y, window->WorkRect.Max.x, window->DC.CursorPos.y + frame_height);
+	if (framed)
 	{
-		IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags | ImGuiItemStatusFlags_Checkable | (*v ? ImGuiItemStatusFlags_Checked : 0));
-		return false;
+		// Framed headers expand a little outside the default padding, to the edge of InnerClipRect
+		frame_bb.Min.x -= IM_FLOOR(window->WindowPadding.x * 0.5f - 1.0f);
+		frame_bb.Max.x += IM_FLOOR(window->WindowPadding.x * 0.5f);
 	}
+	const float text_offset_x = g.FontSize + (framed ? padding.x * 3.0f : padding.x * 2.0f);
+	const float text_offset_y = ImMax(padding.y, window->DC.CurrLineTextBaseOffset);
+	const float text_width = g.FontSize + (label_size.x > 0.0f ? label_size.x + padding.x * 2.0f : 0.0f);
+	const ImVec2 text_pos(window->DC.CursorPos.x + text_offset_x, window->DC.CursorPos.y + text_offset_y);
+	ItemSize(ImVec2(text_width, frame_height), padding.y);
+
+	ImRect interact_bb = frame_bb;
+	if (!framed && !(flags & (ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_SpanFullWidth)))
+		interact_bb.Max.x = frame_bb.Min.x + text_width + style.ItemSpacing.x * 2.0f;
+
+	bool is_open = !is_leaf && TreeNodeBehaviorIsOpen(id, flags);
+	if (!ItemAdd(interact_bb, id))
+	{
+		// Clipped nodes jump to the end of their animation, leaves and closed ones keep nothing
+		if (!is_open)
+		{
+			if (ImExtTreeNodeState* state = is_leaf ? NULL : e.TreeNodes.GetByKey(id))
+				state->Shown = 0.0f;
+			return false;
+		}
+		ImExtTreeNodeState* state = e.TreeNodes.GetOrAddByKey(id);
+		state->LastFrame = g.FrameCount;
+		state->Shown = 1.0f;
 
-	bool hovered, held;
-	bool pressed = ButtonBehavior(total_bb, id, &hovered, &held);
+		// The content is skipped when it is out of view too and was measured before
+		const float content_y = window->DC.CursorPos.y;
+		if (state->Height >= 0.0f && !window->ClipRect.Overlaps(ImRect(frame_bb.Min.x, content_y, frame_bb.Max.x, content_y + state->Height)))
+		{
+			window->DC.CursorPos.y += state->Height;
+			window->DC.CursorMaxPos.y = ImMax(window->DC.CursorMaxPos.y, window->DC.CursorPos.y - style.ItemSpacing.y);
+			return false;
+		}
+		return PushTreeNodeContent(window, id, state, flags);
+	}
 
-	if (pressed)
+	ImGuiButtonFlags button_flags = ImGuiButtonFlags_PressedOnClickRelease;
+	if (flags & ImGuiTreeNodeFlags_AllowItemOverlap)
+		button_flags |= ImGuiButtonFlags_AllowItemOverlap;
+	bool hovered, held;
+	const bool pressed = ButtonBehavior(interact_bb, id, &hovered, &held, button_flags);
+	bool toggled = pressed && !is_leaf;
+	if (g.NavId == id && g.NavMoveDir == ImGuiDir_Left && is_open)
 	{
-		*v = !(*v);
-		MarkItemEdited(id);
+		toggled = true;
+		NavMoveRequestCancel();
 	}
-
-	// Animation
-	float last_active_id_timer = g.LastActiveIdTimer;
-	if (held || pressed)
-		g.LastActiveIdTimer = 0.f;
-
-	if (g.LastActiveIdTimer == 0.f && g.LastActiveId == id && !pressed)
-		g.LastActiveIdTimer = last_active_id_timer;
-
-	float t = held ? 1.0f : 0.0f;
-	float mark_t = *v ? 1.0f : 0.0f;
-
-	if (g.LastActiveId == id)
+	if (g.NavId == id && g.NavMoveDir == ImGuiDir_Right && !is_open && !is_leaf)
 	{
-		float t_anim = ImSaturate(g.LastActiveIdTimer / 0.16f * dt);
-		t = held ? (t_anim) : (1.0f - t_anim);
-		mark_t = *v ? (t_anim) : (0.0f);
+		toggled = true;
+		NavMoveRequestCancel();
 	}
-
-	const float scale = 5.f * t;
-	const ImRect check_bb(pos, ImVec2(pos.x + square_sz, pos.y + square_sz));
-	const ImRect rect_bb(ImVec2(pos.x + scale / 2, pos.y + scale / 2), ImVec2(pos.x + square_sz - scale, pos.y + square_sz - scale));
-
-	RenderNavHighlight(total_bb, id);
-	RenderFrame(rect_bb.Min, rect_bb.Max, GetColorU32((held && hovered) ? ImGuiCol_FrameBgActive : hovered ? ImGuiCol_FrameBgHovered : ImGuiCol_FrameBg), true, style.FrameRounding);
-	ImU32 check_col = GetColorU32(ImGuiCol_CheckMark);
-	bool mixed_value = (g.LastItemData.InFlags & ImGuiItemFlags_MixedValue) != 0;
-	if (mixed_value)
+	if (toggled)
 	{
-		// Undocumented tristate/mixed/indeterminate checkbox (#2644)
-		// This may seem awkwardly designed because the aim is to make ImGuiItemFlags_MixedValue supported by all widgets (not just checkbox)
-		ImVec2 pad(ImMax(1.0f, IM_FLOOR(square_sz / 3.6f)), ImMax(1.0f, IM_FLOOR(square_sz / 3.6f)));
-		const ImVec2 pos_min = ImVec2(rect_bb.Min.x + pad.x + scale, rect_bb.Min.y + pad.y + scale);
-		const ImVec2 pos_max = ImVec2(rect_bb.Max.x - pad.x + scale, rect_bb.Max.y - pad.y + scale);
-		window->DrawList->AddRectFilled(pos_min, pos_max, check_col, style.FrameRounding);
+		is_open = !is_open;
+		window->DC.StateStorage->SetInt(id, is_open);
+		g.LastItemData.StatusFlags |= ImGuiItemStatusFlags_ToggledOpen;
 	}
-	else if (*v || mark_t > 0.f)
+	if (flags & ImGuiTreeNodeFlags_AllowItemOverlap)
+		SetItemAllowOverlap();
+
+	// The arrow turns and the content slides by the same fraction
+	ImExtTreeNodeState leaf_state; // Leaves never open, nothing to keep
+	ImExtTreeNodeState* state = is_leaf ? &leaf_state : e.TreeNodes.GetOrAddByKey(id);
+	if (state->LastFrame == -1)
+		state->Shown = is_open ? 1.0f : 0.0f;
+	state->LastFrame = g.FrameCount;
+	if (!is_leaf)
+		state->Shown = AnimateProgress(GetAnimationId(id, 0), state->Shown, is_open ? 1.0f : 0.0f, ImMax(state->Height, frame_height), dt);
+
+	// Render
+	const bool draw_bg = framed || hovered || (flags & ImGuiTreeNodeFlags_Selected);
+	const ImU32 bg_col = draw_bg ? GetColorU32((held && hovered) ? ImGuiCol_HeaderActive : hovered ? ImGuiCol_HeaderHovered : ImGuiCol_Header) : 0;
+	RenderNavHighlight(frame_bb, id, framed ? ImGuiNavHighlightFlags_TypeDefault : ImGuiNavHighlightFlags_TypeThin);
+	const ImU32 render_cols[] = { bg_col, (ImU32)flags };
+	if (!RenderCacheBegin(id, frame_bb, RenderCacheKey(frame_bb, label, label_end, render_cols, IM_ARRAYSIZE(render_cols), &state->Shown, 1)))
 	{
-		const float pad = ImMax(1.0f, IM_FLOOR(square_sz / 6.0f));
-		const ImVec2 pos_min = ImVec2(check_bb.Min.x + pad, check_bb.Min.y + pad);
+		if (draw_bg)
+			RenderFrame(frame_bb.Min, frame_bb.Max, bg_col, framed, framed ? style.FrameRounding : 0.0f);
+		if (!is_leaf)
+		{
+			// Right pointing arrow of ImGui::RenderArrow(), turned down as the content opens
+			const float arrow_scale = framed ? 1.0f : 0.70f;
+			const float r = g.FontSize * 0.40f * arrow_scale;
+			const ImVec2 center(text_pos.x - text_offset_x + padding.x + g.FontSize * 0.50f, text_pos.y + (framed ? 0.0f : g.FontSize * 0.15f) + g.FontSize * 0.50f * arrow_scale);
+			const float angle = state->Shown * IM_PI * 0.5f;
+			const float cos_a = ImCos(angle), sin_a = ImSin(angle);
+			ImVec2 points[3] = { ImVec2(0.750f * r, 0.0f), ImVec2(-0.750f * r, 0.866f * r), ImVec2(-0.750f * r, -0.866f * r) };
+			for (int n = 0; n < 3; n++)
+				points[n] = ImVec2(center.x + points[n].x * cos_a - points[n].y * sin_a, center.y + points[n].x * sin_a + points[n].y * cos_a);
+			window->DrawList->AddTriangleFilled(points[0], points[1], points[2], GetColorU32(ImGuiCol_Text));
+		}
+		ImExt::ImDraw::RenderTextClipped(text_pos, frame_bb.Max, label, label_end, &label_size, GetColorU32(ImGuiCol_Text));
+		RenderCacheEnd();
+	}
 
-		float sz = square_sz - pad * 2.0f;
-		float thickness = ImMax(sz * mark_t / 5.0f, 1.0f) * mark_t;
-		sz -= thickness * 0.5f;
-		const ImVec2 mark_pos = ImVec2(pos_min.x + thickness * 0.25f, pos_min.y + thickness * 0.25f);
+	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags | ImGuiItemStatusFlags_Openable | (is_open ? ImGuiItemStatusFlags_Opened : 0));
 
-		float third = sz / 3.0f;
-		float bx = mark_pos.x + third;
-		float by = mark_pos.y + sz - third * 0.5f;
-		window->DrawList->PathLineTo(ImVec2(bx - third, by - third));
-		window->DrawList->PathLineTo(ImVec2(bx, by));
-		window->DrawList->PathLineTo(ImVec2(bx + third * 2.0f, by - third * 2.0f));
-		window->DrawList->PathStroke(check_col, 0, thickness);
-	}
+	if (!is_open && state->Shown <= 0.0f)
+		return false;
+	return PushTreeNodeContent(window, id, state, flags);
+}
+
+bool ImExt::CollapsingHeader(const char* label, const float dt, ImGuiTreeNodeFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return TreeNodeEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), dt, flags | ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_NoTreePushOnOpen);
+}
+
+bool ImExt::CollapsingHeader(const ImExtLabel& label, const float dt, ImGuiTreeNodeFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return TreeNodeEx(GetLabelID(window, label), label.Text, label.TextEnd, dt, flags | ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_NoTreePushOnOpen);
+}
+
+bool ImExt::TreeNode(const char* label, const float dt, ImGuiTreeNodeFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return TreeNodeEx(GetLabelID(window, label), label, FindRenderedTextEnd(label), dt, flags & ~ImGuiTreeNodeFlags_NoTreePushOnOpen);
+}
 
-	ImVec2 label_pos = ImVec2(check_bb.Max.x + style.ItemInnerSpacing.x, check_bb.Min.y + style.FramePadding.y);
-	if (g.LogEnabled)
-		LogRenderedText(&label_pos, mixed_value ? "[~]" : *v ? "[x]" : "[ ]");
-	if (label_size.x > 0.0f)
-		RenderText(label_pos, label);
+bool ImExt::TreeNode(const ImExtLabel& label, const float dt, ImGuiTreeNodeFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	if (window->SkipItems)
+		return false;
+	return TreeNodeEx(GetLabelID(window, label), label.Text, label.TextEnd, dt, flags & ~ImGuiTreeNodeFlags_NoTreePushOnOpen);
+}
 
-	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags | ImGuiItemStatusFlags_Checkable | (*v ? ImGuiItemStatusFlags_Checked : 0));
-	return pressed;
+void ImExt::TreePop()
+{
+	ImGuiContext& g = *GImGui;
+	ImGuiWindow* window = g.CurrentWindow;
+	ImExtContext& e = GetExtContext();
+	IM_ASSERT(e.TreeNodeStack.Size > 0 && "Calling ImExt::TreePop() too many times!");
+	const ImExtTreeNodeStackData data = e.TreeNodeStack.back();
+	e.TreeNodeStack.pop_back();
+	if (data.TreePushed)
+		ImGui::TreePop();
+
+	// Measured with every clipped node below skipped by its own cached height
+	ImExtTreeNodeState* state = e.TreeNodes.GetByKey(data.Id);
+	state->Height = window->DC.CursorPos.y - data.ContentStartY;
+	if (data.Clipping)
+	{
+		ImGui::PopClipRect();
+		window->DC.CursorPos.y = data.ContentStartY + state->Height * state->Shown;
+		window->DC.CursorMaxPos.x = ImMax(window->DC.CursorMaxPos.x, data.BackupCursorMaxPos.x);
+		window->DC.CursorMaxPos.y = ImMax(data.BackupCursorMaxPos.y, window->DC.CursorPos.y - g.Style.ItemSpacing.y);
+	}
 }
 
-bool ImExt::BeginCombo(const char* label, const char* preview_value, const ImVec2& size, const float dt, ImGuiComboFlags flags)
+bool ImExt::BeginComboEx(ImGuiID id, const char* label, const char* label_end, const char* preview_value, const ImVec2& size, const float dt, ImGuiComboFlags flags)
 {
 	ImGuiContext& g = *GImGui;
 	ImGuiNextWindowDataFlags backup_next_window_data_flags = g.NextWindowData.Flags;
@@ -623,10 +6466,10 @@ bool ImExt::BeginCombo(const char* label, const char* preview_value, const ImVec
 	IM_ASSERT((flags & (ImGuiComboFlags_NoArrowButton | ImGuiComboFlags_NoPreview)) != (ImGuiComboFlags_NoArrowButton | ImGuiComboFlags_NoPreview)); // Can't use both flags together
 
 	const ImGuiStyle& style = g.Style;
-	const ImGuiID id = window->GetID(label);
-	const ImGuiID popup_id = ImHashStr("##ComboPopup", 0, id);
+	static IMEXT_LABEL_CONSTEXPR const ImExtLabel popup_label("##ComboPopup");
+	const ImGuiID popup_id = HashLabel(popup_label, id);
 	bool popup_open = IsPopupOpen(popup_id, ImGuiPopupFlags_None);
-	const ImVec2 preview_size = CalcTextSize(label, NULL, true);
+	const ImVec2 preview_size = CalcLabelSize(label, label_end);
 
 	ImVec2 pos = window->DC.CursorPos;
 	if ((flags & ImGuiButtonFlags_AlignTextBaseLine) && style.FramePadding.y < window->DC.CurrLineTextBaseOffset) // Try to vertically align buttons that are smaller/have no padding so that text baseline matches (bit hacky, since it shouldn't be a flag)
@@ -666,9 +6509,10 @@ bool ImExt::BeginCombo(const char* label, const char* preview_value, const ImVec
 
 	if (g.LastActiveId == id)
 	{
-		float t_anim = ImSaturate(g.LastActiveIdTimer / 0.16f * dt);
+		float t_anim = LodAnimationTime(ImSaturate(g.LastActiveIdTimer / 0.16f * dt));
 		t = held && !pressed ? (t_anim) : (1.0f - t_anim);
 		popup_t = popup_open ? (t_anim) : (1.0f - t_anim);
+		ScheduleActiveIdAnimation(id, 0.16f / dt, CalcMaxPopupHeightFromItemCount(8));
 	}
 
 	const float scale = item_size.x / 30.f * t;
@@ -681,28 +6525,6 @@ bool ImExt::BeginCombo(const char* label, const char* preview_value, const ImVec
 	const ImVec2 pos_min = ImVec2(render_bb.Min.x, render_bb.Min.y);
 	const ImVec2 pos_max = ImVec2(render_bb.Max.x, render_bb.Max.y);
 
-	if (!(flags & ImGuiComboFlags_NoPreview)) // if preview need
-		window->DrawList->AddRectFilled(pos_min, pos_max, frame_col, style.FrameRounding, (flags & ImGuiComboFlags_NoArrowButton) ? ImDrawFlags_RoundCornersAll : ImDrawFlags_RoundCornersLeft);
-
-	if (!(flags & ImGuiComboFlags_NoArrowButton)) // if arrow need
-	{
-		ImU32 bg_col = GetColorU32((popup_open || hovered) ? ImGuiCol_ButtonHovered : ImGuiCol_Button);
-		ImU32 text_col = GetColorU32(ImGuiCol_Text);
-		window->DrawList->AddRectFilled(ImVec2(preview_zone, render_bb.Min.y), render_bb.Max, bg_col, style.FrameRounding, (w <= arrow_size) ? ImDrawFlags_RoundCornersAll : ImDrawFlags_RoundCornersRight);
-		if (preview_zone + arrow_size - style.FramePadding.x <= render_bb.Max.x)
-		{
-			ImVec2 arrow_min = ImVec2(preview_zone, pos_min.y);
-			ImVec2 arrow_center = ImVec2(arrow_min.x + (pos_max.x - arrow_min.x) / 2, arrow_min.y + (pos_max.y - pos_min.y) / 2);
-
-			ImVec2 a = ImVec2(arrow_center.x - (arrow_center.x - arrow_min.x) / 2, arrow_center.y - (arrow_center.y - arrow_min.y) / 3);
-			ImVec2 b = ImVec2(arrow_center.x + (arrow_center.x - arrow_min.x) / 2, arrow_center.y - (arrow_center.y - arrow_min.y) / 3);
-			ImVec2 c = ImVec2(arrow_center.x, arrow_center.y + (pos_max.y - arrow_center.y) / 3);
-			window->DrawList->AddTriangleFilled(a, b, c, text_col);
-			//RenderArrow(window->DrawList, ImVec2(preview_zone + style.FramePadding.x, render_bb.Min.y + style.FramePadding.y + (render_bb.Max.y - render_bb.Min.y) / render_bb.Min.y), text_col, ImGuiDir_Down, 1.0f);
-		}
-	}
-	RenderFrameBorder(render_bb.Min, render_bb.Max, style.FrameRounding);
-
 	// Custom preview
 	if (flags & ImGuiComboFlags_CustomPreview)
 	{
@@ -711,12 +6533,41 @@ bool ImExt::BeginCombo(const char* label, const char* preview_value, const ImVec
 		preview_value = NULL;
 	}
 
-	// Render preview and label
-	if (preview_value != NULL && !(flags & ImGuiComboFlags_NoPreview))
+	if (preview_value != NULL)
+		RequestGlyphs(g.Font, preview_value);
+	const ImU32 bg_col = GetColorU32((popup_open || hovered) ? ImGuiCol_ButtonHovered : ImGuiCol_Button);
+	const ImU32 render_cols[] = { frame_col, bg_col, (ImU32)flags };
+	if (!RenderCacheBegin(id, bb, RenderCacheKey(bb, preview_value, NULL, render_cols, IM_ARRAYSIZE(render_cols), &t, 1)))
 	{
-		if (g.LogEnabled)
-			LogSetNextTextDecoration("{", "}");
-		RenderTextClipped(render_bb.Min, render_bb.Max, preview_value, NULL, NULL, style.ButtonTextAlign, &render_bb);
+		if (!(flags & ImGuiComboFlags_NoPreview)) // if preview need
+			window->DrawList->AddRectFilled(pos_min, pos_max, frame_col, style.FrameRounding, (flags & ImGuiComboFlags_NoArrowButton) ? ImDrawFlags_RoundCornersAll : ImDrawFlags_RoundCornersLeft);
+
+		if (!(flags & ImGuiComboFlags_NoArrowButton)) // if arrow need
+		{
+			ImU32 text_col = GetColorU32(ImGuiCol_Text);
+			window->DrawList->AddRectFilled(ImVec2(preview_zone, render_bb.Min.y), render_bb.Max, bg_col, style.FrameRounding, (w <= arrow_size) ? ImDrawFlags_RoundCornersAll : ImDrawFlags_RoundCornersRight);
+			if (preview_zone + arrow_size - style.FramePadding.x <= render_bb.Max.x)
+			{
+				ImVec2 arrow_min = ImVec2(preview_zone, pos_min.y);
+				ImVec2 arrow_center = ImVec2(arrow_min.x + (pos_max.x - arrow_min.x) / 2, arrow_min.y + (pos_max.y - pos_min.y) / 2);
+
+				ImVec2 a = ImVec2(arrow_center.x - (arrow_center.x - arrow_min.x) / 2, arrow_center.y - (arrow_center.y - arrow_min.y) / 3);
+				ImVec2 b = ImVec2(arrow_center.x + (arrow_center.x - arrow_min.x) / 2, arrow_center.y - (arrow_center.y - arrow_min.y) / 3);
+				ImVec2 c = ImVec2(arrow_center.x, arrow_center.y + (pos_max.y - arrow_center.y) / 3);
+				window->DrawList->AddTriangleFilled(a, b, c, text_col);
+				//RenderArrow(window->DrawList, ImVec2(preview_zone + style.FramePadding.x, render_bb.Min.y + style.FramePadding.y + (render_bb.Max.y - render_bb.Min.y) / render_bb.Min.y), text_col, ImGuiDir_Down, 1.0f);
+			}
+		}
+		RenderFrameBorder(render_bb.Min, render_bb.Max, style.FrameRounding);
+
+		// Render preview and label
+		if (preview_value != NULL && !(flags & ImGuiComboFlags_NoPreview))
+		{
+			if (g.LogEnabled)
+				LogSetNextTextDecoration("{", "}");
+			ImExt::ImDraw::RenderTextClipped(render_bb.Min, render_bb.Max, preview_value, NULL, NULL, GetColorU32(ImGuiCol_Text), style.ButtonTextAlign, &render_bb);
+		}
+		RenderCacheEnd();
 	}
 
 	IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags);
@@ -725,6 +6576,20 @@ bool ImExt::BeginCombo(const char* label, const char* preview_value, const ImVec
 	return BeginComboPopup(id, popup_id, render_bb, popup_t, flags);
 }
 
+bool ImExt::BeginCombo(const char* label, const char* preview_value, const ImVec2& size, const float dt, ImGuiComboFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	const ImGuiID id = window->SkipItems ? 0 : GetLabelID(window, label); // BeginComboEx() still consumes SetNextWindowXXX() data when skipped
+	return BeginComboEx(id, label, FindRenderedTextEnd(label), preview_value, size, dt, flags);
+}
+
+bool ImExt::BeginCombo(const ImExtLabel& label, const char* preview_value, const ImVec2& size, const float dt, ImGuiComboFlags flags)
+{
+	ImGuiWindow* window = GetCurrentWindow();
+	const ImGuiID id = window->SkipItems ? 0 : GetLabelID(window, label); // BeginComboEx() still consumes SetNextWindowXXX() data when skipped
+	return BeginComboEx(id, label.Text, label.TextEnd, preview_value, size, dt, flags);
+}
+
 bool ImExt::BeginComboPopup(ImGuiID parent_id, ImGuiID popup_id, const ImRect& bb, const float time, ImGuiComboFlags flags)
 {
 	ImGuiContext& g = *GImGui;
@@ -774,7 +6639,6 @@ bool ImExt::BeginComboPopup(ImGuiID parent_id, ImGuiID popup_id, const ImRect& b
 			ImRect r_outer = GetPopupAllowedExtentRect(popup_window);
 			ImVec2 pos = FindBestWindowPosForPopupEx(bb.GetBL(), size_expected, &popup_window->AutoPosLastDirection, r_outer, bb, ImGuiPopupPositionPolicy_ComboBox);
 			SetNextWindowPos(pos);
-			SetNextWindowBgAlpha(time);
 		}
 
 	// We don't use BeginPopupEx() solely because we have a custom name string, which we could make an argument to BeginPopupEx()
@@ -790,5 +6654,1014 @@ bool ImExt::BeginComboPopup(ImGuiID parent_id, ImGuiID popup_id, const ImRect& b
 		IM_ASSERT(0);   // This should never happen as we tested for IsPopupOpen() above
 		return false;
 	}
+	SetWindowAlpha(time); // Fade the items in with the background
+	return true;
+}
+#pragma region FontBuilder
+// Same build as ImGui's stb_truetype builder (imgui_draw.cpp), with glyph rasterization spread over threads.
+// Glyph rectangles are packed serially first, so the atlas is identical to the one built by the default builder:
+// workers then render batches of glyphs into disjoint rectangles of the texture.
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic ignored "-Wcast-qual"
+#endif
+#ifdef _MSC_VER
+#pragma warning (push)
+#pragma warning (disable: 4456)                             // declaration of 'xx' hides previous local declaration
+#endif
+
+// Private copies of stb_rect_pack and stb_truetype. Rasterizer scratch memory comes from malloc() since ImGui allocator
+// updates its allocation counters without synchronization.
+#ifndef STB_RECT_PACK_IMPLEMENTATION
+#define STBRP_STATIC
+#define STBRP_ASSERT(x)     do { IM_ASSERT(x); } while (0)
+#define STBRP_SORT          ImQsort
+#define STB_RECT_PACK_IMPLEMENTATION
+#ifdef IMGUI_STB_RECT_PACK_FILENAME
+#include IMGUI_STB_RECT_PACK_FILENAME
+#else
+#include "imstb_rectpack.h"
+#endif
+#endif
+
+#ifndef STB_TRUETYPE_IMPLEMENTATION
+#define STBTT_malloc(x,u)   ((void)(u), malloc(x))
+#define STBTT_free(x,u)     ((void)(u), free(x))
+#define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
+#define STBTT_fmod(x,y)     ImFmod(x,y)
+#define STBTT_sqrt(x)       ImSqrt(x)
+#define STBTT_pow(x,y)      ImPow(x,y)
+#define STBTT_fabs(x)       ImFabs(x)
+#define STBTT_ifloor(x)     ((int)ImFloorSigned(x))
+#define STBTT_iceil(x)      ((int)ImCeil(x))
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#ifdef IMGUI_STB_TRUETYPE_FILENAME
+#include IMGUI_STB_TRUETYPE_FILENAME
+#else
+#include "imstb_truetype.h"
+#endif
+#endif
+
+#ifdef _MSC_VER
+#pragma warning (pop)
+#endif
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+#define IMEXT_FONT_BUILDER_MAX_THREADS  32
+#define IMEXT_FONT_BUILDER_BATCH_SIZE   64 // Glyphs per job
+
+// Temporary data for one source font, see ImFontBuildSrcData in imgui_draw.cpp
+struct ImExtFontBuildSrcData
+{
+	stbtt_fontinfo FontInfo;
+	stbtt_pack_range PackRange;
+	stbrp_rect* Rects;
+	stbtt_packedchar* PackedChars;
+	const ImWchar* SrcRanges;
+	int DstIndex;
+	int GlyphsHighest;
+	int GlyphsCount;
+	ImBitVector GlyphsSet;
+	ImVector<int> GlyphsList;
+};
+
+struct ImExtFontBuildDstData
+{
+	int SrcCount;
+	int GlyphsHighest;
+	int GlyphsCount;
+	ImBitVector GlyphsSet;
+};
+
+struct ImExtFontBuildJob
+{
+	int SrcIndex;
+	int GlyphStart;
+	int GlyphCount;
+};
+
+struct ImExtFontBuildContext
+{
+	ImFontAtlas* Atlas;
+	const stbtt_pack_context* PackContext;
+	ImExtFontBuildSrcData* Src;
+	const ImExtFontBuildJob* Jobs;
+	int JobsCount;
+	std::atomic<int> JobNext;
+};
+
+static int GImExtFontBuilderThreadsCount = 0;
+
+static void FontBuildRenderJobs(ImExtFontBuildContext* ctx)
+{
+	stbtt_pack_context spc = *ctx->PackContext; // Rendering writes oversampling settings into the context
+	for (int job_n = ctx->JobNext++; job_n < ctx->JobsCount; job_n = ctx->JobNext++)
+	{
+		const ImExtFontBuildJob& job = ctx->Jobs[job_n];
+		ImExtFontBuildSrcData& src_tmp = ctx->Src[job.SrcIndex];
+		const ImFontConfig& cfg = ctx->Atlas->ConfigData[job.SrcIndex];
+
+		stbtt_pack_range range = src_tmp.PackRange;
+		range.array_of_unicode_codepoints = src_tmp.GlyphsList.Data + job.GlyphStart;
+		range.num_chars = job.GlyphCount;
+		range.chardata_for_range = src_tmp.PackedChars + job.GlyphStart;
+		stbrp_rect* rects = src_tmp.Rects + job.GlyphStart;
+		stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &range, 1, rects);
+
+		// Apply multiply operator
+		if (cfg.RasterizerMultiply != 1.0f)
+		{
+			unsigned char multiply_table[256];
+			ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+			for (int glyph_i = 0; glyph_i < job.GlyphCount; glyph_i++)
+				if (rects[glyph_i].was_packed)
+					ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, ctx->Atlas->TexPixelsAlpha8, rects[glyph_i].x, rects[glyph_i].y, rects[glyph_i].w, rects[glyph_i].h, ctx->Atlas->TexWidth * 1);
+		}
+	}
+}
+
+static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>* out)
+{
+	IM_ASSERT(sizeof(in->Storage.Data[0]) == sizeof(int));
+	const ImU32* it_begin = in->Storage.begin();
+	const ImU32* it_end = in->Storage.end();
+	for (const ImU32* it = it_begin; it < it_end; it++)
+		if (ImU32 entries_32 = *it)
+			for (ImU32 bit_n = 0; bit_n < 32; bit_n++)
+				if (entries_32 & ((ImU32)1 << bit_n))
+					out->push_back((int)(((it - it_begin) << 5) + bit_n));
+}
+
+static bool FontAtlasBuildParallel(ImFontAtlas* atlas)
+{
+	IM_ASSERT(atlas->ConfigData.Size > 0);
+
+	ImFontAtlasBuildInit(atlas);
+
+	// Clear atlas
+	atlas->TexID = (ImTextureID)NULL;
+	atlas->TexWidth = atlas->TexHeight = 0;
+	atlas->TexUvScale = ImVec2(0.0f, 0.0f);
+	atlas->TexUvWhitePixel = ImVec2(0.0f, 0.0f);
+	atlas->ClearTexData();
+
+	// Temporary storage for building
+	ImVector<ImExtFontBuildSrcData> src_tmp_array;
+	ImVector<ImExtFontBuildDstData> dst_tmp_array;
+	src_tmp_array.resize(atlas->ConfigData.Size);
+	dst_tmp_array.resize(atlas->Fonts.Size);
+	memset((void*)src_tmp_array.Data, 0, (size_t)src_tmp_array.size_in_bytes());
+	memset((void*)dst_tmp_array.Data, 0, (size_t)dst_tmp_array.size_in_bytes());
+
+	// 1. Initialize font loading structure, check font data validity
+	for (int src_i = 0; src_i < atlas->ConfigData.Size; src_i++)
+	{
+		ImExtFontBuildSrcData& src_tmp = src_tmp_array[src_i];
+		ImFontConfig& cfg = atlas->ConfigData[src_i];
+		IM_ASSERT(cfg.DstFont && (!cfg.DstFont->IsLoaded() || cfg.DstFont->ContainerAtlas == atlas));
+
+		src_tmp.DstIndex = -1;
+		for (int output_i = 0; output_i < atlas->Fonts.Size && src_tmp.DstIndex == -1; output_i++)
+			if (cfg.DstFont == atlas->Fonts[output_i])
+				src_tmp.DstIndex = output_i;
+		if (src_tmp.DstIndex == -1)
+		{
+			IM_ASSERT(src_tmp.DstIndex != -1); // cfg.DstFont not pointing within atlas->Fonts[] array?
+			return false;
+		}
+		const int font_offset = stbtt_GetFontOffsetForIndex((unsigned char*)cfg.FontData, cfg.FontNo);
+		IM_ASSERT(font_offset >= 0 && "FontData is incorrect, or FontNo cannot be found.");
+		if (!stbtt_InitFont(&src_tmp.FontInfo, (unsigned char*)cfg.FontData, font_offset))
+			return false;
+
+		// Measure highest codepoints
+		ImExtFontBuildDstData& dst_tmp = dst_tmp_array[src_tmp.DstIndex];
+		src_tmp.SrcRanges = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault();
+		for (const ImWchar* src_range = src_tmp.SrcRanges; src_range[0] && src_range[1]; src_range += 2)
+			src_tmp.GlyphsHighest = ImMax(src_tmp.GlyphsHighest, (int)src_range[1]);
+		dst_tmp.SrcCount++;
+		dst_tmp.GlyphsHighest = ImMax(dst_tmp.GlyphsHighest, src_tmp.GlyphsHighest);
+	}
+
+	// 2. For every requested codepoint, check for their presence in the font data, and handle redundancy or overlaps between source fonts
+	int total_glyphs_count = 0;
+	for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+	{
+		ImExtFontBuildSrcData& src_tmp = src_tmp_array[src_i];
+		ImExtFontBuildDstData& dst_tmp = dst_tmp_array[src_tmp.DstIndex];
+		src_tmp.GlyphsSet.Create(src_tmp.GlyphsHighest + 1);
+		if (dst_tmp.GlyphsSet.Storage.empty())
+			dst_tmp.GlyphsSet.Create(dst_tmp.GlyphsHighest + 1);
+
+		for (const ImWchar* src_range = src_tmp.SrcRanges; src_range[0] && src_range[1]; src_range += 2)
+			for (unsigned int codepoint = src_range[0]; codepoint <= src_range[1]; codepoint++)
+			{
+				if (dst_tmp.GlyphsSet.TestBit(codepoint))
+					continue;
+				if (!stbtt_FindGlyphIndex(&src_tmp.FontInfo, codepoint))
+					continue;
+
+				src_tmp.GlyphsCount++;
+				dst_tmp.GlyphsCount++;
+				src_tmp.GlyphsSet.SetBit(codepoint);
+				dst_tmp.GlyphsSet.SetBit(codepoint);
+				total_glyphs_count++;
+			}
+	}
+
+	// 3. Unpack our bit map into a flat list
+	for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+	{
+		ImExtFontBuildSrcData& src_tmp = src_tmp_array[src_i];
+		src_tmp.GlyphsList.reserve(src_tmp.GlyphsCount);
+		UnpackBitVectorToFlatIndexList(&src_tmp.GlyphsSet, &src_tmp.GlyphsList);
+		src_tmp.GlyphsSet.Clear();
+		IM_ASSERT(src_tmp.GlyphsList.Size == src_tmp.GlyphsCount);
+	}
+	for (int dst_i = 0; dst_i < dst_tmp_array.Size; dst_i++)
+		dst_tmp_array[dst_i].GlyphsSet.Clear();
+	dst_tmp_array.clear();
+
+	ImVector<stbrp_rect> buf_rects;
+	ImVector<stbtt_packedchar> buf_packedchars;
+	buf_rects.resize(total_glyphs_count);
+	buf_packedchars.resize(total_glyphs_count);
+	memset((void*)buf_rects.Data, 0, (size_t)buf_rects.size_in_bytes());
+	memset((void*)buf_packedchars.Data, 0, (size_t)buf_packedchars.size_in_bytes());
+
+	// 4. Gather glyphs sizes so we can pack them in our virtual canvas
+	int total_surface = 0;
+	int buf_rects_out_n = 0;
+	int buf_packedchars_out_n = 0;
+	for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+	{
+		ImExtFontBuildSrcData& src_tmp = src_tmp_array[src_i];
+		if (src_tmp.GlyphsCount == 0)
+			continue;
+
+		src_tmp.Rects = &buf_rects[buf_rects_out_n];
+		src_tmp.PackedChars = &buf_packedchars[buf_packedchars_out_n];
+		buf_rects_out_n += src_tmp.GlyphsCount;
+		buf_packedchars_out_n += src_tmp.GlyphsCount;
+
+		ImFontConfig& cfg = atlas->ConfigData[src_i];
+		src_tmp.PackRange.font_size = cfg.SizePixels;
+		src_tmp.PackRange.first_unicode_codepoint_in_range = 0;
+		src_tmp.PackRange.array_of_unicode_codepoints = src_tmp.GlyphsList.Data;
+		src_tmp.PackRange.num_chars = src_tmp.GlyphsList.Size;
+		src_tmp.PackRange.chardata_for_range = src_tmp.PackedChars;
+		src_tmp.PackRange.h_oversample = (unsigned char)cfg.OversampleH;
+		src_tmp.PackRange.v_oversample = (unsigned char)cfg.OversampleV;
+
+		const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels);
+		const int padding = atlas->TexGlyphPadding;
+		for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
+		{
+			int x0, y0, x1, y1;
+			const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
+			IM_ASSERT(glyph_index_in_font != 0);
+			stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+			src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
+			src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
+			total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+		}
+	}
+
+	const int surface_sqrt = (int)ImSqrt((float)total_surface) + 1;
+	atlas->TexHeight = 0;
+	if (atlas->TexDesiredWidth > 0)
+		atlas->TexWidth = atlas->TexDesiredWidth;
+	else
+		atlas->TexWidth = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : 512;
+
+	// 5. Start packing, custom rectangles first
+	const int TEX_HEIGHT_MAX = 1024 * 32;
+	stbtt_pack_context spc = {};
+	stbtt_PackBegin(&spc, NULL, atlas->TexWidth, TEX_HEIGHT_MAX, 0, atlas->TexGlyphPadding, NULL);
+	ImFontAtlasBuildPackCustomRects(atlas, spc.pack_info);
+
+	// 6. Pack each source font, serially so that glyph positions don't depend on the thread count
+	for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+	{
+		ImExtFontBuildSrcData& src_tmp = src_tmp_array[src_i];
+		if (src_tmp.GlyphsCount == 0)
+			continue;
+
+		stbrp_pack_rects((stbrp_context*)spc.pack_info, src_tmp.Rects, src_tmp.GlyphsCount);
+		for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++)
+			if (src_tmp.Rects[glyph_i].was_packed)
+				atlas->TexHeight = ImMax(atlas->TexHeight, src_tmp.Rects[glyph_i].y + src_tmp.Rects[glyph_i].h);
+	}
+
+	// 7. Allocate texture
+	atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
+	atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
+	atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
+	memset(atlas->TexPixelsAlpha8, 0, atlas->TexWidth * atlas->TexHeight);
+	spc.pixels = atlas->TexPixelsAlpha8;
+	spc.height = atlas->TexHeight;
+
+	// 8. Render/rasterize font characters into the texture, in batches of glyphs picked by the workers and the calling thread
+	ImVector<ImExtFontBuildJob> jobs;
+	for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+		for (int glyph_i = 0; glyph_i < src_tmp_array[src_i].GlyphsCount; glyph_i += IMEXT_FONT_BUILDER_BATCH_SIZE)
+		{
+			ImExtFontBuildJob job;
+			job.SrcIndex = src_i;
+			job.GlyphStart = glyph_i;
+			job.GlyphCount = ImMin(IMEXT_FONT_BUILDER_BATCH_SIZE, src_tmp_array[src_i].GlyphsCount - glyph_i);
+			jobs.push_back(job);
+		}
+
+	ImExtFontBuildContext build_ctx;
+	build_ctx.Atlas = atlas;
+	build_ctx.PackContext = &spc;
+	build_ctx.Src = src_tmp_array.Data;
+	build_ctx.Jobs = jobs.Data;
+	build_ctx.JobsCount = jobs.Size;
+	build_ctx.JobNext = 0;
+
+	int threads_count = (GImExtFontBuilderThreadsCount > 0) ? GImExtFontBuilderThreadsCount : (int)std::thread::hardware_concurrency();
+	threads_count = ImClamp(ImMin(threads_count, jobs.Size), 1, IMEXT_FONT_BUILDER_MAX_THREADS);
+	std::thread workers[IMEXT_FONT_BUILDER_MAX_THREADS - 1];
+	for (int n = 0; n < threads_count - 1; n++)
+		workers[n] = std::thread(FontBuildRenderJobs, &build_ctx);
+	FontBuildRenderJobs(&build_ctx);
+	for (int n = 0; n < threads_count - 1; n++)
+		workers[n].join();
+
+	// End packing
+	stbtt_PackEnd(&spc);
+	for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+		src_tmp_array[src_i].Rects = NULL;
+	buf_rects.clear();
+
+	// 9. Setup ImFont and glyphs for runtime
+	for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+	{
+		ImExtFontBuildSrcData& src_tmp = src_tmp_array[src_i];
+		if (src_tmp.GlyphsCount == 0)
+			continue;
+
+		ImFontConfig& cfg = atlas->ConfigData[src_i];
+		ImFont* dst_font = cfg.DstFont;
+
+		const float font_scale = stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels);
+		int unscaled_ascent, unscaled_descent, unscaled_line_gap;
+		stbtt_GetFontVMetrics(&src_tmp.FontInfo, &unscaled_ascent, &unscaled_descent, &unscaled_line_gap);
+
+		const float ascent = ImFloor(unscaled_ascent * font_scale + ((unscaled_ascent > 0.0f) ? +1 : -1));
+		const float descent = ImFloor(unscaled_descent * font_scale + ((unscaled_descent > 0.0f) ? +1 : -1));
+		ImFontAtlasBuildSetupFont(atlas, dst_font, &cfg, ascent, descent);
+		const float font_off_x = cfg.GlyphOffset.x;
+		const float font_off_y = cfg.GlyphOffset.y + IM_ROUND(dst_font->Ascent);
+
+		for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++)
+		{
+			const int codepoint = src_tmp.GlyphsList[glyph_i];
+			const stbtt_packedchar& pc = src_tmp.PackedChars[glyph_i];
+			stbtt_aligned_quad q;
+			float unused_x = 0.0f, unused_y = 0.0f;
+			stbtt_GetPackedQuad(src_tmp.PackedChars, atlas->TexWidth, atlas->TexHeight, glyph_i, &unused_x, &unused_y, &q, 0);
+			dst_font->AddGlyph(&cfg, (ImWchar)codepoint, q.x0 + font_off_x, q.y0 + font_off_y, q.x1 + font_off_x, q.y1 + font_off_y, q.s0, q.t0, q.s1, q.t1, pc.xadvance);
+		}
+	}
+
+	// Cleanup
+	src_tmp_array.clear_destruct();
+
+	ImFontAtlasBuildFinish(atlas);
+	return true;
+}
+
+#define IMEXT_DYNAMIC_GLYPHS_PER_FRAME  32 // Rasterization budget, remaining glyphs wait for the next frames
+
+struct ImExtGlyphRequest
+{
+	ImFont* Font;
+	ImWchar Codepoint;
+
+	ImGuiID GetKey() const { return ImHashData(&Font, sizeof(Font), (ImGuiID)Codepoint); }
+};
+
+struct ImExtDynamicFontInfo
+{
+	stbtt_fontinfo Info;
+	bool Valid;
+};
+
+struct ImExtDynamicGlyphs
+{
+	ImFontAtlas* Atlas;
+	int RectId;                         // Custom rectangle reserved for the glyphs
+	unsigned char* TexPixels;           // Texture the packer state refers to, a rebuild resets everything
+	int ShelfX, ShelfY, ShelfHeight;    // Packing cursor, relative to the reserved rectangle
+	ImVector<ImExtGlyphRequest> Queue;
+	ImGuiStorage Requested;             // Hash of (font, codepoint) -> 1 once queued
+	ImVector<ImExtDynamicFontInfo> FontInfos; // Per atlas->ConfigData[]
+
+	ImExtDynamicGlyphs() { Atlas = NULL; RectId = -1; TexPixels = NULL; ShelfX = ShelfY = ShelfHeight = 0; }
+};
+
+// Start over with the texture now in the atlas and its packing cursor, only the pending requests are kept
+static void ResetDynamicGlyphs(ImExtDynamicGlyphs* dg, int shelf_x, int shelf_y, int shelf_height)
+{
+	dg->TexPixels = dg->Atlas->TexPixelsAlpha8;
+	dg->ShelfX = shelf_x;
+	dg->ShelfY = shelf_y;
+	dg->ShelfHeight = shelf_height;
+	dg->Requested.Clear();
+	for (int n = 0; n < dg->Queue.Size; n++)
+		dg->Requested.SetInt(dg->Queue[n].GetKey(), 1);
+	dg->FontInfos.resize(0);
+}
+
+const ImFontBuilderIO* ImExt::GetFontBuilderParallel(int threads_count)
+{
+	static ImFontBuilderIO io;
+	io.FontBuilder_Build = FontAtlasBuildParallel;
+	GImExtFontBuilderThreadsCount = threads_count;
+	return &io;
+}
+#endif // IMGUI_ENABLE_STB_TRUETYPE
+#pragma endregion
+
+#pragma region FontAtlasCache
+// Built atlas saved to disk with a hash of everything the build depends on: font files content, font configs,
+// custom rectangles and atlas settings. Loading maps the file and copies texture and glyphs into the atlas.
+
+#define IMEXT_FONT_ATLAS_CACHE_VERSION  2
+
+struct ImExtFontAtlasCacheHeader
+{
+	char Magic[4];                      // "IEFA"
+	ImU32 Version;
+	ImU64 Hash;
+	int TexWidth, TexHeight;
+	ImVec2 TexUvScale;
+	ImVec2 TexUvWhitePixel;
+	ImVec4 TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+	int FontsCount;
+	int CustomRectsCount;
+	int DynamicGlyphsShelfX, DynamicGlyphsShelfY, DynamicGlyphsShelfHeight; // Packing cursor of the glyphs added on demand, saved with them
+	// Followed by: X/Y of each custom rect, fonts (ImExtFontAtlasCacheFont + glyphs), TexWidth * TexHeight alpha pixels
+};
+
+struct ImExtFontAtlasCacheFont
+{
+	float FontSize;
+	float Ascent, Descent;
+	int ConfigDataIndex;                // First config in atlas->ConfigData
+	int ConfigDataCount;
+	int MetricsTotalSurface;
+	int GlyphsCount;
+};
+
+struct ImExtMappedFile
+{
+	const unsigned char* Data;
+	size_t Size;
+#ifdef _WIN32
+	HANDLE File, Mapping;
+#else
+	int Fd;
+#endif
+};
+
+static bool MapFile(ImExtMappedFile* mf, const char* filename)
+{
+	mf->Data = NULL;
+	mf->Size = 0;
+#ifdef _WIN32
+	const int filename_wsize = ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, NULL, 0);
+	ImVector<wchar_t> filename_w;
+	filename_w.resize(filename_wsize);
+	::MultiByteToWideChar(CP_UTF8, 0, filename, -1, filename_w.Data, filename_wsize);
+	mf->File = ::CreateFileW(filename_w.Data, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	mf->Mapping = NULL;
+	if (mf->File == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER size;
+	if (::GetFileSizeEx(mf->File, &size) && size.QuadPart > 0)
+		if ((mf->Mapping = ::CreateFileMappingW(mf->File, NULL, PAGE_READONLY, 0, 0, NULL)) != NULL)
+			if ((mf->Data = (const unsigned char*)::MapViewOfFile(mf->Mapping, FILE_MAP_READ, 0, 0, 0)) != NULL)
+				mf->Size = (size_t)size.QuadPart;
+#else
+	mf->Fd = open(filename, O_RDONLY);
+	if (mf->Fd < 0)
+		return false;
+	struct stat st;
+	if (fstat(mf->Fd, &st) == 0 && st.st_size > 0)
+	{
+		void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, mf->Fd, 0);
+		if (data != MAP_FAILED)
+		{
+			mf->Data = (const unsigned char*)data;
+			mf->Size = (size_t)st.st_size;
+		}
+	}
+#endif
+	return mf->Data != NULL;
+}
+
+static void UnmapFile(ImExtMappedFile* mf)
+{
+#ifdef _WIN32
+	if (mf->Data)
+		::UnmapViewOfFile(mf->Data);
+	if (mf->Mapping)
+		::CloseHandle(mf->Mapping);
+	if (mf->File != INVALID_HANDLE_VALUE)
+		::CloseHandle(mf->File);
+#else
+	if (mf->Data)
+		munmap((void*)mf->Data, mf->Size);
+	if (mf->Fd >= 0)
+		close(mf->Fd);
+#endif
+	mf->Data = NULL;
+	mf->Size = 0;
+}
+
+// 64-bit hash for megabytes of font data, CRC32 is both too slow and too narrow here
+static ImU64 HashData64(const void* data, size_t data_size, ImU64 seed)
+{
+	const ImU64 m = 0xC6A4A7935BD1E995ull;
+	ImU64 h = seed ^ (data_size * m);
+	const unsigned char* p = (const unsigned char*)data;
+	for (; data_size >= 8; data_size -= 8, p += 8)
+	{
+		ImU64 k;
+		memcpy(&k, p, 8);
+		k *= m;
+		k ^= k >> 47;
+		k *= m;
+		h ^= k;
+		h *= m;
+	}
+	if (data_size > 0)
+	{
+		ImU64 k = 0;
+		memcpy(&k, p, data_size);
+		h ^= k;
+		h *= m;
+	}
+	h ^= h >> 47;
+	h *= m;
+	h ^= h >> 47;
+	return h;
+}
+
+static int FindFontIndex(const ImFontAtlas* atlas, const ImFont* font)
+{
+	for (int n = 0; n < atlas->Fonts.Size; n++)
+		if (atlas->Fonts[n] == font)
+			return n;
+	return -1;
+}
+
+static ImU64 FontAtlasCacheHash(const ImFontAtlas* atlas)
+{
+	struct
+	{
+		int Version, ImGuiVersion, WcharSize, GlyphSize, FreeType;
+		int Flags, TexDesiredWidth, TexGlyphPadding;
+		unsigned int FontBuilderFlags;
+		int FontsCount, ConfigDataCount, CustomRectsCount;
+	} atlas_key;
+	memset((void*)&atlas_key, 0, sizeof(atlas_key)); // Clear padding
+	atlas_key.Version = IMEXT_FONT_ATLAS_CACHE_VERSION;
+	atlas_key.ImGuiVersion = IMGUI_VERSION_NUM;
+	atlas_key.WcharSize = (int)sizeof(ImWchar);
+	atlas_key.GlyphSize = (int)sizeof(ImFontGlyph);
+#ifdef IMGUI_ENABLE_FREETYPE
+	atlas_key.FreeType = 1;
+#endif
+	atlas_key.Flags = atlas->Flags;
+	atlas_key.TexDesiredWidth = atlas->TexDesiredWidth;
+	atlas_key.TexGlyphPadding = atlas->TexGlyphPadding;
+	atlas_key.FontBuilderFlags = atlas->FontBuilderFlags;
+	atlas_key.FontsCount = atlas->Fonts.Size;
+	atlas_key.ConfigDataCount = atlas->ConfigData.Size;
+	atlas_key.CustomRectsCount = atlas->CustomRects.Size;
+	ImU64 hash = HashData64(&atlas_key, sizeof(atlas_key), 0);
+
+	for (int n = 0; n < atlas->ConfigData.Size; n++)
+	{
+		const ImFontConfig& cfg = atlas->ConfigData[n];
+		struct
+		{
+			int FontDataSize, FontNo;
+			float SizePixels;
+			int OversampleH, OversampleV;
+			bool PixelSnapH, MergeMode;
+			ImVec2 GlyphExtraSpacing, GlyphOffset;
+			float GlyphMinAdvanceX, GlyphMaxAdvanceX;
+			unsigned int FontBuilderFlags;
+			float RasterizerMultiply;
+			ImWchar EllipsisChar;
+			int DstFont;
+		} cfg_key;
+		memset((void*)&cfg_key, 0, sizeof(cfg_key));
+		cfg_key.FontDataSize = cfg.FontDataSize;
+		cfg_key.FontNo = cfg.FontNo;
+		cfg_key.SizePixels = cfg.SizePixels;
+		cfg_key.OversampleH = cfg.OversampleH;
+		cfg_key.OversampleV = cfg.OversampleV;
+		cfg_key.PixelSnapH = cfg.PixelSnapH;
+		cfg_key.MergeMode = cfg.MergeMode;
+		cfg_key.GlyphExtraSpacing = cfg.GlyphExtraSpacing;
+		cfg_key.GlyphOffset = cfg.GlyphOffset;
+		cfg_key.GlyphMinAdvanceX = cfg.GlyphMinAdvanceX;
+		cfg_key.GlyphMaxAdvanceX = cfg.GlyphMaxAdvanceX;
+		cfg_key.FontBuilderFlags = cfg.FontBuilderFlags;
+		cfg_key.RasterizerMultiply = cfg.RasterizerMultiply;
+		cfg_key.EllipsisChar = cfg.EllipsisChar;
+		cfg_key.DstFont = FindFontIndex(atlas, cfg.DstFont);
+		hash = HashData64(&cfg_key, sizeof(cfg_key), hash);
+		hash = HashData64(cfg.FontData, (size_t)cfg.FontDataSize, hash);
+		if (cfg.GlyphRanges)
+		{
+			int ranges_size = 0;
+			while (cfg.GlyphRanges[ranges_size] != 0)
+				ranges_size++;
+			hash = HashData64(cfg.GlyphRanges, sizeof(ImWchar) * ranges_size, hash);
+		}
+	}
+
+	for (int n = 0; n < atlas->CustomRects.Size; n++)
+	{
+		const ImFontAtlasCustomRect& r = atlas->CustomRects[n];
+		struct
+		{
+			int Width, Height;
+			unsigned int GlyphID;
+			float GlyphAdvanceX;
+			ImVec2 GlyphOffset;
+			int Font;
+		} rect_key;
+		memset((void*)&rect_key, 0, sizeof(rect_key));
+		rect_key.Width = r.Width;
+		rect_key.Height = r.Height;
+		rect_key.GlyphID = r.GlyphID;
+		rect_key.GlyphAdvanceX = r.GlyphAdvanceX;
+		rect_key.GlyphOffset = r.GlyphOffset;
+		rect_key.Font = FindFontIndex(atlas, r.Font);
+		hash = HashData64(&rect_key, sizeof(rect_key), hash);
+	}
+	return hash;
+}
+
+bool ImExt::LoadFontAtlasCache(ImFontAtlas* atlas, const char* filename)
+{
+	IM_ASSERT(!atlas->Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+	if (atlas->ConfigData.Size == 0)
+		atlas->AddFontDefault();
+	ImFontAtlasBuildInit(atlas); // Registers the mouse cursors and lines rectangles, which are part of the hash
+
+	ImExtMappedFile mf;
+	if (!MapFile(&mf, filename))
+	{
+		UnmapFile(&mf);
+		return false;
+	}
+
+	// Validate header and sizes before touching the atlas
+	bool valid = false;
+	ImExtFontAtlasCacheHeader header;
+	size_t fonts_offset = 0;
+	size_t pixels_offset = 0;
+	if (mf.Size >= sizeof(header))
+	{
+		memcpy(&header, mf.Data, sizeof(header));
+		valid = memcmp(header.Magic, "IEFA", 4) == 0 && header.Version == IMEXT_FONT_ATLAS_CACHE_VERSION && header.Hash == FontAtlasCacheHash(atlas) &&
+			header.FontsCount == atlas->Fonts.Size && header.CustomRectsCount == atlas->CustomRects.Size && header.TexWidth > 0 && header.TexHeight > 0 &&
+			header.DynamicGlyphsShelfX >= 0 && header.DynamicGlyphsShelfY >= 0 && header.DynamicGlyphsShelfHeight >= 0;
+		fonts_offset = sizeof(header) + sizeof(unsigned short) * 2 * header.CustomRectsCount;
+		size_t offset = fonts_offset;
+		for (int n = 0; valid && n < header.FontsCount; n++)
+		{
+			ImExtFontAtlasCacheFont font;
+			valid = offset + sizeof(font) <= mf.Size;
+			if (!valid)
+				break;
+			memcpy(&font, mf.Data + offset, sizeof(font));
+			valid = font.GlyphsCount >= 0 && font.ConfigDataIndex >= -1 && font.ConfigDataIndex < atlas->ConfigData.Size;
+			offset += sizeof(font) + sizeof(ImFontGlyph) * font.GlyphsCount;
+		}
+		pixels_offset = offset;
+		valid = valid && pixels_offset + (size_t)header.TexWidth * header.TexHeight == mf.Size;
+	}
+	if (!valid)
+	{
+		UnmapFile(&mf);
+		return false;
+	}
+
+	atlas->ClearTexData();
+	atlas->TexID = (ImTextureID)NULL;
+	atlas->TexWidth = header.TexWidth;
+	atlas->TexHeight = header.TexHeight;
+	atlas->TexUvScale = header.TexUvScale;
+	atlas->TexUvWhitePixel = header.TexUvWhitePixel;
+	memcpy(atlas->TexUvLines, header.TexUvLines, sizeof(atlas->TexUvLines));
+	atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
+	memcpy(atlas->TexPixelsAlpha8, mf.Data + pixels_offset, (size_t)atlas->TexWidth * atlas->TexHeight);
+
+	const unsigned char* p = mf.Data + sizeof(header);
+	for (int n = 0; n < atlas->CustomRects.Size; n++, p += sizeof(unsigned short) * 2)
+	{
+		memcpy(&atlas->CustomRects[n].X, p, sizeof(unsigned short));
+		memcpy(&atlas->CustomRects[n].Y, p + sizeof(unsigned short), sizeof(unsigned short));
+	}
+	for (int n = 0; n < atlas->Fonts.Size; n++)
+	{
+		ImExtFontAtlasCacheFont font_data;
+		memcpy(&font_data, p, sizeof(font_data));
+		p += sizeof(font_data);
+		ImFont* font = atlas->Fonts[n];
+		font->ClearOutputData();
+		font->FontSize = font_data.FontSize;
+		font->Ascent = font_data.Ascent;
+		font->Descent = font_data.Descent;
+		font->ConfigData = (font_data.ConfigDataIndex >= 0) ? &atlas->ConfigData[font_data.ConfigDataIndex] : NULL;
+		font->ConfigDataCount = (short)font_data.ConfigDataCount;
+		font->MetricsTotalSurface = font_data.MetricsTotalSurface;
+		font->ContainerAtlas = (font_data.ConfigDataIndex >= 0) ? atlas : NULL;
+		font->Glyphs.resize(font_data.GlyphsCount);
+		memcpy(font->Glyphs.Data, p, sizeof(ImFontGlyph) * font_data.GlyphsCount);
+		p += sizeof(ImFontGlyph) * font_data.GlyphsCount;
+		font->BuildLookupTable();
+	}
+	UnmapFile(&mf);
+	atlas->TexReady = true;
+
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+	// Further glyphs on demand are packed after the ones saved in the texture
+	ImExtDynamicGlyphs* dg = GImExtDynamicGlyphs;
+	if (dg != NULL && dg->Atlas == atlas)
+		ResetDynamicGlyphs(dg, header.DynamicGlyphsShelfX, header.DynamicGlyphsShelfY, header.DynamicGlyphsShelfHeight);
+#endif
+	return true;
+}
+
+bool ImExt::SaveFontAtlasCache(ImFontAtlas* atlas, const char* filename)
+{
+	if (atlas->TexPixelsAlpha8 == NULL)
+	{
+		unsigned char* pixels;
+		int width, height;
+		atlas->GetTexDataAsAlpha8(&pixels, &width, &height);
+	}
+	if (atlas->TexPixelsAlpha8 == NULL)
+		return false;
+
+	ImFileHandle f = ImFileOpen(filename, "wb");
+	if (f == NULL)
+		return false;
+
+	ImExtFontAtlasCacheHeader header;
+	memset((void*)&header, 0, sizeof(header));
+	memcpy(header.Magic, "IEFA", 4);
+	header.Version = IMEXT_FONT_ATLAS_CACHE_VERSION;
+	header.Hash = FontAtlasCacheHash(atlas);
+	header.TexWidth = atlas->TexWidth;
+	header.TexHeight = atlas->TexHeight;
+	header.TexUvScale = atlas->TexUvScale;
+	header.TexUvWhitePixel = atlas->TexUvWhitePixel;
+	memcpy(header.TexUvLines, atlas->TexUvLines, sizeof(header.TexUvLines));
+	header.FontsCount = atlas->Fonts.Size;
+	header.CustomRectsCount = atlas->CustomRects.Size;
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+	const ImExtDynamicGlyphs* dg = GImExtDynamicGlyphs;
+	if (dg != NULL && dg->Atlas == atlas && dg->TexPixels == atlas->TexPixelsAlpha8)
+	{
+		header.DynamicGlyphsShelfX = dg->ShelfX;
+		header.DynamicGlyphsShelfY = dg->ShelfY;
+		header.DynamicGlyphsShelfHeight = dg->ShelfHeight;
+	}
+#endif
+	bool ok = ImFileWrite(&header, sizeof(header), 1, f) == 1;
+	for (int n = 0; n < atlas->CustomRects.Size; n++)
+	{
+		const unsigned short xy[2] = { atlas->CustomRects[n].X, atlas->CustomRects[n].Y };
+		ok &= ImFileWrite(xy, sizeof(xy), 1, f) == 1;
+	}
+	for (int n = 0; n < atlas->Fonts.Size; n++)
+	{
+		const ImFont* font = atlas->Fonts[n];
+		ImExtFontAtlasCacheFont font_data;
+		memset((void*)&font_data, 0, sizeof(font_data));
+		font_data.FontSize = font->FontSize;
+		font_data.Ascent = font->Ascent;
+		font_data.Descent = font->Descent;
+		font_data.ConfigDataIndex = font->ConfigData ? (int)(font->ConfigData - atlas->ConfigData.Data) : -1;
+		font_data.ConfigDataCount = font->ConfigDataCount;
+		font_data.MetricsTotalSurface = font->MetricsTotalSurface;
+		font_data.GlyphsCount = font->Glyphs.Size;
+		ok &= ImFileWrite(&font_data, sizeof(font_data), 1, f) == 1;
+		if (font->Glyphs.Size > 0)
+			ok &= ImFileWrite(font->Glyphs.Data, sizeof(ImFontGlyph), (ImU64)font->Glyphs.Size, f) == (ImU64)font->Glyphs.Size;
+	}
+	ok &= ImFileWrite(atlas->TexPixelsAlpha8, (ImU64)atlas->TexWidth * atlas->TexHeight, 1, f) == 1;
+	ImFileClose(f);
+	return ok;
+}
+#pragma endregion
+
+#pragma region DynamicGlyphs
+// Glyphs missing from the loaded ranges are rasterized on first use into a region reserved in the atlas texture.
+// Text shows the fallback glyph until the next NewFrame(), where queued glyphs are rendered with stb_truetype from the
+// fonts source data, added to their ImFont and the updated texture area is reported to the backend.
+void ImExt::RequestGlyphs(ImFont* font, const char* text, const char* text_end)
+{
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+	ImExtDynamicGlyphs* dg = GImExtDynamicGlyphs;
+	if (dg == NULL || font == NULL || font->ContainerAtlas != dg->Atlas)
+		return;
+	if (text_end == NULL)
+		text_end = text + strlen(text);
+	for (const char* s = text; s < text_end; )
+	{
+		unsigned int c = (unsigned int)*s;
+		if (c < 0x80)
+			s += 1;
+		else
+			s += ImTextCharFromUtf8(&c, s, text_end);
+		if (c < 0x20 || c > IM_UNICODE_CODEPOINT_MAX || font->FindGlyphNoFallback((ImWchar)c) != NULL)
+			continue;
+
+		ImExtGlyphRequest request;
+		request.Font = font;
+		request.Codepoint = (ImWchar)c;
+		const ImGuiID key_id = request.GetKey();
+		if (dg->Requested.GetInt(key_id, 0) != 0) // Queued, or missing from the source fonts, or atlas region full
+			continue;
+		dg->Requested.SetInt(key_id, 1);
+		dg->Queue.push_back(request);
+	}
+#else
+	IM_UNUSED(font);
+	IM_UNUSED(text);
+	IM_UNUSED(text_end);
+#endif
+}
+
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+bool ImExt::EnableDynamicGlyphs(ImFontAtlas* atlas, int width, int height)
+{
+	IM_ASSERT(!atlas->IsBuilt() && "Call before building the atlas, the glyphs region is reserved as a custom rectangle");
+	if (GImExtDynamicGlyphs == NULL)
+		GImExtDynamicGlyphs = IM_NEW(ImExtDynamicGlyphs)();
+	ImExtDynamicGlyphs* dg = GImExtDynamicGlyphs;
+	dg->Atlas = atlas;
+	dg->RectId = atlas->AddCustomRectRegular(width, height);
+	if (atlas->TexDesiredWidth < width + atlas->TexGlyphPadding) // The builder sizes the texture from the glyphs only
+		atlas->TexDesiredWidth = (int)ImUpperPowerOfTwo(width + atlas->TexGlyphPadding);
+	dg->TexPixels = NULL;
+	return dg->RectId >= 0;
+}
+
+// Render one glyph of 'cfg' into the atlas at the shelf packer position, see stbtt_PackFontRangesRenderIntoRects()
+static bool RasterizeDynamicGlyph(ImExtDynamicGlyphs* dg, ImFont* font, ImFontConfig* cfg, stbtt_fontinfo* info, int glyph, ImWchar codepoint, ImRect* dirty_rect)
+{
+	ImFontAtlas* atlas = dg->Atlas;
+	const ImFontAtlasCustomRect* region = atlas->GetCustomRectByIndex(dg->RectId);
+	const int pad = atlas->TexGlyphPadding;
+	const int oh = cfg->OversampleH, ov = cfg->OversampleV;
+	const float scale = (cfg->SizePixels > 0) ? stbtt_ScaleForPixelHeight(info, cfg->SizePixels) : stbtt_ScaleForMappingEmToPixels(info, -cfg->SizePixels);
+	int x0, y0, x1, y1;
+	stbtt_GetGlyphBitmapBoxSubpixel(info, glyph, scale * oh, scale * ov, 0, 0, &x0, &y0, &x1, &y1);
+	const int w = x1 - x0 + pad + oh - 1;
+	const int h = y1 - y0 + pad + ov - 1;
+
+	// Shelf packing, keeping 'pad' free on the right and bottom edges of the region
+	const int region_w = region->Width - pad, region_h = region->Height - pad;
+	if (dg->ShelfX + w > region_w)
+	{
+		dg->ShelfX = 0;
+		dg->ShelfY += dg->ShelfHeight;
+		dg->ShelfHeight = 0;
+	}
+	if (w > region_w || dg->ShelfY + h > region_h)
+		return false;
+	int rx = region->X + dg->ShelfX + pad, ry = region->Y + dg->ShelfY + pad;
+	const int rw = w - pad, rh = h - pad;
+	dg->ShelfX += w;
+	dg->ShelfHeight = ImMax(dg->ShelfHeight, h);
+
+	const int stride = atlas->TexWidth;
+	unsigned char* pixels = atlas->TexPixelsAlpha8 + rx + ry * stride;
+	stbtt_MakeGlyphBitmapSubpixel(info, pixels, rw - oh + 1, rh - ov + 1, stride, scale * oh, scale * ov, 0, 0, glyph);
+	if (oh > 1)
+		stbtt__h_prefilter(pixels, rw, rh, stride, oh);
+	if (ov > 1)
+		stbtt__v_prefilter(pixels, rw, rh, stride, ov);
+	if (cfg->RasterizerMultiply != 1.0f)
+	{
+		unsigned char multiply_table[256];
+		ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg->RasterizerMultiply);
+		ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, rx, ry, rw, rh, stride);
+	}
+	if (atlas->TexPixelsRGBA32 != NULL) // Keep the converted copy in sync, backends usually upload that one
+		for (int y = ry; y < ry + rh; y++)
+			for (int x = rx; x < rx + rw; x++)
+				atlas->TexPixelsRGBA32[x + y * stride] = IM_COL32(255, 255, 255, atlas->TexPixelsAlpha8[x + y * stride]);
+	dirty_rect->Add(ImRect((float)rx, (float)ry, (float)(rx + rw), (float)(ry + rh)));
+
+	int advance, lsb;
+	stbtt_GetGlyphHMetrics(info, glyph, &advance, &lsb);
+	stbtt_packedchar pc;
+	pc.x0 = (stbtt_int16)rx;
+	pc.y0 = (stbtt_int16)ry;
+	pc.x1 = (stbtt_int16)(rx + rw);
+	pc.y1 = (stbtt_int16)(ry + rh);
+	pc.xadvance = scale * advance;
+	pc.xoff = (float)x0 / oh + stbtt__oversample_shift(oh);
+	pc.yoff = (float)y0 / ov + stbtt__oversample_shift(ov);
+	pc.xoff2 = (float)(x0 + rw) / oh + stbtt__oversample_shift(oh);
+	pc.yoff2 = (float)(y0 + rh) / ov + stbtt__oversample_shift(ov);
+
+	stbtt_aligned_quad q;
+	float unused_x = 0.0f, unused_y = 0.0f;
+	stbtt_GetPackedQuad(&pc, atlas->TexWidth, atlas->TexHeight, 0, &unused_x, &unused_y, &q, 0);
+	const float font_off_x = cfg->GlyphOffset.x;
+	const float font_off_y = cfg->GlyphOffset.y + IM_ROUND(font->Ascent);
+	font->AddGlyph(cfg, codepoint, q.x0 + font_off_x, q.y0 + font_off_y, q.x1 + font_off_x, q.y1 + font_off_y, q.s0, q.t0, q.s1, q.t1, pc.xadvance);
 	return true;
-}
\ No newline at end of file
+}
+
+static void UpdateDynamicGlyphs(ImExtContext& e)
+{
+	ImExtDynamicGlyphs* dg = GImExtDynamicGlyphs;
+	e.IO.FontAtlasDirtyRect = ImRect(0.0f, 0.0f, 0.0f, 0.0f);
+	if (dg == NULL || dg->Atlas != e.Ctx->IO.Fonts)
+		return;
+	ImFontAtlas* atlas = dg->Atlas;
+	if (atlas->TexPixelsAlpha8 == NULL || !atlas->GetCustomRectByIndex(dg->RectId)->IsPacked())
+		return;
+
+	// Atlas was (re)built: start over with an empty region
+	if (dg->TexPixels != atlas->TexPixelsAlpha8)
+		ResetDynamicGlyphs(dg, 0, 0, 0);
+	if (dg->Queue.Size == 0)
+		return;
+
+	if (dg->FontInfos.Size != atlas->ConfigData.Size)
+	{
+		dg->FontInfos.resize(atlas->ConfigData.Size);
+		for (int n = 0; n < atlas->ConfigData.Size; n++)
+		{
+			ImFontConfig& cfg = atlas->ConfigData[n];
+			const int font_offset = cfg.FontData ? stbtt_GetFontOffsetForIndex((unsigned char*)cfg.FontData, cfg.FontNo) : -1;
+			dg->FontInfos[n].Valid = font_offset >= 0 && stbtt_InitFont(&dg->FontInfos[n].Info, (unsigned char*)cfg.FontData, font_offset);
+		}
+	}
+
+	ImRect dirty_rect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+	const int count = ImMin(dg->Queue.Size, IMEXT_DYNAMIC_GLYPHS_PER_FRAME);
+	for (int n = 0; n < count; n++)
+	{
+		ImExtGlyphRequest& request = dg->Queue[n];
+		ImFont* font = request.Font;
+		if (font->FindGlyphNoFallback(request.Codepoint) != NULL || font->ConfigData == NULL)
+			continue;
+
+		// First source font of the ImFont providing the codepoint, like the builder does for merged fonts
+		for (int cfg_n = 0; cfg_n < font->ConfigDataCount; cfg_n++)
+		{
+			const int cfg_index = (int)(font->ConfigData - atlas->ConfigData.Data) + cfg_n;
+			if (cfg_index >= dg->FontInfos.Size || !dg->FontInfos[cfg_index].Valid)
+				continue;
+			stbtt_fontinfo* info = &dg->FontInfos[cfg_index].Info;
+			if (const int glyph = stbtt_FindGlyphIndex(info, request.Codepoint))
+			{
+				RasterizeDynamicGlyph(dg, font, &atlas->ConfigData[cfg_index], info, glyph, request.Codepoint, &dirty_rect);
+				break;
+			}
+		}
+	}
+	dg->Queue.erase(dg->Queue.Data, dg->Queue.Data + count);
+
+	if (dirty_rect.Min.x <= dirty_rect.Max.x)
+	{
+		for (int n = 0; n < atlas->Fonts.Size; n++)
+			if (atlas->Fonts[n]->DirtyLookupTables)
+				atlas->Fonts[n]->BuildLookupTable();
+		e.IO.FontAtlasDirtyRect = dirty_rect;
+		GImExtGlyphsGeneration++;
+	}
+}
+#else
+static void UpdateDynamicGlyphs(ImExtContext& e)
+{
+	e.IO.FontAtlasDirtyRect = ImRect(0.0f, 0.0f, 0.0f, 0.0f);
+}
+#endif // IMGUI_ENABLE_STB_TRUETYPE
+#pragma endregion
@@ -1,9 +1,222 @@
 #pragma once
 #include <imgui.h>
 #include <imgui_internal.h>
+#include <atomic>
+
+typedef int ImExtConfigFlags;       // -> enum ImExtConfigFlags_
+
+enum ImExtConfigFlags_
+{
+	ImExtConfigFlags_None = 0,
+	ImExtConfigFlags_NoRenderCache = 1 << 0,   // Always re-tessellate widgets instead of replaying cached vertices of unchanged ones
+	ImExtConfigFlags_DamageTracking = 1 << 1,  // Fill ImExtIO::DamageRects on every ImGui::Render()
+	ImExtConfigFlags_DebugCheckAllocations = 1 << 2, // Assert on any heap allocation after DebugAllocationsWarmupFrames, requires ImExt::DebugInstallAllocationCounter(). For tests replaying a fixed scenario.
+	ImExtConfigFlags_NoGlyphRunCache = 1 << 3, // Always lay out text with ImDrawList::AddText() instead of reusing the quads of texts drawn before
+};
+
+typedef int ImExtSpinnerType;       // -> enum ImExtSpinnerType_
+
+enum ImExtSpinnerType_
+{
+	ImExtSpinnerType_Arc = 0,           // Rotating arc of varying length
+	ImExtSpinnerType_Dots,              // Three pulsing dots
+	ImExtSpinnerType_Bar,               // Segment sliding over a track (indeterminate progress bar)
+};
+
+enum ImExtLod_
+{
+	ImExtLod_Full = 0,                  // Full quality
+	ImExtLod_Reduced,                   // Fewer circle segments, no anti-aliased fringes
+	ImExtLod_Minimal,                   // + animations jump to their end state, progress labels drawn once
+};
+
+struct ImExtIO
+{
+	ImExtConfigFlags ConfigFlags;       // = 0. See ImExtConfigFlags_ enum.
+	int DamageRectsMax;                 // = 16. Above this count damaged rectangles are merged into their bounding box.
+	float AnimationMinPixelDelta;       // = 1.0f. Smallest motion (in pixels) worth a new frame while animating.
+	float AnimationMaxFrameRate;        // = 60.0f. Cap on the frame rate requested by animations.
+	float FrameBudget;                  // = 0.0f. Frame time (in seconds) above which widgets render at a lower level of detail, see ImExtLod_. 0.0f disables.
+	float FrameTime;                    // = 0.0f. Optional measured duration of the previous frame, set before NewFrame(). 0.0f uses ImGui io.DeltaTime.
+	int DebugAllocationsWarmupFrames;   // = 60. Frames allowed to allocate (pools, vertex buffers growing to their steady size) before ImExtConfigFlags_DebugCheckAllocations asserts.
+	bool (*TaskSubmitFn)(void (*func)(void* arg), void* arg, void* user_data); // = NULL. Run func(arg) on a thread of your own pool, return false when it can't take it now (retried next frame). NULL: ImExt's work-stealing pool.
+	void* TaskSubmitUserData;
+	int TaskThreadsCount;               // = 0. Threads of ImExt's pool, read when it starts (first job): 0 = one per core but one.
+
+	// Output (read after ImGui::Render())
+	ImVector<ImRect> DamageRects;       // Screen areas whose pixels changed since the previous ImGui::Render(), requires ImExtConfigFlags_DamageTracking. Empty when nothing changed.
+	int LodLevel;                       // Level of detail in use, see ImExtLod_. Updated on NewFrame from FrameBudget.
+	ImRect FontAtlasDirtyRect;          // Read after NewFrame(): texels of io.Fonts updated by dynamic glyphs, to upload before rendering. Zero area when nothing changed.
+	float NextFrameDelay;               // Seconds until an animation needs the next frame: 0.0f = as soon as possible, FLT_MAX = no animation running (wait for input events).
+
+	// Metrics (read-only, refreshed on NewFrame)
+	int MetricsRenderCacheHits;         // Widgets replayed from the render cache during the last frame
+	int MetricsRenderCacheMisses;       // Widgets tessellated during the last frame
+	int MetricsRenderCacheEntries;      // Widgets currently retained in the render cache
+	int MetricsGlyphRunHits;            // Texts emitted from cached quads during the last frame
+	int MetricsGlyphRunMisses;          // Texts laid out during the last frame
+	int MetricsGlyphRunEntries;         // Texts currently retained in the glyph run cache
+	int MetricsActiveAnimations;        // Deadlines pending in the animation scheduler
+	int MetricsAllocations;             // Heap allocations made through ImGui allocator since the previous NewFrame(), requires ImExt::DebugInstallAllocationCounter()
+
+	ImExtIO() { memset((void*)this, 0, sizeof(*this)); DamageRectsMax = 16; AnimationMinPixelDelta = 1.0f; AnimationMaxFrameRate = 60.0f; DebugAllocationsWarmupFrames = 60; NextFrameDelay = FLT_MAX; }
+};
+
+// Shared between a job and the TaskButton() which submitted it. Written and read without locks from both sides.
+struct ImExtTaskContext
+{
+	std::atomic<float> Progress;        // Written by the job, 0.0f..1.0f. Shown by the button.
+	std::atomic<bool> CancelRequested;  // Set when the button is pressed again or goes away, the job should return early
+	void* UserData;                     // As passed to TaskButton()
+
+	ImExtTaskContext() : Progress(0.0f), CancelRequested(false), UserData(NULL) {}
+};
+
+typedef void (*ImExtTaskFunc)(ImExtTaskContext* task); // Runs on a worker thread
+
+// Samples shown by Sparkline(), pushed by any number of threads without locks. Keeps the newest 'capacity' samples:
+// producers never wait, a full buffer overwrites its oldest samples.
+struct ImExtSparklineBuffer
+{
+	std::atomic<ImU64> Head;            // Samples pushed so far, the next one goes in slot Head % Capacity
+	std::atomic<float>* Values;
+	std::atomic<ImU32>* Stamps;         // Index + 1 of the sample in each slot once written, 0 while being written
+	int Capacity;                       // Power of two
+
+	IMGUI_API ImExtSparklineBuffer(int capacity = 4096);
+	IMGUI_API ~ImExtSparklineBuffer();
+	IMGUI_API void Push(float value);
+	IMGUI_API void Push(const float* values, int count);
+
+private:
+	ImExtSparklineBuffer(const ImExtSparklineBuffer&);
+	ImExtSparklineBuffer& operator=(const ImExtSparklineBuffer&);
+};
+
+// Series shown by Plot(), with a min/max pyramid updated as values are appended: Levels[n] holds the min (x) and max (y)
+// of every block of 8^(n+1) values. About 30% more memory than the values. Append from the thread calling Plot().
+#define IMEXT_PLOT_SERIES_LEVELS 9 // Up to blocks of 8^9 values, 134M
+
+struct ImExtPlotSeries
+{
+	ImVector<float> Values;
+	ImVector<ImVec2> Levels[IMEXT_PLOT_SERIES_LEVELS];
+
+	IMGUI_API void Append(float value);
+	IMGUI_API void Append(const float* values, int count);
+	IMGUI_API void Clear();
+};
+
+// Log file shown by LogView(). Memory-mapped rather than read: a background thread indexes its lines while the view shows
+// the ones indexed so far, then keeps picking up data appended to the file. One LogView() per file.
+// A file truncated while open (copytruncate rotation) is indexed again from its start. Outside Windows, reads racing the
+// truncation are caught by a SIGBUS handler installed by the first Open(), which forwards other faults to the previous one.
+struct ImExtLogFileData;
+
+struct ImExtLogFile
+{
+	ImExtLogFileData* Data;             // NULL while closed
+
+	ImExtLogFile() { Data = NULL; }
+	IMGUI_API ~ImExtLogFile();
+	IMGUI_API bool Open(const char* filename); // UTF-8. Return false when the file can't be opened.
+	IMGUI_API void Close();
+	bool IsOpen() const { return Data != NULL; }
+	IMGUI_API int GetLinesCount() const; // Newline terminated lines indexed, as of the last LogView() of the file
+
+private:
+	ImExtLogFile(const ImExtLogFile&);
+	ImExtLogFile& operator=(const ImExtLogFile&);
+};
+
+// Text edited by TextEditor(). A piece table: the text is a sequence of pieces of the original text and of an append-only
+// buffer of inserted text, kept in a balanced tree with their lengths and line break counts. Edits and lookups by offset
+// or line are O(log n), the original text is never copied again. Offsets are in bytes of UTF-8.
+struct ImExtTextBufferData;
+
+struct ImExtTextBuffer
+{
+	ImExtTextBufferData* Data;
+
+	IMGUI_API ImExtTextBuffer();
+	IMGUI_API ~ImExtTextBuffer();
+	IMGUI_API void SetText(const char* text, const char* text_end = NULL);
+	IMGUI_API void Insert(int offset, const char* text, const char* text_end = NULL);
+	IMGUI_API void Delete(int offset, int length);
+	IMGUI_API void GetText(int offset, int length, ImVector<char>* out) const; // Zero terminated
+	IMGUI_API int GetLength() const;
+	IMGUI_API int GetLinesCount() const;
+	IMGUI_API int GetLineStart(int line) const; // Offset of the first byte of 'line'
+	IMGUI_API int GetLineFromOffset(int offset) const;
+
+private:
+	ImExtTextBuffer(const ImExtTextBuffer&);
+	ImExtTextBuffer& operator=(const ImExtTextBuffer&);
+};
+
+// C++11 constexpr functions can't loop: labels are then computed once, the first time they are used
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+#define IMEXT_LABEL_CONSTEXPR   constexpr
+#else
+#define IMEXT_LABEL_CONSTEXPR
+#endif
+
+// Label with its ID hash and display length computed at compile time, see IMEXT_LABEL().
+// CRC32 is affine in its initial state: the ID of a label under any ID stack seed is the CRC of the label from a zero state
+// XOR a fixed linear map of the seed. Both are precomputed so the widget ID costs 32 conditional XORs instead of hashing the string.
+struct ImExtLabel
+{
+	const char* Text;
+	const char* TextEnd;                // End of the displayed part (first "##")
+	ImU32 HashCrc;                      // CRC32 of the hashed part (after the last "###", if any) from a zero state
+	ImU32 HashSeedCols[32];             // Image of each bit of the inverted seed after hashing that part
+
+	template<size_t N>
+	IMEXT_LABEL_CONSTEXPR ImExtLabel(const char (&text)[N]) : Text(text), TextEnd(text), HashCrc(0), HashSeedCols()
+	{
+		size_t len = 0;
+		while (len < N && text[len] != 0)
+			len++;
+		size_t display_len = 0;
+		while (display_len < len && !(text[display_len] == '#' && display_len + 1 < len && text[display_len + 1] == '#'))
+			display_len++;
+		TextEnd = text + display_len;
+
+		// Same reset rule as ImHashStr(): hashing restarts from the seed at each "###"
+		size_t hash_start = 0;
+		for (size_t n = 0; n + 2 < len; n++)
+			if (text[n] == '#' && text[n + 1] == '#' && text[n + 2] == '#')
+				hash_start = n;
+
+		for (int n = 0; n < 32; n++)
+			HashSeedCols[n] = (ImU32)1 << n;
+		for (size_t n = hash_start; n < len; n++)
+		{
+			HashCrc = CrcStep(HashCrc ^ (unsigned char)text[n]);
+			for (int col = 31; col >= 8; col--) // Bits above the low byte only get shifted down
+				HashSeedCols[col] = HashSeedCols[col - 8];
+			for (int col = 0; col < 8; col++)
+				HashSeedCols[col] = CrcStep(HashSeedCols[col]);
+		}
+	}
+
+	static IMEXT_LABEL_CONSTEXPR ImU32 CrcStep(ImU32 crc)
+	{
+		for (int n = 0; n < 8; n++)
+			crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320u : 0u);
+		return crc;
+	}
+};
+
+// Usage: ImExt::Button(IMEXT_LABEL("Play##transport")). Evaluated at compile time, the string must be a literal.
+#define IMEXT_LABEL(_LITERAL)   ([]() -> const ImExtLabel& { static IMEXT_LABEL_CONSTEXPR const ImExtLabel label(_LITERAL); return label; }())
 
 namespace ImExt 
 {
+	IMGUI_API ImExtIO& GetIO();         // Per ImGui context, created on first use
+	IMGUI_API void ShutdownTaskPool();  // Stop ImExt's task pool after its queued jobs and join its threads. Done when the last context is destroyed, the next job starts it again.
+	IMGUI_API void DebugInstallAllocationCounter(); // Wrap the current ImGui allocator functions to fill ImExtIO::MetricsAllocations. Process wide, call SetAllocatorFunctions() for your own allocator first.
+
 	IMGUI_API bool Button(const char* label, const ImVec2& size = ImVec2(NULL, NULL), const float dt = 1.0f, ImGuiButtonFlags flags = NULL);
 	IMGUI_API bool ProgressButton(const char* label, bool* v, float* v_progress, const ImVec2& size = ImVec2(NULL, NULL), const float v_speed = 0.01f, const float dt = 1.0f, ImGuiButtonFlags flags = NULL);
 	IMGUI_API bool ToggleButton(const char* label, bool* v, const ImVec2& size = { 0.f, 0.f }, const float dt = 1.0f, ImGuiButtonFlags flags = NULL);
@@ -13,13 +226,73 @@ namespace ImExt
 	IMGUI_API bool RadioButton(const char* label, int* v, int v_button, const float dt = 1.0f);
 
 	IMGUI_API bool Checkbox(const char* label, bool* v, const float dt = 1.0f);
+	IMGUI_API bool SliderFloat(const char* label, float* v, float v_min, float v_max, const char* format = "%.3f", const float dt = 1.0f, ImGuiSliderFlags flags = 0); // Grab springs to the value, a flicked grab coasts after release
+	IMGUI_API bool SliderInt(const char* label, int* v, int v_min, int v_max, const char* format = "%d", const float dt = 1.0f, ImGuiSliderFlags flags = 0);
+	IMGUI_API bool DragFloat(const char* label, float* v, float v_speed = 1.0f, float v_min = 0.0f, float v_max = 0.0f, const char* format = "%.3f", const float dt = 1.0f, ImGuiSliderFlags flags = 0);
+	IMGUI_API void AnimatedNumber(const char* str_id, double value, const char* format = "%.2f", const float dt = 1.0f); // Odometer readout tweening to 'value'. "%.Nf" and "%d" formats (with text around them) are rolled from cached digit quads, others formatted as text. Integer conversions get (int)value.
+	IMGUI_API void Sparkline(const char* str_id, const ImExtSparklineBuffer& buffer, const ImVec2& size = ImVec2(0, 0), float scale_min = FLT_MAX, float scale_max = FLT_MAX, int samples_count = 0, const float dt = 1.0f); // Newest 'samples_count' samples (default: the buffer capacity), one min/max pair per pixel column. Only new samples are decimated, new columns scroll in.
+	IMGUI_API void Plot(const char* label, const ImExtPlotSeries& series, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f); // Mouse wheel zooms, dragging pans, double-click fits all values. Follows appended values while the view reaches the end.
+	IMGUI_API void LogView(const char* str_id, ImExtLogFile& file, const char* filter = NULL, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f); // 'filter': ECMAScript regular expression (a substring ignoring case when invalid), NULL or empty shows every line. Follows appended lines while scrolled to the bottom.
+	IMGUI_API bool TextEditor(const char* str_id, ImExtTextBuffer& buffer, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f, ImGuiInputTextFlags flags = 0); // Return true when edited. Supported flags: ImGuiInputTextFlags_ReadOnly, ImGuiInputTextFlags_AllowTabInput.
+	IMGUI_API bool CollapsingHeader(const char* label, const float dt = 1.0f, ImGuiTreeNodeFlags flags = 0); // Content slides open and closed. Return true when the content has to be submitted, then call ImExt::TreePop(). Not indented.
+	IMGUI_API bool TreeNode(const char* label, const float dt = 1.0f, ImGuiTreeNodeFlags flags = 0); // Same, indented. Open nodes out of view are skipped using their content height from the last time it was submitted. Supported flags: DefaultOpen, Leaf, Selected, AllowItemOverlap, SpanAvailWidth, SpanFullWidth.
+	IMGUI_API void TreePop();
+	IMGUI_API bool TaskButton(const char* label, ImExtTaskFunc func, void* user_data = NULL, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f, ImGuiButtonFlags flags = 0); // Run 'func' on a worker thread when pressed, cancel when pressed again. Return true on the frame the job completed without being cancelled.
+	IMGUI_API void ProgressBar(const char* label, float fraction, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f); // Eases toward 'fraction'. Without a displayed label, shows the percentage.
+	IMGUI_API void ProgressBar(const char* label, const std::atomic<float>& fraction, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f); // 'fraction' written by any thread and read without locking. Polled at 10 Hz until it reaches 1.0f.
+	IMGUI_API void Spinner(const char* str_id, ImExtSpinnerType type = ImExtSpinnerType_Arc, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f); // Busy indicator. Steps through a fixed set of positions: only requests frames, and only re-tessellates, when it moves.
 
 	IMGUI_API bool BeginCombo(const char* label, const char* preview_value, const ImVec2& size = ImVec2(NULL, NULL), const float dt = 1.0f, ImGuiComboFlags flags = 0);
 	IMGUI_API bool BeginComboPopup(ImGuiID parent_id, ImGuiID popup_id, const ImRect& bb, const float dt = 1.0f, ImGuiComboFlags flags = 0);
 
+	// Opacity
+	IMGUI_API void PushGroupAlpha(float alpha); // Multiply the alpha of everything the current window draws until PopGroupAlpha(). Nests. Child windows are not affected.
+	IMGUI_API void PopGroupAlpha();
+	IMGUI_API void SetWindowAlpha(float alpha); // Multiply the alpha of the current window and its child windows, applied on ImGui::Render()
+
+	// Transforms
+	IMGUI_API void PushTransform(const ImVec2& pivot, const ImVec2& scale, float rotation = 0.0f, const ImVec2& offset = ImVec2(0.0f, 0.0f)); // Scale and rotate (radians) around 'pivot' then translate what the current window draws until PopTransform(). Nests. Layout and hit-testing are not affected.
+	IMGUI_API void PopTransform();
+
+	// Same widgets with compile-time labels
+	IMGUI_API bool Button(const ImExtLabel& label, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f, ImGuiButtonFlags flags = 0);
+	IMGUI_API bool ProgressButton(const ImExtLabel& label, bool* v, float* v_progress, const ImVec2& size = ImVec2(0, 0), const float v_speed = 0.01f, const float dt = 1.0f, ImGuiButtonFlags flags = 0);
+	IMGUI_API bool ToggleButton(const ImExtLabel& label, bool* v, const ImVec2& size = { 0.f, 0.f }, const float dt = 1.0f, ImGuiButtonFlags flags = 0);
+	IMGUI_API bool ProgressToggleButton(const ImExtLabel& label, bool* v, float* v_progress, const ImVec2& size = ImVec2(0, 0), const float v_speed = 0.01f, const float dt = 1.0f, ImGuiButtonFlags flags = 0);
+	IMGUI_API bool ToggleSwitch(const ImExtLabel& label, bool* v, const float dt = 1.0f);
+	IMGUI_API bool RadioButton(const ImExtLabel& label, bool active, const float dt = 1.0f);
+	IMGUI_API bool RadioButton(const ImExtLabel& label, int* v, int v_button, const float dt = 1.0f);
+	IMGUI_API bool Checkbox(const ImExtLabel& label, bool* v, const float dt = 1.0f);
+	IMGUI_API bool SliderFloat(const ImExtLabel& label, float* v, float v_min, float v_max, const char* format = "%.3f", const float dt = 1.0f, ImGuiSliderFlags flags = 0);
+	IMGUI_API bool SliderInt(const ImExtLabel& label, int* v, int v_min, int v_max, const char* format = "%d", const float dt = 1.0f, ImGuiSliderFlags flags = 0);
+	IMGUI_API bool DragFloat(const ImExtLabel& label, float* v, float v_speed = 1.0f, float v_min = 0.0f, float v_max = 0.0f, const char* format = "%.3f", const float dt = 1.0f, ImGuiSliderFlags flags = 0);
+	IMGUI_API void AnimatedNumber(const ImExtLabel& str_id, double value, const char* format = "%.2f", const float dt = 1.0f);
+	IMGUI_API void Sparkline(const ImExtLabel& str_id, const ImExtSparklineBuffer& buffer, const ImVec2& size = ImVec2(0, 0), float scale_min = FLT_MAX, float scale_max = FLT_MAX, int samples_count = 0, const float dt = 1.0f);
+	IMGUI_API void Plot(const ImExtLabel& label, const ImExtPlotSeries& series, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f);
+	IMGUI_API void LogView(const ImExtLabel& str_id, ImExtLogFile& file, const char* filter = NULL, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f);
+	IMGUI_API bool TextEditor(const ImExtLabel& str_id, ImExtTextBuffer& buffer, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f, ImGuiInputTextFlags flags = 0);
+	IMGUI_API bool CollapsingHeader(const ImExtLabel& label, const float dt = 1.0f, ImGuiTreeNodeFlags flags = 0);
+	IMGUI_API bool TreeNode(const ImExtLabel& label, const float dt = 1.0f, ImGuiTreeNodeFlags flags = 0);
+	IMGUI_API bool TaskButton(const ImExtLabel& label, ImExtTaskFunc func, void* user_data = NULL, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f, ImGuiButtonFlags flags = 0);
+	IMGUI_API void ProgressBar(const ImExtLabel& label, float fraction, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f);
+	IMGUI_API void ProgressBar(const ImExtLabel& label, const std::atomic<float>& fraction, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f);
+	IMGUI_API void Spinner(const ImExtLabel& str_id, ImExtSpinnerType type = ImExtSpinnerType_Arc, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f);
+	IMGUI_API bool BeginCombo(const ImExtLabel& label, const char* preview_value, const ImVec2& size = ImVec2(0, 0), const float dt = 1.0f, ImGuiComboFlags flags = 0);
+
+	// Font atlas
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+	IMGUI_API bool EnableDynamicGlyphs(ImFontAtlas* atlas, int width = 512, int height = 512); // Call before building. Glyphs missing from the loaded ranges get rasterized into a width x height region of the atlas on first use, see ImExtIO::FontAtlasDirtyRect.
+	IMGUI_API const ImFontBuilderIO* GetFontBuilderParallel(int threads_count = 0); // stb_truetype builder rasterizing glyphs on 'threads_count' threads (0: one per core), same atlas as the default builder. Assign to io.Fonts->FontBuilderIO before building.
+#endif
+	IMGUI_API bool LoadFontAtlasCache(ImFontAtlas* atlas, const char* filename); // Call after adding fonts, instead of building. Fails when the file wasn't saved from the same font files, configs and custom rects.
+	IMGUI_API bool SaveFontAtlasCache(ImFontAtlas* atlas, const char* filename); // Call after building (builds if needed).
+	IMGUI_API void RequestGlyphs(ImFont* font, const char* text, const char* text_end = NULL); // Queue the glyphs of 'text' missing from 'font', with EnableDynamicGlyphs(). ImExt widgets do it for their labels.
+
 	namespace ImDraw
 	{
 		IMGUI_API void RenderTextClipped(const ImVec2& pos_min, const ImVec2& pos_max, const char* text, const char* text_end, const ImVec2* text_size_if_known, const ImU32 color, const ImVec2& align = ImVec2(0, 0), const ImRect* clip_rect = NULL);
 		IMGUI_API void RenderTextClippedEx(ImDrawList* draw_list, const ImVec2& pos_min, const ImVec2& pos_max, const char* text, const char* text_end, const ImVec2* text_size_if_known, const ImU32 color, const ImVec2& align = ImVec2(0, 0), const ImRect* clip_rect = NULL);
+		IMGUI_API void RenderTextClippedTwoTone(const ImVec2& pos_min, const ImVec2& pos_max, const char* text, const char* text_end, const ImVec2* text_size_if_known, const float split_x, const ImU32 color_left, const ImU32 color_right, const ImVec2& align = ImVec2(0, 0), const ImRect* clip_rect = NULL); // Glyphs left of split_x in color_left, right of it in color_right, emitted once
+		IMGUI_API void RenderTextClippedTwoToneEx(ImDrawList* draw_list, const ImVec2& pos_min, const ImVec2& pos_max, const char* text, const char* text_end, const ImVec2* text_size_if_known, const float split_x, const ImU32 color_left, const ImU32 color_right, const ImVec2& align = ImVec2(0, 0), const ImRect* clip_rect = NULL);
 	}
 }
\ No newline at end of file